@@ -0,0 +1,352 @@
+// 算法的基准测试
+// 非修改算法、排序族、并行算法、视图与二进制序列化，分别与 std:: 中对应的实现比较
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "execution.hpp"
+#include "numeric.hpp"
+#include "serialize.hpp"
+#include "sort.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+#include "views.hpp"
+
+namespace {
+
+template <typename T>
+std::vector<T> random_values(size_t n) {
+    std::mt19937_64 gen(42);
+    std::vector<T> v(n);
+    for (auto& x : v) {
+        x = static_cast<T>(gen() % 1000000);
+    }
+    return v;
+}
+
+/*****************************************************************************************/
+// 非修改算法
+/*****************************************************************************************/
+
+void BM_find_std(benchmark::State& state) {
+    std::vector<int> v(static_cast<size_t>(state.range(0)), 0);
+    v.back() = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(v.begin(), v.end(), 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_find_mystl(benchmark::State& state) {
+    std::vector<int> v(static_cast<size_t>(state.range(0)), 0);
+    v.back() = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mystl::find(v.data(), v.data() + v.size(), 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_find_std)->Arg(1 << 16);
+BENCHMARK(BM_find_mystl)->Arg(1 << 16);
+
+void BM_count_std(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(v.begin(), v.end(), 7));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_count_mystl(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mystl::count(v.data(), v.data() + v.size(), 7));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_count_std)->Arg(1 << 16);
+BENCHMARK(BM_count_mystl)->Arg(1 << 16);
+
+void BM_equal_std(benchmark::State& state) {
+    const auto a = random_values<int>(static_cast<size_t>(state.range(0)));
+    const auto b = a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::equal(a.begin(), a.end(), b.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_equal_mystl(benchmark::State& state) {
+    const auto a = random_values<int>(static_cast<size_t>(state.range(0)));
+    const auto b = a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mystl::equal(a.data(), a.data() + a.size(), b.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_equal_std)->Arg(1 << 16);
+BENCHMARK(BM_equal_mystl)->Arg(1 << 16);
+
+void BM_min_element_std(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::min_element(v.begin(), v.end()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_min_element_mystl(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mystl::min_element(v.data(), v.data() + v.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_min_element_std)->Arg(1 << 16);
+BENCHMARK(BM_min_element_mystl)->Arg(1 << 16);
+
+void BM_accumulate_std(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_accumulate_mystl(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mystl::accumulate(v.data(), v.data() + v.size(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_accumulate_std)->Arg(1 << 16);
+BENCHMARK(BM_accumulate_mystl)->Arg(1 << 16);
+
+/*****************************************************************************************/
+// 排序
+/*****************************************************************************************/
+
+// 每轮先复制一份乱序数据，复制的时间不计入结果
+template <typename T, typename Sort>
+void sort_copy(benchmark::State& state, Sort sort) {
+    const auto input = random_values<T>(static_cast<size_t>(state.range(0)));
+    std::vector<T> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = input;
+        state.ResumeTiming();
+        sort(v.data(), v.data() + v.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_sort_int_std(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) { std::sort(f, l); });
+}
+void BM_sort_int_mystl(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) { mystl::sort(f, l); });
+}
+void BM_sort_double_std(benchmark::State& state) {
+    sort_copy<double>(state, [](double* f, double* l) { std::sort(f, l); });
+}
+void BM_sort_double_mystl(benchmark::State& state) {
+    sort_copy<double>(state,
+                      [](double* f, double* l) { mystl::sort(f, l); });
+}
+BENCHMARK(BM_sort_int_std)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_sort_int_mystl)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_sort_double_std)->Arg(1 << 20);
+BENCHMARK(BM_sort_double_mystl)->Arg(1 << 20);
+
+void BM_stable_sort_std(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) { std::stable_sort(f, l); });
+}
+void BM_stable_sort_mystl(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) { mystl::stable_sort(f, l); });
+}
+BENCHMARK(BM_stable_sort_std)->Arg(1 << 20);
+BENCHMARK(BM_stable_sort_mystl)->Arg(1 << 20);
+
+void BM_partial_sort_std(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) {
+        std::partial_sort(f, f + (l - f) / 100, l);
+    });
+}
+void BM_partial_sort_mystl(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) {
+        mystl::partial_sort(f, f + (l - f) / 100, l);
+    });
+}
+BENCHMARK(BM_partial_sort_std)->Arg(1 << 20);
+BENCHMARK(BM_partial_sort_mystl)->Arg(1 << 20);
+
+void BM_nth_element_std(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) {
+        std::nth_element(f, f + (l - f) / 2, l);
+    });
+}
+void BM_nth_element_mystl(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) {
+        mystl::nth_element(f, f + (l - f) / 2, l);
+    });
+}
+BENCHMARK(BM_nth_element_std)->Arg(1 << 20);
+BENCHMARK(BM_nth_element_mystl)->Arg(1 << 20);
+
+/*****************************************************************************************/
+// 并行算法
+// libstdc++ 的并行策略需要链接 TBB，这里与 std:: 的串行版本比较
+/*****************************************************************************************/
+
+void BM_par_sort_std(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) {
+        std::sort(f, l);
+    });
+}
+void BM_par_sort_mystl(benchmark::State& state) {
+    sort_copy<int>(state, [](int* f, int* l) {
+        mystl::sort(mystl::execution::par, f, l);
+    });
+}
+BENCHMARK(BM_par_sort_std)->Arg(1 << 22)->UseRealTime();
+BENCHMARK(BM_par_sort_mystl)->Arg(1 << 22)->UseRealTime();
+
+void BM_par_reduce_std(benchmark::State& state) {
+    const auto v = random_values<long>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::reduce(v.begin(), v.end(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_par_reduce_mystl(benchmark::State& state) {
+    const auto v = random_values<long>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mystl::reduce(
+            mystl::execution::par, v.data(), v.data() + v.size(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_par_reduce_std)->Arg(1 << 22)->UseRealTime();
+BENCHMARK(BM_par_reduce_mystl)->Arg(1 << 22)->UseRealTime();
+
+// 细粒度任务的调度开销：每个下标只做很少的工作
+void BM_parallel_for_mystl(benchmark::State& state) {
+    std::vector<int> v(static_cast<size_t>(state.range(0)), 1);
+    auto& pool = mystl::thread_pool::global();
+    for (auto _ : state) {
+        pool.parallel_for(0, v.size(), 256, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                v[i] *= 3;
+            }
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_parallel_for_mystl)->Arg(1 << 20)->UseRealTime();
+
+/*****************************************************************************************/
+// 视图：偶数的平方和，惰性串联与先生成临时容器比较
+/*****************************************************************************************/
+
+void BM_view_pipeline_std(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto r = v | std::views::filter([](int x) { return x % 2 == 0; }) |
+                 std::views::transform([](int x) { return long(x) * x; });
+        benchmark::DoNotOptimize(std::accumulate(r.begin(), r.end(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_view_pipeline_mystl(benchmark::State& state) {
+    const auto input = random_values<int>(static_cast<size_t>(state.range(0)));
+    const mystl::vector<int> v(input.data(), input.data() + input.size());
+    for (auto _ : state) {
+        auto r = v | mystl::views::filter([](int x) { return x % 2 == 0; }) |
+                 mystl::views::transform([](int x) { return long(x) * x; });
+        benchmark::DoNotOptimize(mystl::accumulate(r.begin(), r.end(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_view_materialize(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::vector<int> evens;
+        std::copy_if(v.begin(), v.end(), std::back_inserter(evens),
+                     [](int x) { return x % 2 == 0; });
+        std::vector<long> squares(evens.size());
+        std::transform(evens.begin(), evens.end(), squares.begin(),
+                       [](int x) { return long(x) * x; });
+        benchmark::DoNotOptimize(
+            std::accumulate(squares.begin(), squares.end(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_view_pipeline_std)->Arg(1 << 16);
+BENCHMARK(BM_view_pipeline_mystl)->Arg(1 << 16);
+BENCHMARK(BM_view_materialize)->Arg(1 << 16);
+
+// 分块后逐块并行求和，块内走连续区间的 SIMD 求和
+void BM_view_chunk_reduce_mystl(benchmark::State& state) {
+    const auto input = random_values<long>(static_cast<size_t>(state.range(0)));
+    const mystl::vector<long> v(input.data(), input.data() + input.size());
+    auto blocks = v | mystl::views::chunk(1 << 14);
+    std::vector<long> sums(blocks.size());
+    for (auto _ : state) {
+        mystl::transform(mystl::execution::par, blocks.begin(), blocks.end(),
+                         sums.data(), [](auto block) {
+                             return mystl::accumulate(block.begin(),
+                                                      block.end(), 0L);
+                         });
+        benchmark::DoNotOptimize(
+            std::accumulate(sums.begin(), sums.end(), 0L));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_view_chunk_reduce_mystl)->Arg(1 << 22)->UseRealTime();
+
+/*****************************************************************************************/
+// 序列化：与逐个元素写入 std::ostringstream 比较
+/*****************************************************************************************/
+
+void BM_serialize_std(benchmark::State& state) {
+    const auto v = random_values<int>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::ostringstream out;
+        const size_t n = v.size();
+        out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        for (int x : v) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(x));
+        }
+        benchmark::DoNotOptimize(out.tellp());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(sizeof(int)));
+}
+void BM_serialize_mystl(benchmark::State& state) {
+    const auto input = random_values<int>(static_cast<size_t>(state.range(0)));
+    const mystl::vector<int> v(input.data(), input.data() + input.size());
+    for (auto _ : state) {
+        mystl::vector<char> bytes;
+        {
+            mystl::binary_writer<mystl::memory_sink> w{
+                mystl::memory_sink(bytes)};
+            mystl::serialize(w, v);
+        }
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_serialize_std)->Arg(1 << 16);
+BENCHMARK(BM_serialize_mystl)->Arg(1 << 16);
+
+}  // namespace
@@ -0,0 +1,158 @@
+// allocator 与 construct / destory 的基准测试
+// allocator 按不同的分配策略与 std::allocator 比较，
+// thread_cache_allocator 在多个线程下测试吞吐量的扩展性
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+
+namespace {
+
+constexpr int kBatch = 256;
+
+// 一次分配 kBatch 个大小为 state.range(0) 字节的块再全部释放
+template <typename Alloc>
+void allocate_batch(benchmark::State& state) {
+    using T = typename Alloc::value_type;
+    const size_t n = static_cast<size_t>(state.range(0)) / sizeof(T);
+    Alloc alloc;
+    T* ptrs[kBatch];
+    for (auto _ : state) {
+        for (int i = 0; i < kBatch; ++i) {
+            ptrs[i] = alloc.allocate(n);
+        }
+        benchmark::ClobberMemory();
+        for (int i = 0; i < kBatch; ++i) {
+            alloc.deallocate(ptrs[i], n);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+void BM_allocator_std(benchmark::State& state) {
+    allocate_batch<std::allocator<char>>(state);
+}
+void BM_allocator_mystl(benchmark::State& state) {
+    allocate_batch<mystl::allocator<char>>(state);
+}
+void BM_allocator_mystl_pool(benchmark::State& state) {
+    allocate_batch<mystl::pool_allocator<char>>(state);
+}
+void BM_allocator_mystl_thread_cache(benchmark::State& state) {
+    allocate_batch<mystl::thread_cache_allocator<char>>(state);
+}
+BENCHMARK(BM_allocator_std)->Arg(16)->Arg(64)->Arg(128)->Arg(1024);
+BENCHMARK(BM_allocator_mystl)->Arg(16)->Arg(64)->Arg(128)->Arg(1024);
+BENCHMARK(BM_allocator_mystl_pool)->Arg(16)->Arg(64)->Arg(128)->Arg(1024);
+BENCHMARK(BM_allocator_mystl_thread_cache)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(128)
+    ->Arg(1024);
+
+// 多线程同时分配、释放，比较全局锁的内存池与线程缓存
+void BM_allocator_threads_std(benchmark::State& state) {
+    allocate_batch<std::allocator<char>>(state);
+}
+void BM_allocator_threads_mystl_pool(benchmark::State& state) {
+    allocate_batch<mystl::pool_allocator<char>>(state);
+}
+void BM_allocator_threads_mystl_thread_cache(benchmark::State& state) {
+    allocate_batch<mystl::thread_cache_allocator<char>>(state);
+}
+BENCHMARK(BM_allocator_threads_std)->Arg(64)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_allocator_threads_mystl_pool)
+    ->Arg(64)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK(BM_allocator_threads_mystl_thread_cache)
+    ->Arg(64)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// 在另一个线程释放：生产者分配、消费者释放的典型场景
+template <typename Alloc>
+void cross_thread_free(benchmark::State& state) {
+    Alloc alloc;
+    std::vector<char*> ptrs(4096);
+    for (auto _ : state) {
+        for (auto& p : ptrs) {
+            p = alloc.allocate(64);
+        }
+        std::thread t([&] {
+            for (auto p : ptrs) {
+                alloc.deallocate(p, 64);
+            }
+        });
+        t.join();
+    }
+    state.SetItemsProcessed(state.iterations() * ptrs.size());
+}
+void BM_allocator_cross_thread_std(benchmark::State& state) {
+    cross_thread_free<std::allocator<char>>(state);
+}
+void BM_allocator_cross_thread_mystl_thread_cache(benchmark::State& state) {
+    cross_thread_free<mystl::thread_cache_allocator<char>>(state);
+}
+BENCHMARK(BM_allocator_cross_thread_std)->UseRealTime();
+BENCHMARK(BM_allocator_cross_thread_mystl_thread_cache)->UseRealTime();
+
+/*****************************************************************************************/
+// construct / destory
+/*****************************************************************************************/
+
+constexpr size_t kObjects = 4096;
+
+template <typename T>
+void construct_destory_std(benchmark::State& state, const T& value) {
+    std::allocator<T> alloc;
+    T* p = alloc.allocate(kObjects);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kObjects; ++i) {
+            std::construct_at(p + i, value);
+        }
+        benchmark::ClobberMemory();
+        std::destroy(p, p + kObjects);
+    }
+    alloc.deallocate(p, kObjects);
+    state.SetItemsProcessed(state.iterations() * kObjects);
+}
+
+template <typename T>
+void construct_destory_mystl(benchmark::State& state, const T& value) {
+    T* p = mystl::allocator<T>::allocate(kObjects);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kObjects; ++i) {
+            mystl::construct(p + i, value);
+        }
+        benchmark::ClobberMemory();
+        mystl::destory(p, p + kObjects);
+    }
+    mystl::allocator<T>::deallocate(p, kObjects);
+    state.SetItemsProcessed(state.iterations() * kObjects);
+}
+
+void BM_construct_trivial_std(benchmark::State& state) {
+    construct_destory_std(state, 42);
+}
+void BM_construct_trivial_mystl(benchmark::State& state) {
+    construct_destory_mystl(state, 42);
+}
+void BM_construct_string_std(benchmark::State& state) {
+    construct_destory_std(state, std::string(40, 'x'));
+}
+void BM_construct_string_mystl(benchmark::State& state) {
+    construct_destory_mystl(state, std::string(40, 'x'));
+}
+BENCHMARK(BM_construct_trivial_std);
+BENCHMARK(BM_construct_trivial_mystl);
+BENCHMARK(BM_construct_string_std);
+BENCHMARK(BM_construct_string_mystl);
+
+}  // namespace
@@ -0,0 +1,495 @@
+// 容器的基准测试
+// 每个容器与 std:: 中对应的容器比较，用同一个模板函数测试两边，
+// 保证比较的是同样的操作序列
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "btree.hpp"
+#include "concurrent_hash_map.hpp"
+#include "deque.hpp"
+#include "flat_hash_map.hpp"
+#include "mpmc_queue.hpp"
+#include "soa_vector.hpp"
+#include "static_map.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+namespace {
+
+std::vector<int> random_keys(size_t n) {
+    std::mt19937 gen(42);
+    std::vector<int> keys(n);
+    for (auto& k : keys) {
+        k = static_cast<int>(gen());
+    }
+    return keys;
+}
+
+/*****************************************************************************************/
+// vector / small_vector / deque
+/*****************************************************************************************/
+
+template <typename Container>
+void push_back(benchmark::State& state) {
+    const auto n = state.range(0);
+    for (auto _ : state) {
+        Container c;
+        for (int64_t i = 0; i < n; ++i) {
+            c.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_vector_push_back_std(benchmark::State& state) {
+    push_back<std::vector<int>>(state);
+}
+void BM_vector_push_back_mystl(benchmark::State& state) {
+    push_back<mystl::vector<int>>(state);
+}
+void BM_small_vector_push_back_mystl(benchmark::State& state) {
+    push_back<mystl::small_vector<int, 16>>(state);
+}
+BENCHMARK(BM_vector_push_back_std)->Arg(8)->Arg(1 << 16);
+BENCHMARK(BM_vector_push_back_mystl)->Arg(8)->Arg(1 << 16);
+BENCHMARK(BM_small_vector_push_back_mystl)->Arg(8)->Arg(1 << 16);
+
+// 元素为 std::string 时，扩容应当按位搬移而不是逐个移动构造
+template <typename Container>
+void push_back_string(benchmark::State& state) {
+    const auto n = state.range(0);
+    const std::string s(32, 'x');
+    for (auto _ : state) {
+        Container c;
+        for (int64_t i = 0; i < n; ++i) {
+            c.push_back(s);
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_vector_push_back_string_std(benchmark::State& state) {
+    push_back_string<std::vector<std::string>>(state);
+}
+void BM_vector_push_back_string_mystl(benchmark::State& state) {
+    push_back_string<mystl::vector<std::string>>(state);
+}
+BENCHMARK(BM_vector_push_back_string_std)->Arg(1 << 14);
+BENCHMARK(BM_vector_push_back_string_mystl)->Arg(1 << 14);
+
+template <typename Container>
+void deque_push_pop(benchmark::State& state) {
+    const auto n = state.range(0);
+    for (auto _ : state) {
+        Container c;
+        for (int64_t i = 0; i < n; ++i) {
+            c.push_back(static_cast<int>(i));
+            c.push_front(static_cast<int>(i));
+        }
+        while (!c.empty()) {
+            c.pop_front();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * 2);
+}
+
+void BM_deque_push_pop_std(benchmark::State& state) {
+    deque_push_pop<std::deque<int>>(state);
+}
+void BM_deque_push_pop_mystl(benchmark::State& state) {
+    deque_push_pop<mystl::deque<int>>(state);
+}
+BENCHMARK(BM_deque_push_pop_std)->Arg(1 << 14);
+BENCHMARK(BM_deque_push_pop_mystl)->Arg(1 << 14);
+
+template <typename Container>
+void deque_iterate(benchmark::State& state) {
+    Container c(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : c) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_deque_iterate_std(benchmark::State& state) {
+    deque_iterate<std::deque<int>>(state);
+}
+void BM_deque_iterate_mystl(benchmark::State& state) {
+    deque_iterate<mystl::deque<int>>(state);
+}
+BENCHMARK(BM_deque_iterate_std)->Arg(1 << 16);
+BENCHMARK(BM_deque_iterate_mystl)->Arg(1 << 16);
+
+/*****************************************************************************************/
+// soa_vector：只读取六个字段中的两个，与按记录存放的 std::vector 比较
+/*****************************************************************************************/
+
+struct trade {
+    int64_t id;
+    double price;
+    double quantity;
+    int64_t account;
+    int64_t venue;
+    int64_t timestamp;
+};
+
+void BM_columns_aos_std(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    std::vector<trade> trades(n);
+    for (size_t i = 0; i < n; ++i) {
+        trades[i].price = static_cast<double>(i % 100);
+        trades[i].quantity = 2.0;
+    }
+    for (auto _ : state) {
+        double notional = 0;
+        for (const trade& t : trades) {
+            notional += t.price * t.quantity;
+        }
+        benchmark::DoNotOptimize(notional);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+void BM_columns_soa_mystl(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    mystl::soa_vector<int64_t, double, double, int64_t, int64_t, int64_t>
+        trades(n);
+    double* price = trades.data<1>();
+    double* quantity = trades.data<2>();
+    for (size_t i = 0; i < n; ++i) {
+        price[i] = static_cast<double>(i % 100);
+        quantity[i] = 2.0;
+    }
+    for (auto _ : state) {
+        double notional = 0;
+        for (size_t i = 0; i < n; ++i) {
+            notional += price[i] * quantity[i];
+        }
+        benchmark::DoNotOptimize(notional);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_columns_aos_std)->Arg(1 << 20);
+BENCHMARK(BM_columns_soa_mystl)->Arg(1 << 20);
+
+/*****************************************************************************************/
+// btree_map / flat_hash_map / static_map
+/*****************************************************************************************/
+
+template <typename Map>
+void map_insert(benchmark::State& state) {
+    const auto keys = random_keys(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        Map m;
+        for (int k : keys) {
+            m.emplace(k, k);
+        }
+        benchmark::DoNotOptimize(m);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void map_find(benchmark::State& state) {
+    const auto keys = random_keys(static_cast<size_t>(state.range(0)));
+    Map m;
+    for (int k : keys) {
+        m.emplace(k, k);
+    }
+    for (auto _ : state) {
+        long found = 0;
+        for (int k : keys) {
+            found += m.find(k)->second;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ordered_map_insert_std(benchmark::State& state) {
+    map_insert<std::map<int, int>>(state);
+}
+void BM_ordered_map_insert_mystl(benchmark::State& state) {
+    map_insert<mystl::btree_map<int, int>>(state);
+}
+void BM_ordered_map_find_std(benchmark::State& state) {
+    map_find<std::map<int, int>>(state);
+}
+void BM_ordered_map_find_mystl(benchmark::State& state) {
+    map_find<mystl::btree_map<int, int>>(state);
+}
+BENCHMARK(BM_ordered_map_insert_std)->Arg(1 << 16);
+BENCHMARK(BM_ordered_map_insert_mystl)->Arg(1 << 16);
+BENCHMARK(BM_ordered_map_find_std)->Arg(1 << 16);
+BENCHMARK(BM_ordered_map_find_mystl)->Arg(1 << 16);
+
+void BM_hash_map_insert_std(benchmark::State& state) {
+    map_insert<std::unordered_map<int, int>>(state);
+}
+void BM_hash_map_insert_mystl(benchmark::State& state) {
+    map_insert<mystl::flat_hash_map<int, int>>(state);
+}
+void BM_hash_map_find_std(benchmark::State& state) {
+    map_find<std::unordered_map<int, int>>(state);
+}
+void BM_hash_map_find_mystl(benchmark::State& state) {
+    map_find<mystl::flat_hash_map<int, int>>(state);
+}
+BENCHMARK(BM_hash_map_insert_std)->Arg(1 << 16);
+BENCHMARK(BM_hash_map_insert_mystl)->Arg(1 << 16);
+BENCHMARK(BM_hash_map_find_std)->Arg(1 << 16);
+BENCHMARK(BM_hash_map_find_mystl)->Arg(1 << 16);
+
+// 固定键集合的查找：协议解析中把已经切分好的方法名映射到枚举值
+constexpr const char* kMethods[] = {"GET",   "PUT",     "POST",
+                                    "DELETE", "HEAD",    "OPTIONS",
+                                    "PATCH", "CONNECT", "TRACE"};
+
+void BM_static_lookup_std(benchmark::State& state) {
+    const std::unordered_map<std::string_view, int> m = {
+        {"GET", 1},  {"PUT", 2},     {"POST", 3},    {"DELETE", 4},
+        {"HEAD", 5}, {"OPTIONS", 6}, {"PATCH", 7},   {"CONNECT", 8},
+        {"TRACE", 9}};
+    std::string_view keys[9];
+    for (int i = 0; i < 9; ++i) {
+        keys[i] = kMethods[i];
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto k : keys) {
+            benchmark::DoNotOptimize(k);
+            sum += m.find(k)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 9);
+}
+void BM_static_lookup_mystl(benchmark::State& state) {
+    static constexpr auto m = mystl::make_static_map<mystl::string_view, int>(
+        {{"GET", 1},
+         {"PUT", 2},
+         {"POST", 3},
+         {"DELETE", 4},
+         {"HEAD", 5},
+         {"OPTIONS", 6},
+         {"PATCH", 7},
+         {"CONNECT", 8},
+         {"TRACE", 9}});
+    mystl::string_view keys[9];
+    for (int i = 0; i < 9; ++i) {
+        keys[i] = kMethods[i];
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto k : keys) {
+            benchmark::DoNotOptimize(k);
+            sum += m.find(k)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 9);
+}
+BENCHMARK(BM_static_lookup_std);
+BENCHMARK(BM_static_lookup_mystl);
+
+/*****************************************************************************************/
+// string
+/*****************************************************************************************/
+
+// 短字符串全部放在对象内部，不分配内存
+template <typename String>
+void string_short(benchmark::State& state) {
+    for (auto _ : state) {
+        String s("key_");
+        s += "12345";
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+
+template <typename String>
+void string_append(benchmark::State& state) {
+    const auto n = state.range(0);
+    for (auto _ : state) {
+        String s;
+        for (int64_t i = 0; i < n; ++i) {
+            s += "abcdefgh";
+        }
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n * 8);
+}
+
+template <typename String>
+void string_find(benchmark::State& state) {
+    String s(static_cast<size_t>(state.range(0)), 'a');
+    s += "needle";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s.find("needle"));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_string_short_std(benchmark::State& state) {
+    string_short<std::string>(state);
+}
+void BM_string_short_mystl(benchmark::State& state) {
+    string_short<mystl::string>(state);
+}
+void BM_string_append_std(benchmark::State& state) {
+    string_append<std::string>(state);
+}
+void BM_string_append_mystl(benchmark::State& state) {
+    string_append<mystl::string>(state);
+}
+void BM_string_find_std(benchmark::State& state) {
+    string_find<std::string>(state);
+}
+void BM_string_find_mystl(benchmark::State& state) {
+    string_find<mystl::string>(state);
+}
+BENCHMARK(BM_string_short_std);
+BENCHMARK(BM_string_short_mystl);
+BENCHMARK(BM_string_append_std)->Arg(1 << 12);
+BENCHMARK(BM_string_append_mystl)->Arg(1 << 12);
+BENCHMARK(BM_string_find_std)->Arg(1 << 16);
+BENCHMARK(BM_string_find_mystl)->Arg(1 << 16);
+
+/*****************************************************************************************/
+// mpmc_queue：与 std::mutex 保护的 std::queue 比较
+/*****************************************************************************************/
+
+constexpr int kQueueItems = 1 << 16;
+
+struct locked_queue {
+    std::mutex mutex;
+    std::queue<int> queue;
+
+    bool try_push(int v) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(v);
+        return true;
+    }
+    bool try_pop(int& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        out = queue.front();
+        queue.pop();
+        return true;
+    }
+};
+
+// 一个生产者线程与一个消费者线程传递 kQueueItems 个元素
+template <typename Queue>
+void producer_consumer(benchmark::State& state, Queue& q) {
+    for (auto _ : state) {
+        std::thread producer([&] {
+            for (int i = 0; i < kQueueItems; ++i) {
+                while (!q.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        long sum = 0;
+        for (int i = 0; i < kQueueItems; ++i) {
+            int v;
+            while (!q.try_pop(v)) {
+                std::this_thread::yield();
+            }
+            sum += v;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * kQueueItems);
+}
+
+void BM_queue_std(benchmark::State& state) {
+    locked_queue q;
+    producer_consumer(state, q);
+}
+void BM_queue_mystl(benchmark::State& state) {
+    mystl::mpmc_queue<int> q(1024);
+    producer_consumer(state, q);
+}
+BENCHMARK(BM_queue_std)->UseRealTime();
+BENCHMARK(BM_queue_mystl)->UseRealTime();
+
+
+/*****************************************************************************************/
+// concurrent_hash_map：读多写少的共享缓存，与全局 std::mutex 保护的
+// std::unordered_map 比较；每 32 次操作中有一次写入
+/*****************************************************************************************/
+
+constexpr int kSharedKeys = 1 << 16;
+
+struct locked_map {
+    std::mutex mutex;
+    std::unordered_map<int, int> map;
+
+    bool find(int k) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.find(k) != map.end();
+    }
+    void assign(int k, int v) {
+        std::lock_guard<std::mutex> lock(mutex);
+        map[k] = v;
+    }
+};
+
+struct sharded_map {
+    mystl::concurrent_hash_map<int, int> map;
+
+    bool find(int k) const { return map.contains(k); }
+    void assign(int k, int v) { map.insert_or_assign(k, v); }
+};
+
+template <typename Map>
+void read_mostly(benchmark::State& state) {
+    static Map m;
+    if (state.thread_index() == 0) {
+        for (int k = 0; k < kSharedKeys; ++k) {
+            m.assign(k, k);
+        }
+    }
+    std::mt19937 gen(static_cast<unsigned>(state.thread_index()));
+    for (auto _ : state) {
+        const int k = static_cast<int>(gen() % kSharedKeys);
+        if ((k & 31) == 0) {
+            m.assign(k, k + 1);
+        } else {
+            benchmark::DoNotOptimize(m.find(k));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_shared_map_std(benchmark::State& state) {
+    read_mostly<locked_map>(state);
+}
+void BM_shared_map_mystl(benchmark::State& state) {
+    read_mostly<sharded_map>(state);
+}
+BENCHMARK(BM_shared_map_std)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_shared_map_mystl)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
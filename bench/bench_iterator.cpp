@@ -0,0 +1,234 @@
+// distance / advance 与 pair 的基准测试
+// 每种迭代器类别分别测试，检查标签分派是否选到了正确的版本：
+// 输入、前向迭代器逐个前进，随机访问迭代器一步到位
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "btree.hpp"
+#include "deque.hpp"
+#include "iterator.hpp"
+#include "util.hpp"
+
+namespace {
+
+constexpr int kElements = 1 << 12;
+
+// 只暴露指定类别的指针包装，Tag 决定 std 与 mystl 的分派结果
+template <typename Tag>
+struct tagged_iterator {
+    using iterator_category = Tag;
+    using value_type = int;
+    using difference_type = ptrdiff_t;
+    using pointer = int*;
+    using reference = int&;
+
+    int* p;
+
+    int& operator*() const { return *p; }
+    tagged_iterator& operator++() {
+        ++p;
+        return *this;
+    }
+    tagged_iterator operator++(int) { return {p++}; }
+    bool operator==(const tagged_iterator& rhs) const { return p == rhs.p; }
+    bool operator!=(const tagged_iterator& rhs) const { return p != rhs.p; }
+};
+
+template <typename It>
+void distance_std(benchmark::State& state, It first, It last) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first);
+        benchmark::DoNotOptimize(std::distance(first, last));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename It>
+void distance_mystl(benchmark::State& state, It first, It last) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first);
+        benchmark::DoNotOptimize(mystl::distance(first, last));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename It>
+void advance_std(benchmark::State& state, It first, ptrdiff_t n) {
+    for (auto _ : state) {
+        It it = first;
+        benchmark::DoNotOptimize(it);
+        std::advance(it, n);
+        benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename It>
+void advance_mystl(benchmark::State& state, It first, ptrdiff_t n) {
+    for (auto _ : state) {
+        It it = first;
+        benchmark::DoNotOptimize(it);
+        mystl::advance(it, n);
+        benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+std::vector<int>& data() {
+    static std::vector<int> v(kElements, 1);
+    return v;
+}
+
+// 输入迭代器
+using std_input = tagged_iterator<std::input_iterator_tag>;
+using mystl_input = tagged_iterator<mystl::input_iterator_tag>;
+
+void BM_distance_input_std(benchmark::State& state) {
+    auto& v = data();
+    distance_std(state, std_input{v.data()}, std_input{v.data() + v.size()});
+}
+void BM_distance_input_mystl(benchmark::State& state) {
+    auto& v = data();
+    distance_mystl(state, mystl_input{v.data()},
+                   mystl_input{v.data() + v.size()});
+}
+void BM_advance_input_std(benchmark::State& state) {
+    advance_std(state, std_input{data().data()}, kElements);
+}
+void BM_advance_input_mystl(benchmark::State& state) {
+    advance_mystl(state, mystl_input{data().data()}, kElements);
+}
+BENCHMARK(BM_distance_input_std);
+BENCHMARK(BM_distance_input_mystl);
+BENCHMARK(BM_advance_input_std);
+BENCHMARK(BM_advance_input_mystl);
+
+// 前向迭代器
+using std_forward = tagged_iterator<std::forward_iterator_tag>;
+using mystl_forward = tagged_iterator<mystl::forward_iterator_tag>;
+
+void BM_distance_forward_std(benchmark::State& state) {
+    auto& v = data();
+    distance_std(state, std_forward{v.data()},
+                 std_forward{v.data() + v.size()});
+}
+void BM_distance_forward_mystl(benchmark::State& state) {
+    auto& v = data();
+    distance_mystl(state, mystl_forward{v.data()},
+                   mystl_forward{v.data() + v.size()});
+}
+BENCHMARK(BM_distance_forward_std);
+BENCHMARK(BM_distance_forward_mystl);
+
+// 双向迭代器：std::map 与 btree_map 的迭代器
+std::map<int, int>& std_tree() {
+    static std::map<int, int> m = [] {
+        std::map<int, int> r;
+        for (int i = 0; i < kElements; ++i) {
+            r.emplace(i, i);
+        }
+        return r;
+    }();
+    return m;
+}
+
+mystl::btree_map<int, int>& mystl_tree() {
+    static mystl::btree_map<int, int> m = [] {
+        mystl::btree_map<int, int> r;
+        for (int i = 0; i < kElements; ++i) {
+            r.emplace(i, i);
+        }
+        return r;
+    }();
+    return m;
+}
+
+void BM_distance_bidirectional_std(benchmark::State& state) {
+    distance_std(state, std_tree().begin(), std_tree().end());
+}
+void BM_distance_bidirectional_mystl(benchmark::State& state) {
+    distance_mystl(state, mystl_tree().begin(), mystl_tree().end());
+}
+void BM_advance_bidirectional_std(benchmark::State& state) {
+    advance_std(state, std_tree().end(), -kElements);
+}
+void BM_advance_bidirectional_mystl(benchmark::State& state) {
+    advance_mystl(state, mystl_tree().end(), -kElements);
+}
+BENCHMARK(BM_distance_bidirectional_std);
+BENCHMARK(BM_distance_bidirectional_mystl);
+BENCHMARK(BM_advance_bidirectional_std);
+BENCHMARK(BM_advance_bidirectional_mystl);
+
+// 随机访问迭代器：原生指针与 deque 的迭代器
+void BM_distance_pointer_std(benchmark::State& state) {
+    auto& v = data();
+    distance_std(state, v.data(), v.data() + v.size());
+}
+void BM_distance_pointer_mystl(benchmark::State& state) {
+    auto& v = data();
+    distance_mystl(state, v.data(), v.data() + v.size());
+}
+BENCHMARK(BM_distance_pointer_std);
+BENCHMARK(BM_distance_pointer_mystl);
+
+void BM_advance_deque_std(benchmark::State& state) {
+    static std::deque<int> d(kElements, 1);
+    advance_std(state, d.begin(), kElements - 1);
+}
+void BM_advance_deque_mystl(benchmark::State& state) {
+    static mystl::deque<int> d(kElements, 1);
+    advance_mystl(state, d.begin(), kElements - 1);
+}
+BENCHMARK(BM_advance_deque_std);
+BENCHMARK(BM_advance_deque_mystl);
+
+/*****************************************************************************************/
+// pair
+/*****************************************************************************************/
+
+void BM_pair_construct_std(benchmark::State& state) {
+    const std::string s(40, 'x');
+    for (auto _ : state) {
+        std::pair<int, std::string> p(1, s);
+        benchmark::DoNotOptimize(p);
+    }
+}
+void BM_pair_construct_mystl(benchmark::State& state) {
+    const std::string s(40, 'x');
+    for (auto _ : state) {
+        mystl::pair<int, std::string> p(1, s);
+        benchmark::DoNotOptimize(p);
+    }
+}
+BENCHMARK(BM_pair_construct_std);
+BENCHMARK(BM_pair_construct_mystl);
+
+void BM_pair_swap_std(benchmark::State& state) {
+    std::pair<int, std::string> a(1, std::string(40, 'a'));
+    std::pair<int, std::string> b(2, std::string(40, 'b'));
+    for (auto _ : state) {
+        a.swap(b);
+        benchmark::DoNotOptimize(a);
+    }
+}
+void BM_pair_swap_mystl(benchmark::State& state) {
+    mystl::pair<int, std::string> a(1, std::string(40, 'a'));
+    mystl::pair<int, std::string> b(2, std::string(40, 'b'));
+    for (auto _ : state) {
+        a.swap(b);
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BM_pair_swap_std);
+BENCHMARK(BM_pair_swap_mystl);
+
+}  // namespace
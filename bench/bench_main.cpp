@@ -0,0 +1,34 @@
+// 基准测试的入口
+// 每个组件都和 std:: 中对应的实现放在一起比较，名字为 BM_<组件>_<std|mystl>
+// 默认在终端输出表格，同时把结果以 JSON 写到 bench_results.json，
+// 可以用 --benchmark_out=<文件> 改变输出位置，其他参数与 google benchmark 相同
+// 例如: xmake run bench --benchmark_filter=sort
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    bool has_out = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0) {
+            has_out = true;
+        }
+    }
+    char out[] = "--benchmark_out=bench_results.json";
+    char format[] = "--benchmark_out_format=json";
+    if (!has_out) {
+        args.push_back(out);
+        args.push_back(format);
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
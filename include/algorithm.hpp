@@ -0,0 +1,513 @@
+#pragma once
+
+// 这个头文件包含一些基本算法
+// find / count / equal / mismatch / min_element / max_element / fill
+// 按迭代器类型分派，连续迭代器上的算术类型交给 simd.hpp 中的 SIMD 内核
+// for_each / transform / copy / lower_bound
+// 连续迭代器上的 copy 退化为 memmove，可逐字节比较的 equal 退化为 memcmp，
+// 连续迭代器的反向迭代器上的 fill / equal / copy 改在对应的正向区间上完成
+// 排序算法 sort / stable_sort / partial_sort / nth_element 在 sort.hpp 中
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include "iterator.hpp"
+#include "simd.hpp"
+#include "sort.hpp"
+#include "uninitialized.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 判断迭代器能否交给 SIMD 内核：连续迭代器，元素是可以使用 SIMD 的算术类型
+template <typename Iter, bool = is_contiguous_iterator<Iter>::value>
+struct is_simd_iterator : public m_false_type {};
+
+template <typename Iter>
+struct is_simd_iterator<Iter, true>
+    : public m_bool_constant<
+          !std::is_volatile_v<std::remove_reference_t<
+              typename iterator_traits<Iter>::reference>> &&
+          simd_detail::is_simd_type_v<
+              typename iterator_traits<Iter>::value_type>> {};
+
+template <typename Iter>
+inline constexpr bool is_simd_iterator_v = is_simd_iterator<Iter>::value;
+
+namespace simd_detail {
+
+// 把要比较的值转换为元素类型 E，转换会改变比较结果时返回 false
+// 相同类型直接使用；整数之间只有值在 E 的范围内才转换
+template <typename E, typename T>
+bool to_element(const T& value, E& out) {
+    if constexpr (std::is_same_v<E, T>) {
+        out = value;
+        return true;
+    } else if constexpr (std::is_integral_v<E> && std::is_integral_v<T> &&
+                         !std::is_same_v<T, bool>) {
+        bool fits;
+        if constexpr (std::is_signed_v<T>) {
+            fits = value < 0
+                       ? std::is_signed_v<E> &&
+                             static_cast<intmax_t>(value) >=
+                                 static_cast<intmax_t>(
+                                     std::numeric_limits<E>::min())
+                       : static_cast<uintmax_t>(value) <=
+                             static_cast<uintmax_t>(
+                                 std::numeric_limits<E>::max());
+        } else {
+            fits = static_cast<uintmax_t>(value) <=
+                   static_cast<uintmax_t>(std::numeric_limits<E>::max());
+        }
+        out = static_cast<E>(value);
+        return fits;
+    } else {
+        return false;
+    }
+}
+
+}  // namespace simd_detail
+
+// 判断两个区间能否用 memcmp 判断相等：连续迭代器，元素类型相同且可逐字节比较
+template <typename Iter1, typename Iter2,
+          bool = is_contiguous_iterator<Iter1>::value &&
+                 is_contiguous_iterator<Iter2>::value>
+struct is_memcmp_comparable : public m_false_type {};
+
+template <typename Iter1, typename Iter2>
+struct is_memcmp_comparable<Iter1, Iter2, true>
+    : public m_bool_constant<
+          std::is_same_v<typename iterator_traits<Iter1>::value_type,
+                         typename iterator_traits<Iter2>::value_type> &&
+          is_bitwise_comparable_v<
+              typename iterator_traits<Iter1>::value_type>> {};
+
+template <typename Iter1, typename Iter2>
+inline constexpr bool is_memcmp_comparable_v =
+    is_memcmp_comparable<Iter1, Iter2>::value;
+
+// 判断连续迭代器之间的复制赋值能否用 memmove 完成：除了能按字节复制，
+// 复制赋值还必须是平凡的，否则会绕过被删除或者自定义的赋值运算符
+template <typename InputIter, typename OutputIter>
+struct is_memmove_assignable
+    : public m_bool_constant<
+          is_memmove_copyable_v<InputIter, OutputIter> &&
+          std::is_trivially_copy_assignable_v<
+              typename iterator_traits<OutputIter>::value_type>> {};
+
+template <typename InputIter, typename OutputIter>
+inline constexpr bool is_memmove_assignable_v =
+    is_memmove_assignable<InputIter, OutputIter>::value;
+
+// 判断两个连续迭代器的反向迭代器之间的复制能否在正向区间上用 memmove 完成
+template <typename InputIter, typename OutputIter>
+struct is_reverse_memmove_copyable : public m_false_type {};
+
+template <typename InputIter, typename OutputIter>
+struct is_reverse_memmove_copyable<reverse_iterator<InputIter>,
+                                   reverse_iterator<OutputIter>>
+    : public is_memmove_assignable<InputIter, OutputIter> {};
+
+template <typename InputIter, typename OutputIter>
+inline constexpr bool is_reverse_memmove_copyable_v =
+    is_reverse_memmove_copyable<InputIter, OutputIter>::value;
+
+/*****************************************************************************************/
+// find
+// 在 [first, last) 区间内找到第一个等于 value 的元素，返回指向该元素的迭代器
+/*****************************************************************************************/
+
+template <typename InputIter, typename T>
+InputIter find_dispatch(InputIter first, InputIter last, const T& value,
+                        input_iterator_tag) {
+    for (; first != last; ++first) {
+        if (*first == value) {
+            break;
+        }
+    }
+    return first;
+}
+
+template <typename RandomIter, typename T>
+RandomIter find_dispatch(RandomIter first, RandomIter last, const T& value,
+                         random_access_iterator_tag) {
+    if constexpr (is_simd_iterator_v<RandomIter>) {
+        using E = typename iterator_traits<RandomIter>::value_type;
+        E v;
+        if (simd_detail::to_element(value, v)) {
+            const E* p = mystl::to_address(first);
+            return first + (simd_detail::find<E>(p, p + (last - first), v) - p);
+        }
+    }
+    return find_dispatch(first, last, value, input_iterator_tag());
+}
+
+template <typename InputIter, typename T>
+InputIter find(InputIter first, InputIter last, const T& value) {
+    return find_dispatch(first, last, value, iterator_category(first));
+}
+
+/*****************************************************************************************/
+// count
+// 对 [first, last) 区间内的元素与给定值进行比较，返回相等元素的个数
+/*****************************************************************************************/
+
+template <typename InputIter, typename T>
+typename iterator_traits<InputIter>::difference_type count_dispatch(
+    InputIter first, InputIter last, const T& value, input_iterator_tag) {
+    typename iterator_traits<InputIter>::difference_type n = 0;
+    for (; first != last; ++first) {
+        if (*first == value) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+template <typename RandomIter, typename T>
+typename iterator_traits<RandomIter>::difference_type count_dispatch(
+    RandomIter first, RandomIter last, const T& value,
+    random_access_iterator_tag) {
+    if constexpr (is_simd_iterator_v<RandomIter>) {
+        using E = typename iterator_traits<RandomIter>::value_type;
+        E v;
+        if (simd_detail::to_element(value, v)) {
+            const E* p = mystl::to_address(first);
+            return static_cast<ptrdiff_t>(
+                simd_detail::count<E>(p, p + (last - first), v));
+        }
+    }
+    return count_dispatch(first, last, value, input_iterator_tag());
+}
+
+template <typename InputIter, typename T>
+typename iterator_traits<InputIter>::difference_type count(InputIter first,
+                                                           InputIter last,
+                                                           const T& value) {
+    return count_dispatch(first, last, value, iterator_category(first));
+}
+
+/*****************************************************************************************/
+// mismatch
+// 平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
+/*****************************************************************************************/
+
+template <typename InputIter1, typename InputIter2>
+pair<InputIter1, InputIter2> mismatch_dispatch(InputIter1 first1,
+                                               InputIter1 last1,
+                                               InputIter2 first2,
+                                               input_iterator_tag) {
+    while (first1 != last1 && *first1 == *first2) {
+        ++first1;
+        ++first2;
+    }
+    return pair<InputIter1, InputIter2>(first1, first2);
+}
+
+template <typename RandomIter1, typename RandomIter2>
+pair<RandomIter1, RandomIter2> mismatch_dispatch(RandomIter1 first1,
+                                                 RandomIter1 last1,
+                                                 RandomIter2 first2,
+                                                 random_access_iterator_tag) {
+    if constexpr (is_simd_iterator_v<RandomIter1> &&
+                  is_contiguous_iterator_v<RandomIter2>) {
+        using E1 = typename iterator_traits<RandomIter1>::value_type;
+        using E2 = typename iterator_traits<RandomIter2>::value_type;
+        if constexpr (std::is_same_v<E1, E2>) {
+            const auto i = simd_detail::mismatch<E1>(
+                mystl::to_address(first1), mystl::to_address(first2),
+                static_cast<size_t>(last1 - first1));
+            return pair<RandomIter1, RandomIter2>(first1 + i, first2 + i);
+        }
+    }
+    return mismatch_dispatch(first1, last1, first2, input_iterator_tag());
+}
+
+template <typename InputIter1, typename InputIter2>
+pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1,
+                                      InputIter2 first2) {
+    return mismatch_dispatch(first1, last1, first2, iterator_category(first1));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename InputIter1, typename InputIter2, typename Compared>
+pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1,
+                                      InputIter2 first2, Compared comp) {
+    while (first1 != last1 && comp(*first1, *first2)) {
+        ++first1;
+        ++first2;
+    }
+    return pair<InputIter1, InputIter2>(first1, first2);
+}
+
+/*****************************************************************************************/
+// equal
+// 比较第一序列在 [first, last) 区间上的元素值是否和第二序列相等
+/*****************************************************************************************/
+
+template <typename InputIter1, typename InputIter2>
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    if constexpr (is_reverse_contiguous_iterator_v<InputIter1> &&
+                  is_reverse_contiguous_iterator_v<InputIter2>) {
+        // 是否相等与比较的顺序无关，改为比较对应的正向区间
+        const auto n = last1 - first1;
+        return mystl::equal(last1.base(), first1.base(), (first2 + n).base());
+    } else if constexpr (is_memcmp_comparable_v<InputIter1, InputIter2>) {
+        using E = typename iterator_traits<InputIter1>::value_type;
+        const auto n = static_cast<size_t>(last1 - first1);
+        return n == 0 || std::memcmp(mystl::to_address(first1),
+                                     mystl::to_address(first2),
+                                     n * sizeof(E)) == 0;
+    } else {
+        return mystl::mismatch(first1, last1, first2).first == last1;
+    }
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename InputIter1, typename InputIter2, typename Compared>
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+           Compared comp) {
+    return mystl::mismatch(first1, last1, first2, comp).first == last1;
+}
+
+/*****************************************************************************************/
+// min_element / max_element
+// 返回一个迭代器，指向序列中第一个最小 / 最大的元素
+/*****************************************************************************************/
+
+template <typename ForwardIter>
+ForwardIter min_element_dispatch(ForwardIter first, ForwardIter last,
+                                 forward_iterator_tag) {
+    if (first == last) {
+        return first;
+    }
+    ForwardIter result = first;
+    while (++first != last) {
+        if (*first < *result) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <typename RandomIter>
+RandomIter min_element_dispatch(RandomIter first, RandomIter last,
+                                random_access_iterator_tag) {
+    if constexpr (is_simd_iterator_v<RandomIter>) {
+        using E = typename iterator_traits<RandomIter>::value_type;
+        const E* p = mystl::to_address(first);
+        return first +
+               (simd_detail::min_element<E>(p, p + (last - first)) - p);
+    } else {
+        return min_element_dispatch(first, last, forward_iterator_tag());
+    }
+}
+
+template <typename ForwardIter>
+ForwardIter min_element(ForwardIter first, ForwardIter last) {
+    return min_element_dispatch(first, last, iterator_category(first));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename ForwardIter, typename Compared>
+ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp) {
+    if (first == last) {
+        return first;
+    }
+    ForwardIter result = first;
+    while (++first != last) {
+        if (comp(*first, *result)) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <typename ForwardIter>
+ForwardIter max_element_dispatch(ForwardIter first, ForwardIter last,
+                                 forward_iterator_tag) {
+    if (first == last) {
+        return first;
+    }
+    ForwardIter result = first;
+    while (++first != last) {
+        if (*result < *first) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <typename RandomIter>
+RandomIter max_element_dispatch(RandomIter first, RandomIter last,
+                                random_access_iterator_tag) {
+    if constexpr (is_simd_iterator_v<RandomIter>) {
+        using E = typename iterator_traits<RandomIter>::value_type;
+        const E* p = mystl::to_address(first);
+        return first +
+               (simd_detail::max_element<E>(p, p + (last - first)) - p);
+    } else {
+        return max_element_dispatch(first, last, forward_iterator_tag());
+    }
+}
+
+template <typename ForwardIter>
+ForwardIter max_element(ForwardIter first, ForwardIter last) {
+    return max_element_dispatch(first, last, iterator_category(first));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <typename ForwardIter, typename Compared>
+ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp) {
+    if (first == last) {
+        return first;
+    }
+    ForwardIter result = first;
+    while (++first != last) {
+        if (comp(*result, *first)) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+/*****************************************************************************************/
+// fill
+// 为 [first, last) 区间内的所有元素填充新值
+/*****************************************************************************************/
+
+template <typename ForwardIter, typename T>
+void fill_dispatch(ForwardIter first, ForwardIter last, const T& value,
+                   forward_iterator_tag) {
+    for (; first != last; ++first) {
+        *first = value;
+    }
+}
+
+template <typename RandomIter, typename T>
+void fill_dispatch(RandomIter first, RandomIter last, const T& value,
+                   random_access_iterator_tag) {
+    using R = typename iterator_traits<RandomIter>::reference;
+    if constexpr (is_simd_iterator_v<RandomIter> &&
+                  !std::is_const_v<std::remove_reference_t<R>>) {
+        using E = typename iterator_traits<RandomIter>::value_type;
+        const E v = value;  // 与逐个赋值相同的隐式转换
+        E* p = mystl::to_address(first);
+        simd_detail::fill<E>(p, p + (last - first), v);
+    } else {
+        fill_dispatch(first, last, value, forward_iterator_tag());
+    }
+}
+
+template <typename ForwardIter, typename T>
+void fill(ForwardIter first, ForwardIter last, const T& value) {
+    if constexpr (is_reverse_contiguous_iterator_v<ForwardIter>) {
+        // 填充与顺序无关，改为填充对应的正向区间
+        mystl::fill(last.base(), first.base(), value);
+    } else {
+        fill_dispatch(first, last, value, iterator_category(first));
+    }
+}
+
+/*****************************************************************************************/
+// for_each
+// 对 [first, last) 区间内的每个元素调用函数对象 f，返回 f
+/*****************************************************************************************/
+
+template <typename InputIter, typename Function>
+Function for_each(InputIter first, InputIter last, Function f) {
+    for (; first != last; ++first) {
+        f(*first);
+    }
+    return f;
+}
+
+/*****************************************************************************************/
+// transform
+// 版本1：以函数对象 unary_op 作用于 [first, last) 中的每个元素并将结果保存到 result 中
+// 版本2：以函数对象 binary_op 作用于两个序列的元素并将结果保存到 result 中
+/*****************************************************************************************/
+
+template <typename InputIter, typename OutputIter, typename UnaryOperation>
+OutputIter transform(InputIter first, InputIter last, OutputIter result,
+                     UnaryOperation unary_op) {
+    for (; first != last; ++first, ++result) {
+        *result = unary_op(*first);
+    }
+    return result;
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter,
+          typename BinaryOperation>
+OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                     OutputIter result, BinaryOperation binary_op) {
+    for (; first1 != last1; ++first1, ++first2, ++result) {
+        *result = binary_op(*first1, *first2);
+    }
+    return result;
+}
+
+/*****************************************************************************************/
+// copy
+// 把 [first, last) 区间内的元素拷贝到 [result, result + (last - first)) 内
+/*****************************************************************************************/
+
+template <typename InputIter, typename OutputIter>
+OutputIter copy(InputIter first, InputIter last, OutputIter result) {
+    if constexpr (is_memmove_assignable_v<InputIter, OutputIter>) {
+        const auto n = static_cast<size_t>(last - first);
+        if (n != 0) {
+            std::memmove(mystl::to_address(result), mystl::to_address(first),
+                         n * sizeof(*first));
+        }
+        return result + n;
+    } else if constexpr (is_reverse_memmove_copyable_v<InputIter,
+                                                       OutputIter>) {
+        // 从反向区间复制到反向区间，元素在内存中的相对顺序不变：
+        // 源的正向区间 [last.base(), first.base()) 整体搬到 result.base() 之前
+        const auto n = last - first;
+        if (n != 0) {
+            std::memmove(mystl::to_address(result.base()) - n,
+                         mystl::to_address(last.base()), n * sizeof(*first));
+        }
+        return result + n;
+    } else {
+        for (; first != last; ++first, ++result) {
+            *result = *first;
+        }
+        return result;
+    }
+}
+
+/*****************************************************************************************/
+// lower_bound
+// 在 [first, last) 中查找第一个不小于 value 的元素，返回指向它的迭代器
+/*****************************************************************************************/
+
+template <typename ForwardIter, typename T, typename Compared>
+ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value,
+                        Compared comp) {
+    auto len = mystl::distance(first, last);
+    while (len > 0) {
+        const auto half = len / 2;
+        ForwardIter middle = first;
+        mystl::advance(middle, half);
+        if (comp(*middle, value)) {
+            first = ++middle;
+            len = len - half - 1;
+        } else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+template <typename ForwardIter, typename T>
+ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value) {
+    return mystl::lower_bound(first, last, value, std::less<>());
+}
+
+}  // namespace mystl
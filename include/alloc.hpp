@@ -0,0 +1,418 @@
+#pragma once
+
+// 这个头文件包含 allocator 使用的底层内存分配策略
+// new_alloc  : 直接调用 ::operator new / ::operator delete
+// pool_alloc : 仿照 SGI __default_alloc_template 的内存池，
+//              小块内存按大小分级由自由链表管理，大块内存交给 new_alloc
+// thread_cache_alloc : 每个线程持有按大小分级的缓存，与中央池批量交换区块
+// arena      : 单调递增的内存资源，从大块内存中顺序切分，release 时一次性归还
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace mystl {
+
+// 第一级分配策略：直接使用全局 operator new / delete
+class new_alloc {
+public:
+    static void* allocate(size_t bytes) { return ::operator new(bytes); }
+
+    static void deallocate(void* ptr, size_t /*bytes*/) {
+        ::operator delete(ptr);
+    }
+};
+
+// 空的锁，用于单线程版本的内存池
+struct null_mutex {
+    void lock() {}
+    void unlock() {}
+};
+
+// 第二级分配策略：内存池
+// 小于等于 kMaxBytes 的请求上调至 kAlign 的倍数，从对应的自由链表取块
+// 释放时依据传入的 bytes 将块归还到对应的自由链表，块本身不带任何头部
+// Threads 为 true 时使用互斥锁保护自由链表和内存池
+template <bool Threads>
+class default_alloc_template {
+public:
+    static constexpr size_t kAlign = 16;
+    static constexpr size_t kMaxBytes = 256;
+    static constexpr size_t kFreeLists = kMaxBytes / kAlign;
+    static constexpr size_t kRefillObjs = 20;
+
+private:
+    // 自由链表的节点，未分配时块的前几个字节用来存放下一个块的地址
+    union obj {
+        union obj* next;
+        char data[1];
+    };
+
+    using mutex_type = std::conditional_t<Threads, std::mutex, null_mutex>;
+
+    inline static obj* free_list_[kFreeLists] = {};
+    inline static char* start_free_ = nullptr;  // 内存池起始位置
+    inline static char* end_free_ = nullptr;    // 内存池结束位置
+    inline static size_t heap_size_ = 0;        // 已向系统申请的总字节数
+    inline static mutex_type mutex_;
+
+public:
+    static void* allocate(size_t bytes) {
+        if (bytes > kMaxBytes) {
+            return new_alloc::allocate(bytes);
+        }
+
+        std::lock_guard<mutex_type> lock(mutex_);
+        obj** my_free_list = free_list_ + freelist_index(bytes);
+        obj* result = *my_free_list;
+        if (result == nullptr) {
+            return refill(round_up(bytes));
+        }
+        *my_free_list = result->next;
+        return result;
+    }
+
+    static void deallocate(void* ptr, size_t bytes) {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (bytes > kMaxBytes) {
+            new_alloc::deallocate(ptr, bytes);
+            return;
+        }
+
+        std::lock_guard<mutex_type> lock(mutex_);
+        obj** my_free_list = free_list_ + freelist_index(bytes);
+        obj* q = static_cast<obj*>(ptr);
+        q->next = *my_free_list;
+        *my_free_list = q;
+    }
+
+    // 将 bytes 上调至 kAlign 的倍数
+    static constexpr size_t round_up(size_t bytes) {
+        return (bytes + kAlign - 1) & ~(kAlign - 1);
+    }
+
+    // 根据区块大小选择第 n 个自由链表，n 从 0 开始
+    static constexpr size_t freelist_index(size_t bytes) {
+        return (bytes + kAlign - 1) / kAlign - 1;
+    }
+
+private:
+    // 为大小为 n 的自由链表补充区块，返回其中一个区块，其余挂到链表上
+    // 调用者需持有锁，n 已上调至 kAlign 的倍数
+    static void* refill(size_t n) {
+        size_t nobjs = kRefillObjs;
+        char* chunk = chunk_alloc(n, nobjs);
+        if (nobjs == 1) {
+            return chunk;
+        }
+
+        obj** my_free_list = free_list_ + freelist_index(n);
+        obj* result = reinterpret_cast<obj*>(chunk);
+        obj* next_obj = reinterpret_cast<obj*>(chunk + n);
+        *my_free_list = next_obj;
+        for (size_t i = 1;; ++i) {
+            obj* current_obj = next_obj;
+            next_obj = reinterpret_cast<obj*>(
+                reinterpret_cast<char*>(next_obj) + n);
+            if (i + 1 == nobjs) {
+                current_obj->next = nullptr;
+                break;
+            }
+            current_obj->next = next_obj;
+        }
+        return result;
+    }
+
+    // 从内存池中取出 nobjs 个大小为 size 的区块，不足时 nobjs 会被减小
+    static char* chunk_alloc(size_t size, size_t& nobjs) {
+        size_t total_bytes = size * nobjs;
+        size_t bytes_left = end_free_ - start_free_;
+
+        if (bytes_left >= total_bytes) {
+            // 内存池剩余空间完全满足需求
+            char* result = start_free_;
+            start_free_ += total_bytes;
+            return result;
+        }
+        if (bytes_left >= size) {
+            // 内存池剩余空间不能完全满足需求，但足够供应一个以上的区块
+            nobjs = bytes_left / size;
+            char* result = start_free_;
+            start_free_ += size * nobjs;
+            return result;
+        }
+
+        // 内存池剩余空间连一个区块都无法提供
+        // 先把残余的零头挂到合适的自由链表上，再向系统申请新的内存池
+        if (bytes_left > 0) {
+            obj** my_free_list = free_list_ + freelist_index(bytes_left);
+            obj* q = reinterpret_cast<obj*>(start_free_);
+            q->next = *my_free_list;
+            *my_free_list = q;
+        }
+
+        size_t bytes_to_get = 2 * total_bytes + round_up(heap_size_ >> 4);
+        start_free_ = static_cast<char*>(::operator new(bytes_to_get));
+        heap_size_ += bytes_to_get;
+        end_free_ = start_free_ + bytes_to_get;
+        return chunk_alloc(size, nobjs);
+    }
+};
+
+// 默认的内存池为线程安全版本
+using pool_alloc = default_alloc_template<true>;
+using single_thread_pool_alloc = default_alloc_template<false>;
+
+// 线程缓存分配策略：thread_cache_alloc
+// 每个线程为每个大小级别维护一条无锁的自由链表，链表为空时一次从中央池取回
+// kBatch 个区块，缓存的区块超过 kMaxCached 时把 kBatch 个区块还给中央池。
+// 中央池每个级别一把锁且各占一条缓存行，只有批量交换时才会加锁。
+// 区块不属于特定线程，任何线程释放的区块都进入该线程自己的缓存，
+// 线程退出时其缓存全部还给中央池
+class thread_cache_alloc {
+public:
+    static constexpr size_t kAlign = 16;
+    static constexpr size_t kMaxBytes = 256;
+    static constexpr size_t kClasses = kMaxBytes / kAlign;
+    static constexpr size_t kBatch = 32;
+    static constexpr size_t kMaxCached = 4 * kBatch;
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+private:
+    struct obj {
+        obj* next;
+    };
+
+    // 中央池的一个大小级别，作为静态对象其 head 会被零初始化
+    struct alignas(64) central_list {
+        std::mutex mutex;
+        obj* head;
+    };
+
+    // 线程缓存
+    struct thread_cache {
+        obj* head[kClasses] = {};
+        size_t count[kClasses] = {};
+
+        ~thread_cache() {
+            for (size_t i = 0; i < kClasses; ++i) {
+                if (head[i] != nullptr) {
+                    release_to_central(i, head[i], count[i]);
+                }
+            }
+        }
+    };
+
+    inline static central_list central_[kClasses];
+    inline static std::mutex chunk_mutex_;
+    inline static char* start_free_ = nullptr;
+    inline static char* end_free_ = nullptr;
+
+public:
+    static void* allocate(size_t bytes) {
+        if (bytes > kMaxBytes) {
+            return new_alloc::allocate(bytes);
+        }
+
+        size_t idx = class_index(bytes);
+        thread_cache& tc = cache();
+        if (tc.head[idx] == nullptr) {
+            fetch_from_central(tc, idx);
+        }
+        obj* result = tc.head[idx];
+        tc.head[idx] = result->next;
+        --tc.count[idx];
+        return result;
+    }
+
+    static void deallocate(void* ptr, size_t bytes) {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (bytes > kMaxBytes) {
+            new_alloc::deallocate(ptr, bytes);
+            return;
+        }
+
+        size_t idx = class_index(bytes);
+        thread_cache& tc = cache();
+        obj* q = static_cast<obj*>(ptr);
+        q->next = tc.head[idx];
+        tc.head[idx] = q;
+        if (++tc.count[idx] > kMaxCached) {
+            // 把链表头部的 kBatch 个区块还给中央池
+            obj* first = tc.head[idx];
+            obj* last = first;
+            for (size_t i = 1; i < kBatch; ++i) {
+                last = last->next;
+            }
+            tc.head[idx] = last->next;
+            tc.count[idx] -= kBatch;
+            last->next = nullptr;
+            release_to_central(idx, first, kBatch);
+        }
+    }
+
+    static constexpr size_t class_index(size_t bytes) {
+        return bytes == 0 ? 0 : (bytes - 1) / kAlign;
+    }
+
+    static constexpr size_t class_size(size_t idx) {
+        return (idx + 1) * kAlign;
+    }
+
+private:
+    static thread_cache& cache() {
+        thread_local thread_cache tc;
+        return tc;
+    }
+
+    // 从中央池取回至多 kBatch 个区块，中央池为空时从大块内存切分
+    static void fetch_from_central(thread_cache& tc, size_t idx) {
+        size_t n = 0;
+        obj* head = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(central_[idx].mutex);
+            head = central_[idx].head;
+            obj* last = head;
+            if (last != nullptr) {
+                for (n = 1; n < kBatch && last->next != nullptr; ++n) {
+                    last = last->next;
+                }
+                central_[idx].head = last->next;
+                last->next = nullptr;
+            }
+        }
+        if (head == nullptr) {
+            head = carve(class_size(idx), n);
+        }
+        tc.head[idx] = head;
+        tc.count[idx] = n;
+    }
+
+    // 把以 first 开头、长度为 n 的链表归还到中央池
+    static void release_to_central(size_t idx, obj* first, size_t n) {
+        obj* last = first;
+        for (size_t i = 1; i < n; ++i) {
+            last = last->next;
+        }
+        std::lock_guard<std::mutex> lock(central_[idx].mutex);
+        last->next = central_[idx].head;
+        central_[idx].head = first;
+    }
+
+    // 从大块内存中切出至多 kBatch 个大小为 size 的区块并串成链表
+    static obj* carve(size_t size, size_t& n) {
+        char* p = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(chunk_mutex_);
+            if (static_cast<size_t>(end_free_ - start_free_) < size) {
+                // 大块的零头不足一个区块，直接丢弃
+                start_free_ = static_cast<char*>(::operator new(kChunkSize));
+                end_free_ = start_free_ + kChunkSize;
+            }
+            n = static_cast<size_t>(end_free_ - start_free_) / size;
+            if (n > kBatch) {
+                n = kBatch;
+            }
+            p = start_free_;
+            start_free_ += n * size;
+        }
+
+        for (size_t i = 0; i + 1 < n; ++i) {
+            reinterpret_cast<obj*>(p + i * size)->next =
+                reinterpret_cast<obj*>(p + (i + 1) * size);
+        }
+        reinterpret_cast<obj*>(p + (n - 1) * size)->next = nullptr;
+        return reinterpret_cast<obj*>(p);
+    }
+};
+
+// 单调内存资源：arena
+// 从向系统申请的大块内存中顺序切分，deallocate 不做任何事，
+// 所有内存在 release 或析构时一次性归还。arena 不是线程安全的
+class arena {
+private:
+    // 每个大块内存头部记录下一个大块，构成单向链表
+    struct chunk {
+        chunk* next;
+        size_t size;
+    };
+
+    static constexpr size_t kHeaderSize =
+        (sizeof(chunk) + alignof(std::max_align_t) - 1) &
+        ~(alignof(std::max_align_t) - 1);
+
+    chunk* chunks_ = nullptr;
+    char* cur_ = nullptr;  // 当前大块中未使用部分的起始位置
+    char* end_ = nullptr;  // 当前大块的结束位置
+    size_t next_chunk_size_;
+
+public:
+    static constexpr size_t kInitialChunkSize = 4096;
+    static constexpr size_t kMaxChunkSize = 1 << 20;
+
+    explicit arena(size_t initial_chunk_size = kInitialChunkSize)
+        : next_chunk_size_(initial_chunk_size < kHeaderSize * 2
+                               ? kHeaderSize * 2
+                               : initial_chunk_size) {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() { release(); }
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        char* p = align_up(cur_, align);
+        if (cur_ == nullptr || p > end_ ||
+            static_cast<size_t>(end_ - p) < bytes) {
+            new_chunk(bytes + align);
+            p = align_up(cur_, align);
+        }
+        cur_ = p + bytes;
+        return p;
+    }
+
+    // 单调资源不回收单个区块
+    void deallocate(void* /*ptr*/, size_t /*bytes*/) {}
+
+    // 归还所有大块内存，之前分配出去的指针全部失效
+    void release() {
+        while (chunks_ != nullptr) {
+            chunk* next = chunks_->next;
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+        cur_ = end_ = nullptr;
+    }
+
+private:
+    static char* align_up(char* p, size_t align) {
+        auto v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(align - 1));
+    }
+
+    // 申请一个至少能容纳 bytes 字节的大块，大块大小按两倍增长直至 kMaxChunkSize
+    void new_chunk(size_t bytes) {
+        size_t size = next_chunk_size_;
+        if (size - kHeaderSize < bytes) {
+            size = bytes + kHeaderSize;
+        }
+        if (next_chunk_size_ < kMaxChunkSize) {
+            next_chunk_size_ *= 2;
+        }
+
+        auto* c = static_cast<chunk*>(::operator new(size));
+        c->next = chunks_;
+        c->size = size;
+        chunks_ = c;
+        cur_ = reinterpret_cast<char*>(c) + kHeaderSize;
+        end_ = reinterpret_cast<char*>(c) + size;
+    }
+};
+
+}  // namespace mystl
@@ -0,0 +1,502 @@
+#pragma once
+
+// 这个头文件包含分配统计相关的组件
+// instrumented_alloc : 包装另一个分配策略，统计分配、释放的次数与字节数，
+//                      按元素类型、按大小级别分别计数，并记录存活字节数的峰值
+// alloc_stats        : 查询统计结果，设置调用位置的采样率，以 JSON 输出
+// alloc_scope        : 标记调用位置的 RAII 对象，采样到的分配记在最内层的 scope 上
+// 统计由宏 MYSTL_ALLOC_STATS 控制，默认为 0，此时 instrumented_alloc 直接转发给
+// 被包装的策略，alloc_scope 是空对象，查询只返回空结果，不产生任何运行时开销。
+// 一个程序的所有编译单元必须使用相同的 MYSTL_ALLOC_STATS
+
+#ifndef MYSTL_ALLOC_STATS
+#define MYSTL_ALLOC_STATS 0
+#endif
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+
+#include "alloc.hpp"
+#include "allocator.hpp"
+#include "sort.hpp"
+#include "vector.hpp"
+
+namespace mystl {
+
+// 一组计数的快照
+// 存活字节数与峰值在 reset 后保留，其余计数从 0 开始
+struct alloc_counters {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t bytes_deallocated = 0;
+    uint64_t live_bytes = 0;
+    uint64_t peak_bytes = 0;
+};
+
+// 某个元素类型的统计
+struct alloc_type_stats {
+    std::string type;
+    alloc_counters counters;
+};
+
+// 大小级别的统计，包含大小在 (max_bytes / 2, max_bytes] 之间的分配
+struct alloc_bucket_stats {
+    uint64_t max_bytes = 0;
+    alloc_counters counters;
+};
+
+// 采样到的调用位置
+struct alloc_site_stats {
+    const char* file = "";
+    uint32_t line = 0;
+    const char* function = "";
+    uint64_t samples = 0;
+    uint64_t bytes = 0;
+};
+
+class alloc_scope;
+
+namespace alloc_stats_detail {
+
+// 第 i 个级别的上界为 2^i 字节
+inline constexpr size_t kBuckets = 48;
+
+inline size_t bucket_of(size_t bytes) noexcept {
+    const size_t i = bytes <= 1 ? 0 : std::bit_width(bytes - 1);
+    return i < kBuckets ? i : kBuckets - 1;
+}
+
+struct atomic_counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> bytes_deallocated{0};
+    std::atomic<uint64_t> live{0};
+    std::atomic<uint64_t> peak{0};
+
+    void on_allocate(size_t bytes) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        const uint64_t now =
+            live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        uint64_t old = peak.load(std::memory_order_relaxed);
+        while (now > old && !peak.compare_exchange_weak(
+                                old, now, std::memory_order_relaxed)) {
+        }
+    }
+
+    void on_deallocate(size_t bytes) noexcept {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        bytes_deallocated.fetch_add(bytes, std::memory_order_relaxed);
+        live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    alloc_counters load() const noexcept {
+        alloc_counters c;
+        c.allocations = allocations.load(std::memory_order_relaxed);
+        c.deallocations = deallocations.load(std::memory_order_relaxed);
+        c.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        c.bytes_deallocated =
+            bytes_deallocated.load(std::memory_order_relaxed);
+        c.live_bytes = live.load(std::memory_order_relaxed);
+        c.peak_bytes = peak.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    void reset() noexcept {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        bytes_allocated.store(0, std::memory_order_relaxed);
+        bytes_deallocated.store(0, std::memory_order_relaxed);
+        peak.store(live.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+    }
+};
+
+// 每个元素类型一条记录，第一次分配时挂到全局的无锁链表上，之后不再移除
+struct type_record {
+    const char* signature;  // 带有类型名的函数签名，输出时才解析
+    atomic_counters counters;
+    type_record* next = nullptr;
+
+    explicit type_record(const char* sig) noexcept;
+};
+
+inline atomic_counters total;
+inline atomic_counters buckets[kBuckets];
+inline std::atomic<type_record*> types{nullptr};
+
+inline std::atomic<uint32_t> sample_rate{0};
+inline thread_local uint32_t sample_countdown = 0;
+inline thread_local const alloc_scope* current_scope = nullptr;
+
+inline std::mutex site_mutex;
+inline mystl::vector<alloc_site_stats> sites;
+
+inline type_record::type_record(const char* sig) noexcept : signature(sig) {
+    next = types.load(std::memory_order_relaxed);
+    while (!types.compare_exchange_weak(next, this, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+}
+
+template <typename T>
+type_record& record_of() noexcept {
+#ifdef _MSC_VER
+    static type_record record(__FUNCSIG__);
+#else
+    static type_record record(__PRETTY_FUNCTION__);
+#endif
+    return record;
+}
+
+// 从 record_of<T> 的签名中取出 T 的名字
+inline std::string type_name(const char* signature) {
+    const std::string sig(signature);
+    auto first = sig.find("T = ");
+    if (first != std::string::npos) {
+        first += 4;
+        auto last = sig.find_first_of(";]", first);
+        return sig.substr(first, last - first);
+    }
+    first = sig.find("record_of<");
+    if (first != std::string::npos) {
+        first += 10;
+        return sig.substr(first, sig.rfind(">(") - first);
+    }
+    return sig;
+}
+
+inline void sample(size_t bytes);
+
+inline void on_allocate(type_record* record, size_t bytes) {
+    total.on_allocate(bytes);
+    buckets[bucket_of(bytes)].on_allocate(bytes);
+    if (record != nullptr) {
+        record->counters.on_allocate(bytes);
+    }
+    if (sample_rate.load(std::memory_order_relaxed) != 0) {
+        sample(bytes);
+    }
+}
+
+inline void on_deallocate(type_record* record, size_t bytes) noexcept {
+    total.on_deallocate(bytes);
+    buckets[bucket_of(bytes)].on_deallocate(bytes);
+    if (record != nullptr) {
+        record->counters.on_deallocate(bytes);
+    }
+}
+
+}  // namespace alloc_stats_detail
+
+/*****************************************************************************************/
+// alloc_scope
+/*****************************************************************************************/
+
+// 在函数中声明一个 alloc_scope，该函数执行期间被采样到的分配都记在这个位置上
+// scope 可以嵌套，分配记在最内层；不在任何 scope 内的分配记为 <unscoped>
+class alloc_scope {
+#if MYSTL_ALLOC_STATS
+    std::source_location location_;
+    const alloc_scope* parent_;
+
+public:
+    explicit alloc_scope(
+        std::source_location location = std::source_location::current())
+        : location_(location),
+          parent_(alloc_stats_detail::current_scope) {
+        alloc_stats_detail::current_scope = this;
+    }
+    ~alloc_scope() { alloc_stats_detail::current_scope = parent_; }
+
+    const std::source_location& location() const noexcept {
+        return location_;
+    }
+#else
+public:
+    explicit alloc_scope(
+        std::source_location = std::source_location::current()) noexcept {}
+#endif
+
+    alloc_scope(const alloc_scope&) = delete;
+    alloc_scope& operator=(const alloc_scope&) = delete;
+};
+
+// 每个线程独立倒数，每 rate 次分配记录一次调用位置
+inline void alloc_stats_detail::sample(size_t bytes) {
+#if MYSTL_ALLOC_STATS
+    if (sample_countdown != 0) {
+        --sample_countdown;
+        return;
+    }
+    sample_countdown = sample_rate.load(std::memory_order_relaxed) - 1;
+
+    const char* file = "<unscoped>";
+    uint32_t line = 0;
+    const char* function = "";
+    if (current_scope != nullptr) {
+        file = current_scope->location().file_name();
+        line = current_scope->location().line();
+        function = current_scope->location().function_name();
+    }
+    std::lock_guard<std::mutex> lock(site_mutex);
+    for (auto& site : sites) {
+        if (site.line == line && std::strcmp(site.file, file) == 0 &&
+            std::strcmp(site.function, function) == 0) {
+            ++site.samples;
+            site.bytes += bytes;
+            return;
+        }
+    }
+    sites.push_back(alloc_site_stats{file, line, function, 1, bytes});
+#else
+    (void)bytes;
+#endif
+}
+
+/*****************************************************************************************/
+// instrumented_alloc
+/*****************************************************************************************/
+
+// 分配策略：instrumented_alloc
+// 模板参数 Alloc 为实际分配内存的策略。allocator<T, instrumented_alloc<...>>
+// 通过 typed_allocate / typed_deallocate 把元素类型传进来，用于按类型统计
+template <typename Alloc = new_alloc>
+class instrumented_alloc {
+public:
+    using base_alloc = Alloc;
+
+    static void* allocate(size_t bytes) {
+        void* ptr = Alloc::allocate(bytes);
+#if MYSTL_ALLOC_STATS
+        alloc_stats_detail::on_allocate(nullptr, bytes);
+#endif
+        return ptr;
+    }
+
+    static void deallocate(void* ptr, size_t bytes) {
+#if MYSTL_ALLOC_STATS
+        alloc_stats_detail::on_deallocate(nullptr, bytes);
+#endif
+        Alloc::deallocate(ptr, bytes);
+    }
+
+    template <typename T>
+    static void* typed_allocate(size_t bytes) {
+        void* ptr = Alloc::allocate(bytes);
+#if MYSTL_ALLOC_STATS
+        alloc_stats_detail::on_allocate(&alloc_stats_detail::record_of<T>(),
+                                        bytes);
+#endif
+        return ptr;
+    }
+
+    template <typename T>
+    static void typed_deallocate(void* ptr, size_t bytes) {
+#if MYSTL_ALLOC_STATS
+        alloc_stats_detail::on_deallocate(
+            &alloc_stats_detail::record_of<T>(), bytes);
+#endif
+        Alloc::deallocate(ptr, bytes);
+    }
+};
+
+// 带统计的 allocator，Alloc 为被包装的分配策略
+template <typename T, typename Alloc = new_alloc>
+using instrumented_allocator = allocator<T, instrumented_alloc<Alloc>>;
+
+/*****************************************************************************************/
+// alloc_stats
+/*****************************************************************************************/
+
+// 查询接口，MYSTL_ALLOC_STATS 为 0 时所有查询都返回空结果
+// 计数使用 relaxed 原子操作，并发分配时读到的快照之间可能有少量偏差
+class alloc_stats {
+public:
+    static constexpr bool enabled = MYSTL_ALLOC_STATS != 0;
+    static constexpr size_t kBuckets = alloc_stats_detail::kBuckets;
+
+    // 所有经过 instrumented_alloc 的分配
+    static alloc_counters total() noexcept {
+        if constexpr (enabled) {
+            return alloc_stats_detail::total.load();
+        } else {
+            return {};
+        }
+    }
+
+    // 元素类型为 T 的分配
+    template <typename T>
+    static alloc_counters of_type() noexcept {
+        if constexpr (enabled) {
+            return alloc_stats_detail::record_of<T>().counters.load();
+        } else {
+            return {};
+        }
+    }
+
+    // 按分配的字节数从大到小排列
+    static mystl::vector<alloc_type_stats> by_type() {
+        mystl::vector<alloc_type_stats> result;
+        if constexpr (enabled) {
+            auto* r = alloc_stats_detail::types.load(std::memory_order_acquire);
+            for (; r != nullptr; r = r->next) {
+                result.push_back(alloc_type_stats{
+                    alloc_stats_detail::type_name(r->signature),
+                    r->counters.load()});
+            }
+            mystl::sort(result.begin(), result.end(),
+                        [](const alloc_type_stats& a,
+                           const alloc_type_stats& b) {
+                            return a.counters.bytes_allocated >
+                                   b.counters.bytes_allocated;
+                        });
+        }
+        return result;
+    }
+
+    // 大小分布的直方图，只包含有过分配的级别，按大小递增
+    static mystl::vector<alloc_bucket_stats> by_size() {
+        mystl::vector<alloc_bucket_stats> result;
+        if constexpr (enabled) {
+            for (size_t i = 0; i < kBuckets; ++i) {
+                const auto c = alloc_stats_detail::buckets[i].load();
+                if (c.allocations != 0 || c.live_bytes != 0) {
+                    result.push_back(alloc_bucket_stats{uint64_t{1} << i, c});
+                }
+            }
+        }
+        return result;
+    }
+
+    // 采样到的调用位置，按采样到的字节数从大到小排列
+    static mystl::vector<alloc_site_stats> sites() {
+        mystl::vector<alloc_site_stats> result;
+        if constexpr (enabled) {
+            {
+                std::lock_guard<std::mutex> lock(
+                    alloc_stats_detail::site_mutex);
+                result = alloc_stats_detail::sites;
+            }
+            mystl::sort(result.begin(), result.end(),
+                        [](const alloc_site_stats& a,
+                           const alloc_site_stats& b) {
+                            return a.bytes > b.bytes;
+                        });
+        }
+        return result;
+    }
+
+    // 每 every 次分配记录一次调用位置，0 表示不采样 (默认)
+    static void set_sample_rate(uint32_t every) noexcept {
+        alloc_stats_detail::sample_rate.store(every,
+                                              std::memory_order_relaxed);
+    }
+    static uint32_t sample_rate() noexcept {
+        return alloc_stats_detail::sample_rate.load(
+            std::memory_order_relaxed);
+    }
+
+    // 清零所有计数和采样记录，存活字节数保留，峰值从当前存活字节数重新开始
+    static void reset() {
+        if constexpr (enabled) {
+            alloc_stats_detail::total.reset();
+            for (auto& bucket : alloc_stats_detail::buckets) {
+                bucket.reset();
+            }
+            auto* r = alloc_stats_detail::types.load(std::memory_order_acquire);
+            for (; r != nullptr; r = r->next) {
+                r->counters.reset();
+            }
+            std::lock_guard<std::mutex> lock(alloc_stats_detail::site_mutex);
+            alloc_stats_detail::sites.clear();
+        }
+    }
+
+    // 以 JSON 输出全部统计结果
+    static void dump_json(std::ostream& os) {
+        os << "{\n  \"enabled\": " << (enabled ? "true" : "false")
+           << ",\n  \"total\": ";
+        write_counters(os, total());
+        os << ",\n  \"by_type\": [";
+        const char* sep = "\n    ";
+        for (const auto& t : by_type()) {
+            os << sep << "{\"type\": ";
+            write_string(os, t.type.c_str());
+            os << ", ";
+            write_fields(os, t.counters);
+            os << "}";
+            sep = ",\n    ";
+        }
+        os << "\n  ],\n  \"by_size\": [";
+        sep = "\n    ";
+        for (const auto& b : by_size()) {
+            os << sep << "{\"max_bytes\": " << b.max_bytes << ", ";
+            write_fields(os, b.counters);
+            os << "}";
+            sep = ",\n    ";
+        }
+        os << "\n  ],\n  \"sample_rate\": " << sample_rate()
+           << ",\n  \"sites\": [";
+        sep = "\n    ";
+        for (const auto& s : sites()) {
+            os << sep << "{\"file\": ";
+            write_string(os, s.file);
+            os << ", \"line\": " << s.line << ", \"function\": ";
+            write_string(os, s.function);
+            os << ", \"samples\": " << s.samples << ", \"bytes\": " << s.bytes
+               << "}";
+            sep = ",\n    ";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    // 写到文件 path，无法打开时抛出 std::runtime_error
+    static void dump_json(const char* path) {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error(std::string("alloc_stats: cannot open ") +
+                                     path);
+        }
+        dump_json(out);
+    }
+
+private:
+    static void write_fields(std::ostream& os, const alloc_counters& c) {
+        os << "\"allocations\": " << c.allocations
+           << ", \"deallocations\": " << c.deallocations
+           << ", \"bytes_allocated\": " << c.bytes_allocated
+           << ", \"bytes_deallocated\": " << c.bytes_deallocated
+           << ", \"live_bytes\": " << c.live_bytes
+           << ", \"peak_bytes\": " << c.peak_bytes;
+    }
+
+    static void write_counters(std::ostream& os, const alloc_counters& c) {
+        os << "{";
+        write_fields(os, c);
+        os << "}";
+    }
+
+    static void write_string(std::ostream& os, const char* s) {
+        os << '"';
+        for (; *s != '\0'; ++s) {
+            if (*s == '"' || *s == '\\') {
+                os << '\\';
+            }
+            os << *s;
+        }
+        os << '"';
+    }
+};
+
+}  // namespace mystl
@@ -1,18 +1,22 @@
 #pragma once
 
-// 这个头文件包含一个模板类
-// allocator，用于管理内存的分配、释放，对象的构造、析构
+// 这个头文件包含两个模板类
+// allocator       : 用于管理内存的分配、释放，对象的构造、析构
+//                   可以在常量求值中使用，编译期的内存由 std::allocator 提供
+// arena_allocator : 持有一个 arena 的有状态 allocator，内存随 arena 一次性释放
 
+#include <memory>
 #include <new>
 
+#include "alloc.hpp"
 #include "construct.hpp"
 #include "util.hpp"
 
 namespace mystl {
 
 // 模板类：allocator
-// 模板函数代表数据类型
-template <typename T>
+// 模板参数 T 代表数据类型，Alloc 代表底层的内存分配策略
+template <typename T, typename Alloc = new_alloc>
 class allocator {
 public:
     using value_type = T;
@@ -22,35 +26,142 @@ public:
     using const_reference = const T&;
     using size_type = size_t;
     using difference_type = ptrdiff_t;
+    using alloc_type = Alloc;
+
+    template <typename U>
+    struct rebind {
+        using other = allocator<U, Alloc>;
+    };
+
+    constexpr allocator() = default;
+
+    template <typename U>
+    constexpr allocator(const allocator<U, Alloc>&) {}
 
 public:
-    static T* allocate() { return static_cast<T*>(::operator new(sizeof(T))); }
-    static T* allocate(size_type n) {
+    static constexpr T* allocate() { return allocate(1); }
+    // 常量求值中只有 std::allocator 能分配内存，并且必须在求值结束前释放
+    static constexpr T* allocate(size_type n) {
         if (n == 0) {
             return nullptr;
         }
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>().allocate(n);
+        }
 
-        return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(allocate_bytes(n * sizeof(T)));
     }
 
-    static void deallocate(T* ptr) {
+    static constexpr void deallocate(T* ptr) { deallocate(ptr, 1); }
+    // size 必须与 allocate(n) 时的 n 相同，内存池依据它将区块归还到对应的链表
+    static constexpr void deallocate(T* ptr, size_type size) {
         if (ptr == nullptr) {
             return;
         }
-
-        ::operator delete(ptr);
-    }
-    static void deallocate(T* ptr, size_type /*size*/) {
-        if (ptr == nullptr) {
+        if (std::is_constant_evaluated()) {
+            std::allocator<T>().deallocate(ptr, size);
             return;
         }
 
-        ::operator delete(ptr);
+        deallocate_bytes(ptr, size * sizeof(T));
     }
 
-    static void construct(T* ptr) {
+    static constexpr void construct(T* ptr) {
         mystl::construct(ptr);  // placement new
     }
+    static constexpr void construct(T* ptr, const T& value) {
+        mystl::construct(ptr, value);
+    }
+    static constexpr void construct(T* ptr, T&& value) {
+        mystl::construct(ptr, mystl::move(value));
+    }
+
+    template <typename... Args>
+    static constexpr void construct(T* ptr, Args&&... args) {
+        mystl::construct(ptr, mystl::forward<Args>(args)...);
+    }
+
+    static constexpr void destory(T* ptr) { mystl::destory(ptr); }
+    static constexpr void destory(T* first, T* last) {
+        mystl::destory(first, last);
+    }
+
+private:
+    // 分配策略提供 typed_allocate 时连同元素类型一起传入，例如按类型统计的
+    // instrumented_alloc，其余策略只需要字节数
+    static void* allocate_bytes(size_type bytes) {
+        if constexpr (requires { Alloc::template typed_allocate<T>(bytes); }) {
+            return Alloc::template typed_allocate<T>(bytes);
+        } else {
+            return Alloc::allocate(bytes);
+        }
+    }
+
+    static void deallocate_bytes(T* ptr, size_type bytes) {
+        if constexpr (requires {
+                          Alloc::template typed_deallocate<T>(ptr, bytes);
+                      }) {
+            Alloc::template typed_deallocate<T>(ptr, bytes);
+        } else {
+            Alloc::deallocate(ptr, bytes);
+        }
+    }
+};
+
+template <typename T1, typename T2, typename Alloc>
+constexpr bool operator==(const allocator<T1, Alloc>&,
+                          const allocator<T2, Alloc>&) {
+    return true;
+}
+
+// 模板类：arena_allocator
+// 有状态的 allocator，每个实例持有一个 arena 指针，从该 arena 中分配内存
+// deallocate 不归还内存，所有内存在 arena::release 时一次性释放
+template <typename T>
+class arena_allocator {
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+private:
+    arena* resource_;
+
+public:
+    explicit arena_allocator(arena& resource) : resource_(&resource) {}
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other)
+        : resource_(other.resource()) {}
+
+    arena* resource() const { return resource_; }
+
+public:
+    T* allocate() { return allocate(1); }
+    T* allocate(size_type n) {
+        if (n == 0) {
+            return nullptr;
+        }
+
+        return static_cast<T*>(
+            resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr) { deallocate(ptr, 1); }
+    void deallocate(T* ptr, size_type size) {
+        resource_->deallocate(ptr, size * sizeof(T));
+    }
+
+    static void construct(T* ptr) { mystl::construct(ptr); }
     static void construct(T* ptr, const T& value) {
         mystl::construct(ptr, value);
     }
@@ -67,4 +178,19 @@ public:
     static void destory(T* first, T* last) { mystl::destory(first, last); }
 };
 
+// 来自同一个 arena 的 allocator 才相等，可以互相释放对方分配的内存
+template <typename T1, typename T2>
+bool operator==(const arena_allocator<T1>& lhs,
+                const arena_allocator<T2>& rhs) {
+    return lhs.resource() == rhs.resource();
+}
+
+// 使用内存池的 allocator，适合频繁分配的小对象，例如节点型容器的节点
+template <typename T>
+using pool_allocator = allocator<T, pool_alloc>;
+
+// 使用线程缓存的 allocator，适合多线程下频繁分配释放的小对象
+template <typename T>
+using thread_cache_allocator = allocator<T, thread_cache_alloc>;
+
 }  // namespace mystl
\ No newline at end of file
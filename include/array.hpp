@@ -0,0 +1,256 @@
+#pragma once
+
+// 这个头文件包含模板类 array
+// array : 定长数组，元素直接存放在对象内部，是聚合类型，可以用花括号初始化
+// 所有操作都是 constexpr，可以在编译期生成的查找表中使用：
+// 先在常量求值中用 vector、sort 等计算出结果，再用 to_array 复制到 array 中
+// 运行期可逐字节比较的元素类型用 memcmp 比较
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 模板类：array
+// 模板参数 T 代表元素类型，N 代表元素个数
+template <typename T, size_t N>
+struct array {
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    // 为了保持聚合类型，数据成员必须是公有的
+    T elems_[N];
+
+    // 迭代器相关操作
+    constexpr iterator begin() noexcept { return elems_; }
+    constexpr const_iterator begin() const noexcept { return elems_; }
+    constexpr iterator end() noexcept { return elems_ + N; }
+    constexpr const_iterator end() const noexcept { return elems_ + N; }
+
+    constexpr reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    constexpr reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+    constexpr const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    constexpr bool empty() const noexcept { return false; }
+    constexpr size_type size() const noexcept { return N; }
+    constexpr size_type max_size() const noexcept { return N; }
+
+    // 访问元素相关操作
+    constexpr reference operator[](size_type n) { return elems_[n]; }
+    constexpr const_reference operator[](size_type n) const {
+        return elems_[n];
+    }
+
+    constexpr reference at(size_type n) {
+        if (n >= N) {
+            throw std::out_of_range("array<T, N>::at() subscript out of range");
+        }
+        return elems_[n];
+    }
+    constexpr const_reference at(size_type n) const {
+        if (n >= N) {
+            throw std::out_of_range("array<T, N>::at() subscript out of range");
+        }
+        return elems_[n];
+    }
+
+    constexpr reference front() { return elems_[0]; }
+    constexpr const_reference front() const { return elems_[0]; }
+    constexpr reference back() { return elems_[N - 1]; }
+    constexpr const_reference back() const { return elems_[N - 1]; }
+
+    constexpr pointer data() noexcept { return elems_; }
+    constexpr const_pointer data() const noexcept { return elems_; }
+
+    // 修改容器相关操作
+    constexpr void fill(const value_type& value) {
+        for (size_type i = 0; i < N; ++i) {
+            elems_[i] = value;
+        }
+    }
+
+    constexpr void swap(array& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<T> &&
+        std::is_nothrow_move_assignable_v<T>) {
+        mystl::swap(elems_, rhs.elems_);
+    }
+};
+
+// 长度为 0 的 array 不持有任何元素，所有迭代器都相等
+template <typename T>
+struct array<T, 0> {
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    constexpr iterator begin() noexcept { return nullptr; }
+    constexpr const_iterator begin() const noexcept { return nullptr; }
+    constexpr iterator end() noexcept { return nullptr; }
+    constexpr const_iterator end() const noexcept { return nullptr; }
+
+    constexpr reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    constexpr reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+    constexpr const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+    constexpr bool empty() const noexcept { return true; }
+    constexpr size_type size() const noexcept { return 0; }
+    constexpr size_type max_size() const noexcept { return 0; }
+
+    constexpr reference at(size_type) {
+        throw std::out_of_range("array<T, N>::at() subscript out of range");
+    }
+    constexpr const_reference at(size_type) const {
+        throw std::out_of_range("array<T, N>::at() subscript out of range");
+    }
+
+    constexpr pointer data() noexcept { return nullptr; }
+    constexpr const_pointer data() const noexcept { return nullptr; }
+
+    constexpr void fill(const value_type&) {}
+    constexpr void swap(array&) noexcept {}
+};
+
+// 推导指引：array a{1, 2, 3} 推导为 array<int, 3>
+template <typename T, typename... U>
+array(T, U...) -> array<T, 1 + sizeof...(U)>;
+
+// 重载比较操作符
+template <typename T, size_t N>
+constexpr bool operator==(const array<T, N>& lhs, const array<T, N>& rhs) {
+    if constexpr (is_bitwise_comparable_v<T> && N != 0) {
+        if (!std::is_constant_evaluated()) {
+            return std::memcmp(lhs.data(), rhs.data(), N * sizeof(T)) == 0;
+        }
+    }
+    for (size_t i = 0; i < N; ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, size_t N>
+constexpr bool operator<(const array<T, N>& lhs, const array<T, N>& rhs) {
+    if constexpr (is_bitwise_orderable_v<T> && N != 0) {
+        if (!std::is_constant_evaluated()) {
+            return std::memcmp(lhs.data(), rhs.data(), N) < 0;
+        }
+    }
+    for (size_t i = 0; i < N; ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+template <typename T, size_t N>
+constexpr bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t N>
+constexpr bool operator>(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, size_t N>
+constexpr bool operator<=(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, size_t N>
+constexpr bool operator>=(const array<T, N>& lhs, const array<T, N>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename T, size_t N>
+constexpr void swap(array<T, N>& lhs, array<T, N>& rhs) noexcept(
+    noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+// 从内置数组或任意随机访问区间构造 array
+// 用于把常量求值中计算出的 vector 复制成可以留到运行期的 array：
+//   constexpr auto table = mystl::to_array<int, 8>(make_table().data());
+template <typename T, size_t N>
+constexpr array<T, N> to_array(const T (&a)[N]) {
+    array<T, N> result{};
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = a[i];
+    }
+    return result;
+}
+
+template <typename T, size_t N, typename Iter>
+constexpr array<T, N> to_array(Iter first) {
+    array<T, N> result{};
+    for (size_t i = 0; i < N; ++i, ++first) {
+        result[i] = *first;
+    }
+    return result;
+}
+
+}  // namespace mystl
@@ -0,0 +1,1145 @@
+#pragma once
+
+// 这个头文件包含 B 树以及基于它的有序容器 btree_map、btree_set
+// 每个节点在连续数组中保存多个元素，节点大小约为几条缓存行，
+// 相比每个元素一个节点的红黑树，查找时访问的缓存行少得多，每个元素的额外开销也小得多
+// 插入时自顶向下预先分裂满节点，删除时自顶向下保证经过的节点至少有 t 个元素，
+// 因此两者都只需要一次从根到叶子的遍历
+// 任何插入或删除都会使所有迭代器失效
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "uninitialized.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+namespace btree_detail {
+
+// 节点的目标大小，决定每个节点能容纳的元素个数
+constexpr size_t kTargetNodeSize = 256;
+
+// 从元素中取出键
+struct identity {
+    template <typename T>
+    const T& operator()(const T& value) const {
+        return value;
+    }
+};
+
+struct select_first {
+    template <typename Pair>
+    const typename Pair::first_type& operator()(const Pair& value) const {
+        return value.first;
+    }
+};
+
+// 节点中的元素个数为 2t - 1，并且至少为 3
+template <typename Value>
+constexpr size_t node_slots() {
+    constexpr size_t kHeader = 2 * sizeof(void*);
+    size_t n = kTargetNodeSize > kHeader + 3 * sizeof(Value)
+                   ? (kTargetNodeSize - kHeader) / sizeof(Value)
+                   : 3;
+    if (n > 255) {
+        n = 255;
+    }
+    return n % 2 == 0 ? n - 1 : n;
+}
+
+// 叶子节点：只保存元素
+template <typename Value>
+struct node {
+    static constexpr size_t kSlots = node_slots<Value>();
+
+    node* parent;
+    uint16_t position;  // 在父节点 children 中的下标
+    uint16_t count;     // 元素个数
+    bool leaf;
+    alignas(Value) unsigned char storage[kSlots * sizeof(Value)];
+
+    Value* slot(size_t i) { return reinterpret_cast<Value*>(storage) + i; }
+    const Value* slot(size_t i) const {
+        return reinterpret_cast<const Value*>(storage) + i;
+    }
+
+    node*& child(size_t i);
+    node* child(size_t i) const;
+};
+
+// 内部节点：在叶子节点之后追加 kSlots + 1 个子节点指针
+template <typename Value>
+struct internal_node : public node<Value> {
+    node<Value>* children[node<Value>::kSlots + 1];
+};
+
+template <typename Value>
+node<Value>*& node<Value>::child(size_t i) {
+    return static_cast<internal_node<Value>*>(this)->children[i];
+}
+
+template <typename Value>
+node<Value>* node<Value>::child(size_t i) const {
+    return static_cast<const internal_node<Value>*>(this)->children[i];
+}
+
+// 双向迭代器，指向 node 中的第 position 个元素
+// end() 为最右叶子节点的 (count) 位置
+template <typename Value, bool Const>
+class btree_iterator
+    : public mystl::iterator<bidirectional_iterator_tag, Value> {
+    template <typename, typename, typename, typename, typename>
+    friend class btree;
+    template <typename, bool>
+    friend class btree_iterator;
+
+    using node_type = node<Value>;
+    using node_ptr = std::conditional_t<Const, const node_type*, node_type*>;
+
+    node_ptr node_ = nullptr;
+    int position_ = 0;
+
+    btree_iterator(node_ptr n, int position) : node_(n), position_(position) {}
+
+public:
+    using reference = std::conditional_t<Const, const Value&, Value&>;
+    using pointer = std::conditional_t<Const, const Value*, Value*>;
+
+    btree_iterator() = default;
+
+    // 允许 iterator 隐式转换为 const_iterator
+    template <bool C = Const>
+    requires C
+    btree_iterator(const btree_iterator<Value, false>& other)
+        : node_(other.node_), position_(other.position_) {}
+
+    reference operator*() const { return *node_->slot(position_); }
+    pointer operator->() const { return node_->slot(position_); }
+
+    btree_iterator& operator++() {
+        if (!node_->leaf) {
+            // 下一个元素是右子树的最左元素
+            node_ = node_->child(position_ + 1);
+            while (!node_->leaf) {
+                node_ = node_->child(0);
+            }
+            position_ = 0;
+            return *this;
+        }
+        if (++position_ < node_->count) {
+            return *this;
+        }
+        // 向上回溯，直到从某个子节点的左侧返回
+        btree_iterator save = *this;
+        while (position_ == node_->count && node_->parent != nullptr) {
+            position_ = node_->position;
+            node_ = node_->parent;
+        }
+        if (position_ == node_->count) {
+            *this = save;  // 已经是最后一个元素，停在 end()
+        }
+        return *this;
+    }
+
+    btree_iterator operator++(int) {
+        btree_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    btree_iterator& operator--() {
+        if (!node_->leaf) {
+            // 上一个元素是左子树的最右元素
+            node_ = node_->child(position_);
+            while (!node_->leaf) {
+                node_ = node_->child(node_->count);
+            }
+            position_ = node_->count - 1;
+            return *this;
+        }
+        while (position_ == 0 && node_->parent != nullptr) {
+            position_ = node_->position;
+            node_ = node_->parent;
+        }
+        --position_;
+        return *this;
+    }
+
+    btree_iterator operator--(int) {
+        btree_iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    friend bool operator==(const btree_iterator& lhs,
+                           const btree_iterator& rhs) {
+        return lhs.node_ == rhs.node_ && lhs.position_ == rhs.position_;
+    }
+
+    friend bool operator!=(const btree_iterator& lhs,
+                           const btree_iterator& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+// 模板类：btree
+// 元素唯一的 B 树，KeyOfValue 从元素中取出键，Compare 比较键的大小
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Alloc>
+class btree {
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = btree_iterator<Value, false>;
+    using const_iterator = btree_iterator<Value, true>;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+private:
+    using node_type = node<Value>;
+    using internal_type = internal_node<Value>;
+    using leaf_allocator = typename Alloc::template rebind<node_type>::other;
+    using internal_allocator =
+        typename Alloc::template rebind<internal_type>::other;
+
+    static constexpr size_t kSlots = node_type::kSlots;
+    static constexpr size_t kMinDegree = (kSlots + 1) / 2;  // 即 t
+
+    node_type* root_ = nullptr;
+    size_type size_ = 0;
+    [[no_unique_address]] Compare comp_;
+    [[no_unique_address]] Alloc alloc_;
+
+public:
+    btree() = default;
+
+    explicit btree(const Compare& comp, const Alloc& alloc = Alloc())
+        : comp_(comp), alloc_(alloc) {}
+
+    btree(const btree& rhs) : comp_(rhs.comp_), alloc_(rhs.alloc_) {
+        if (rhs.root_ != nullptr) {
+            root_ = clone(rhs.root_, nullptr);
+            size_ = rhs.size_;
+        }
+    }
+
+    btree(btree&& rhs) noexcept
+        : root_(rhs.root_),
+          size_(rhs.size_),
+          comp_(mystl::move(rhs.comp_)),
+          alloc_(mystl::move(rhs.alloc_)) {
+        rhs.root_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    btree& operator=(const btree& rhs) {
+        if (this != &rhs) {
+            btree tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    btree& operator=(btree&& rhs) noexcept {
+        if (this != &rhs) {
+            btree tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~btree() { clear(); }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(leftmost(), 0); }
+    const_iterator begin() const noexcept {
+        return const_iterator(leftmost(), 0);
+    }
+    iterator end() noexcept {
+        node_type* n = rightmost();
+        return iterator(n, n == nullptr ? 0 : n->count);
+    }
+    const_iterator end() const noexcept {
+        node_type* n = rightmost();
+        return const_iterator(n, n == nullptr ? 0 : n->count);
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    // 树的高度，空树为 0
+    size_type height() const noexcept {
+        size_type h = 0;
+        for (const node_type* n = root_; n != nullptr;
+             n = n->leaf ? nullptr : n->child(0)) {
+            ++h;
+        }
+        return h;
+    }
+
+    static constexpr size_type node_capacity() { return kSlots; }
+
+    // 查找相关操作
+    iterator lower_bound(const key_type& key) {
+        return make_iterator(lower_bound_impl(key));
+    }
+    const_iterator lower_bound(const key_type& key) const {
+        return make_const_iterator(lower_bound_impl(key));
+    }
+
+    iterator upper_bound(const key_type& key) {
+        return make_iterator(upper_bound_impl(key));
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        return make_const_iterator(upper_bound_impl(key));
+    }
+
+    iterator find(const key_type& key) {
+        auto r = find_impl(key);
+        return r.first == nullptr ? end() : iterator(r.first, r.second);
+    }
+    const_iterator find(const key_type& key) const {
+        auto r = find_impl(key);
+        return r.first == nullptr ? end() : const_iterator(r.first, r.second);
+    }
+
+    // 修改容器相关操作
+
+    // 键不存在时调用 make(slot) 在 slot 处构造元素，返回元素位置以及是否插入
+    template <typename Fn>
+    mystl::pair<iterator, bool> insert_unique(const key_type& key, Fn&& make) {
+        if (root_ == nullptr) {
+            root_ = new_leaf();
+        }
+        if (root_->count == kSlots) {
+            node_type* old_root = root_;
+            root_ = new_internal();
+            set_child(root_, 0, old_root);
+            split_child(root_, 0);
+        }
+
+        node_type* x = root_;
+        while (true) {
+            size_t i = lower_index(x, key);
+            if (i < x->count && !comp_(key, key_of(x, i))) {
+                return mystl::pair<iterator, bool>(iterator(x, i), false);
+            }
+            if (x->leaf) {
+                move_slots(x->slot(i + 1), x->slot(i), x->count - i);
+                try {
+                    make(x->slot(i));
+                } catch (...) {
+                    move_slots(x->slot(i), x->slot(i + 1), x->count - i);
+                    throw;
+                }
+                ++x->count;
+                ++size_;
+                return mystl::pair<iterator, bool>(iterator(x, i), true);
+            }
+            if (x->child(i)->count == kSlots) {
+                split_child(x, i);
+                if (!comp_(key, key_of(x, i))) {
+                    if (!comp_(key_of(x, i), key)) {
+                        return mystl::pair<iterator, bool>(iterator(x, i),
+                                                           false);
+                    }
+                    ++i;
+                }
+            }
+            x = x->child(i);
+        }
+    }
+
+    // 删除键为 key 的元素，返回删除的个数
+    size_type erase_unique(const key_type& key) {
+        if (root_ == nullptr) {
+            return 0;
+        }
+        const bool erased = erase_impl(key);
+        if (root_->count == 0) {
+            // 只有根节点可能变空，此时树的高度减一
+            node_type* old_root = root_;
+            if (old_root->leaf) {
+                root_ = nullptr;
+            } else {
+                root_ = old_root->child(0);
+                root_->parent = nullptr;
+                root_->position = 0;
+            }
+            free_node(old_root);
+        }
+        if (erased) {
+            --size_;
+        }
+        return erased ? 1 : 0;
+    }
+
+    void clear() noexcept {
+        if (root_ != nullptr) {
+            destroy_subtree(root_);
+            root_ = nullptr;
+        }
+        size_ = 0;
+    }
+
+    void swap(btree& rhs) noexcept {
+        mystl::swap(root_, rhs.root_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(comp_, rhs.comp_);
+        mystl::swap(alloc_, rhs.alloc_);
+    }
+
+    key_compare key_comp() const { return comp_; }
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    static const key_type& key_of(const node_type* n, size_t i) {
+        return KeyOfValue()(*n->slot(i));
+    }
+
+    node_type* leftmost() const {
+        node_type* n = root_;
+        if (n != nullptr) {
+            while (!n->leaf) {
+                n = n->child(0);
+            }
+        }
+        return n;
+    }
+
+    node_type* rightmost() const {
+        node_type* n = root_;
+        if (n != nullptr) {
+            while (!n->leaf) {
+                n = n->child(n->count);
+            }
+        }
+        return n;
+    }
+
+    // 节点内第一个不小于 key 的位置，二分查找
+    size_t lower_index(const node_type* n, const key_type& key) const {
+        size_t lo = 0;
+        size_t hi = n->count;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (comp_(key_of(n, mid), key)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // 节点内第一个大于 key 的位置
+    size_t upper_index(const node_type* n, const key_type& key) const {
+        size_t lo = 0;
+        size_t hi = n->count;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (comp_(key, key_of(n, mid))) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    mystl::pair<node_type*, int> find_impl(const key_type& key) const {
+        for (node_type* n = root_; n != nullptr;) {
+            const size_t i = lower_index(n, key);
+            if (i < n->count && !comp_(key, key_of(n, i))) {
+                return mystl::pair<node_type*, int>(n, static_cast<int>(i));
+            }
+            n = n->leaf ? nullptr : n->child(i);
+        }
+        return mystl::pair<node_type*, int>(nullptr, 0);
+    }
+
+    // 返回的位置可能等于节点的 count，由 make_iterator 修正为下一个元素
+    mystl::pair<node_type*, int> lower_bound_impl(const key_type& key) const {
+        mystl::pair<node_type*, int> r(nullptr, 0);
+        for (node_type* n = root_; n != nullptr;) {
+            const size_t i = lower_index(n, key);
+            r = mystl::pair<node_type*, int>(n, static_cast<int>(i));
+            if (i < n->count && !comp_(key, key_of(n, i))) {
+                break;
+            }
+            n = n->leaf ? nullptr : n->child(i);
+        }
+        return r;
+    }
+
+    mystl::pair<node_type*, int> upper_bound_impl(const key_type& key) const {
+        mystl::pair<node_type*, int> r(nullptr, 0);
+        for (node_type* n = root_; n != nullptr;) {
+            const size_t i = upper_index(n, key);
+            r = mystl::pair<node_type*, int>(n, static_cast<int>(i));
+            n = n->leaf ? nullptr : n->child(i);
+        }
+        return r;
+    }
+
+    // 叶子节点的 (n, count) 位置表示“该叶子之后的下一个元素”
+    iterator make_iterator(mystl::pair<node_type*, int> r) {
+        if (r.first == nullptr) {
+            return end();
+        }
+        iterator it(r.first, r.second);
+        if (r.second == r.first->count) {
+            while (it.position_ == it.node_->count &&
+                   it.node_->parent != nullptr) {
+                it.position_ = it.node_->position;
+                it.node_ = it.node_->parent;
+            }
+            if (it.position_ == it.node_->count) {
+                return end();
+            }
+        }
+        return it;
+    }
+
+    const_iterator make_const_iterator(mystl::pair<node_type*, int> r) const {
+        return const_cast<btree*>(this)->make_iterator(r);
+    }
+
+    // 节点的分配与释放
+
+    node_type* new_leaf() {
+        node_type* n = leaf_allocator(alloc_).allocate(1);
+        n->parent = nullptr;
+        n->position = 0;
+        n->count = 0;
+        n->leaf = true;
+        return n;
+    }
+
+    node_type* new_internal() {
+        internal_type* n = internal_allocator(alloc_).allocate(1);
+        n->parent = nullptr;
+        n->position = 0;
+        n->count = 0;
+        n->leaf = false;
+        return n;
+    }
+
+    node_type* new_node_like(const node_type* n) {
+        return n->leaf ? new_leaf() : new_internal();
+    }
+
+    void free_node(node_type* n) {
+        if (n->leaf) {
+            leaf_allocator(alloc_).deallocate(n, 1);
+        } else {
+            internal_allocator(alloc_).deallocate(
+                static_cast<internal_type*>(n), 1);
+        }
+    }
+
+    void destroy_subtree(node_type* n) {
+        if (!n->leaf) {
+            for (size_t i = 0; i <= n->count; ++i) {
+                destroy_subtree(n->child(i));
+            }
+        }
+        mystl::destory(n->slot(0), n->slot(n->count));
+        free_node(n);
+    }
+
+    node_type* clone(const node_type* src, node_type* parent) {
+        node_type* n = new_node_like(src);
+        n->parent = parent;
+        n->position = src->position;
+        try {
+            mystl::uninitialized_copy(src->slot(0), src->slot(src->count),
+                                      n->slot(0));
+        } catch (...) {
+            free_node(n);
+            throw;
+        }
+        n->count = src->count;
+        if (!src->leaf) {
+            size_t i = 0;
+            try {
+                for (; i <= src->count; ++i) {
+                    n->child(i) = clone(src->child(i), n);
+                }
+            } catch (...) {
+                // 只有前 i 个子节点已经复制，先释放它们再释放本节点
+                for (size_t j = 0; j < i; ++j) {
+                    destroy_subtree(n->child(j));
+                }
+                mystl::destory(n->slot(0), n->slot(src->count));
+                free_node(n);
+                throw;
+            }
+        }
+        return n;
+    }
+
+    // 元素与子节点的搬运
+
+    // 把 src 开始的 n 个元素搬到 dst，两段区间可以重叠
+    // 搬到一半抛出异常会在节点中留下空洞，因此要求逐个搬运不会抛出
+    static void move_slots(Value* dst, Value* src, size_t n) {
+        static_assert(is_trivially_relocatable_v<Value> ||
+                          std::is_nothrow_move_constructible_v<Value>,
+                      "btree requires nothrow relocatable elements");
+        if (n == 0 || dst == src) {
+            return;
+        }
+        if constexpr (is_trivially_relocatable_v<Value>) {
+            std::memmove(static_cast<void*>(dst), static_cast<void*>(src),
+                         n * sizeof(Value));
+        } else if (dst < src) {
+            for (size_t i = 0; i < n; ++i) {
+                mystl::relocate(src + i, src + i + 1, dst + i);
+            }
+        } else {
+            for (size_t i = n; i > 0; --i) {
+                mystl::relocate(src + i - 1, src + i, dst + i - 1);
+            }
+        }
+    }
+
+    static void set_child(node_type* parent, size_t i, node_type* c) {
+        parent->child(i) = c;
+        c->parent = parent;
+        c->position = static_cast<uint16_t>(i);
+    }
+
+    // 把 src 的第 [from, from + n) 个子节点搬到 dst 的第 to 个位置开始，可以重叠
+    static void move_children(node_type* dst, size_t to, node_type* src,
+                              size_t from, size_t n) {
+        if (dst == src && to > from) {
+            for (size_t i = n; i > 0; --i) {
+                set_child(dst, to + i - 1, src->child(from + i - 1));
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                set_child(dst, to + i, src->child(from + i));
+            }
+        }
+    }
+
+    // 分裂 x 的第 i 个子节点，该子节点必须是满的，x 必须未满
+    // 中间元素上移到 x 的第 i 个位置，后一半元素移入新节点，成为 x 的第 i + 1 个子节点
+    void split_child(node_type* x, size_t i) {
+        node_type* y = x->child(i);
+        node_type* z = new_node_like(y);
+        constexpr size_t t = kMinDegree;
+
+        move_slots(z->slot(0), y->slot(t), t - 1);
+        if (!y->leaf) {
+            move_children(z, 0, y, t, t);
+        }
+        z->count = t - 1;
+
+        move_slots(x->slot(i + 1), x->slot(i), x->count - i);
+        move_children(x, i + 2, x, i + 1, x->count - i);
+        move_slots(x->slot(i), y->slot(t - 1), 1);
+        set_child(x, i + 1, z);
+        ++x->count;
+        y->count = t - 1;
+    }
+
+    // 合并 x 的第 i、i + 1 个子节点以及它们之间的元素，两个子节点都只有 t - 1 个元素
+    void merge_children(node_type* x, size_t i) {
+        node_type* y = x->child(i);
+        node_type* z = x->child(i + 1);
+        constexpr size_t t = kMinDegree;
+
+        move_slots(y->slot(t - 1), x->slot(i), 1);
+        move_slots(y->slot(t), z->slot(0), z->count);
+        if (!y->leaf) {
+            move_children(y, t, z, 0, z->count + 1);
+        }
+        y->count = 2 * t - 1;
+
+        move_slots(x->slot(i), x->slot(i + 1), x->count - i - 1);
+        move_children(x, i + 1, x, i + 2, x->count - i - 1);
+        --x->count;
+        free_node(z);
+    }
+
+    // 从左兄弟借一个元素给 x 的第 i 个子节点
+    void borrow_from_left(node_type* x, size_t i) {
+        node_type* c = x->child(i);
+        node_type* left = x->child(i - 1);
+
+        move_slots(c->slot(1), c->slot(0), c->count);
+        move_slots(c->slot(0), x->slot(i - 1), 1);
+        move_slots(x->slot(i - 1), left->slot(left->count - 1), 1);
+        if (!c->leaf) {
+            move_children(c, 1, c, 0, c->count + 1);
+            set_child(c, 0, left->child(left->count));
+        }
+        ++c->count;
+        --left->count;
+    }
+
+    // 从右兄弟借一个元素给 x 的第 i 个子节点
+    void borrow_from_right(node_type* x, size_t i) {
+        node_type* c = x->child(i);
+        node_type* right = x->child(i + 1);
+
+        move_slots(c->slot(c->count), x->slot(i), 1);
+        move_slots(x->slot(i), right->slot(0), 1);
+        move_slots(right->slot(0), right->slot(1), right->count - 1);
+        if (!c->leaf) {
+            set_child(c, c->count + 1, right->child(0));
+            move_children(right, 0, right, 1, right->count);
+        }
+        ++c->count;
+        --right->count;
+    }
+
+    // 保证 x 的第 i 个子节点至少有 t 个元素，返回调整后应当进入的子节点下标
+    size_t fill_child(node_type* x, size_t i) {
+        if (x->child(i)->count >= kMinDegree) {
+            return i;
+        }
+        if (i > 0 && x->child(i - 1)->count >= kMinDegree) {
+            borrow_from_left(x, i);
+        } else if (i < x->count && x->child(i + 1)->count >= kMinDegree) {
+            borrow_from_right(x, i);
+        } else if (i < x->count) {
+            merge_children(x, i);
+        } else {
+            merge_children(x, i - 1);
+            --i;
+        }
+        return i;
+    }
+
+    // 把以 n 为根的子树中最大的元素搬到 dst，n 至少有 t 个元素
+    void extract_max(node_type* n, Value* dst) {
+        while (!n->leaf) {
+            n = n->child(fill_child(n, n->count));
+        }
+        move_slots(dst, n->slot(n->count - 1), 1);
+        --n->count;
+    }
+
+    // 把以 n 为根的子树中最小的元素搬到 dst，n 至少有 t 个元素
+    void extract_min(node_type* n, Value* dst) {
+        while (!n->leaf) {
+            n = n->child(fill_child(n, 0));
+        }
+        move_slots(dst, n->slot(0), 1);
+        move_slots(n->slot(0), n->slot(1), n->count - 1);
+        --n->count;
+    }
+
+    bool erase_impl(const key_type& key) {
+        node_type* x = root_;
+        while (true) {
+            size_t i = lower_index(x, key);
+            const bool found = i < x->count && !comp_(key, key_of(x, i));
+            if (x->leaf) {
+                if (!found) {
+                    return false;
+                }
+                mystl::destory(x->slot(i));
+                move_slots(x->slot(i), x->slot(i + 1), x->count - i - 1);
+                --x->count;
+                return true;
+            }
+            if (found) {
+                if (x->child(i)->count >= kMinDegree) {
+                    // 用前驱替换被删除的元素
+                    mystl::destory(x->slot(i));
+                    extract_max(x->child(i), x->slot(i));
+                    return true;
+                }
+                if (x->child(i + 1)->count >= kMinDegree) {
+                    // 用后继替换被删除的元素
+                    mystl::destory(x->slot(i));
+                    extract_min(x->child(i + 1), x->slot(i));
+                    return true;
+                }
+                // 被删除的元素随合并下移到子节点中
+                merge_children(x, i);
+                x = x->child(i);
+                continue;
+            }
+            x = x->child(fill_child(x, i));
+        }
+    }
+};
+
+}  // namespace btree_detail
+
+// 模板类：btree_map
+// 键唯一的有序映射，元素类型为 mystl::pair<const Key, T>
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc = mystl::allocator<mystl::pair<const Key, T>>>
+class btree_map {
+private:
+    using tree_type =
+        btree_detail::btree<Key, mystl::pair<const Key, T>,
+                            btree_detail::select_first, Compare, Alloc>;
+
+    tree_type tree_;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = mystl::pair<const Key, T>;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using iterator = typename tree_type::iterator;
+    using const_iterator = typename tree_type::const_iterator;
+    using reverse_iterator = typename tree_type::reverse_iterator;
+    using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+
+public:
+    btree_map() = default;
+
+    explicit btree_map(const Compare& comp, const Alloc& alloc = Alloc())
+        : tree_(comp, alloc) {}
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    btree_map(Iter first, Iter last) {
+        insert(first, last);
+    }
+
+    btree_map(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return tree_.begin(); }
+    const_iterator begin() const noexcept { return tree_.begin(); }
+    iterator end() noexcept { return tree_.end(); }
+    const_iterator end() const noexcept { return tree_.end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return tree_.empty(); }
+    size_type size() const noexcept { return tree_.size(); }
+    size_type height() const noexcept { return tree_.height(); }
+
+    // 查找相关操作
+    iterator find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+    bool contains(const key_type& key) const { return find(key) != end(); }
+    size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const {
+        return tree_.lower_bound(key);
+    }
+
+    iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const {
+        return tree_.upper_bound(key);
+    }
+
+    mystl::pair<iterator, iterator> equal_range(const key_type& key) {
+        return mystl::pair<iterator, iterator>(lower_bound(key),
+                                               upper_bound(key));
+    }
+
+    mapped_type& at(const key_type& key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("btree_map<Key, T>::at() no such key");
+        }
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("btree_map<Key, T>::at() no such key");
+        }
+        return it->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    // 修改容器相关操作
+    template <typename... Args>
+    mystl::pair<iterator, bool> try_emplace(const key_type& key,
+                                            Args&&... args) {
+        return tree_.insert_unique(key, [&](value_type* slot) {
+            mystl::construct(slot, key,
+                             mapped_type(mystl::forward<Args>(args)...));
+        });
+    }
+
+    template <typename... Args>
+    mystl::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(mystl::forward<Args>(args)...);
+        return tree_.insert_unique(value.first, [&](value_type* slot) {
+            mystl::construct(slot, mystl::move(value));
+        });
+    }
+
+    mystl::pair<iterator, bool> insert(const value_type& value) {
+        return tree_.insert_unique(value.first, [&](value_type* slot) {
+            mystl::construct(slot, value);
+        });
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    void insert(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    template <typename M>
+    mystl::pair<iterator, bool> insert_or_assign(const key_type& key,
+                                                 M&& obj) {
+        auto result = try_emplace(key, mystl::forward<M>(obj));
+        if (!result.second) {
+            result.first->second = mystl::forward<M>(obj);
+        }
+        return result;
+    }
+
+    size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+
+    // 删除 pos 处的元素，返回下一个元素的位置
+    iterator erase(const_iterator pos) {
+        key_type key = pos->first;
+        tree_.erase_unique(key);
+        return lower_bound(key);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == last) {
+            return last == end() ? end() : lower_bound(last->first);
+        }
+        size_type n = static_cast<size_type>(mystl::distance(first, last));
+        iterator it = lower_bound(first->first);
+        for (; n > 0; --n) {
+            it = erase(it);
+        }
+        return it;
+    }
+
+    void clear() noexcept { tree_.clear(); }
+    void swap(btree_map& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+};
+
+// 模板类：btree_set
+// 元素唯一的有序集合，迭代器只能读取元素
+template <typename Key, typename Compare = std::less<Key>,
+          typename Alloc = mystl::allocator<Key>>
+class btree_set {
+private:
+    using tree_type = btree_detail::btree<Key, Key, btree_detail::identity,
+                                          Compare, Alloc>;
+
+    tree_type tree_;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+
+    using iterator = typename tree_type::const_iterator;
+    using const_iterator = typename tree_type::const_iterator;
+    using reverse_iterator = typename tree_type::const_reverse_iterator;
+    using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+
+public:
+    btree_set() = default;
+
+    explicit btree_set(const Compare& comp, const Alloc& alloc = Alloc())
+        : tree_(comp, alloc) {}
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    btree_set(Iter first, Iter last) {
+        insert(first, last);
+    }
+
+    btree_set(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+public:
+    // 迭代器相关操作
+    const_iterator begin() const noexcept { return tree_.begin(); }
+    const_iterator end() const noexcept { return tree_.end(); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return tree_.empty(); }
+    size_type size() const noexcept { return tree_.size(); }
+    size_type height() const noexcept { return tree_.height(); }
+
+    // 查找相关操作
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+    bool contains(const key_type& key) const { return find(key) != end(); }
+    size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    const_iterator lower_bound(const key_type& key) const {
+        return tree_.lower_bound(key);
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        return tree_.upper_bound(key);
+    }
+
+    mystl::pair<const_iterator, const_iterator> equal_range(
+        const key_type& key) const {
+        return mystl::pair<const_iterator, const_iterator>(lower_bound(key),
+                                                           upper_bound(key));
+    }
+
+    // 修改容器相关操作
+    template <typename... Args>
+    mystl::pair<const_iterator, bool> emplace(Args&&... args) {
+        value_type value(mystl::forward<Args>(args)...);
+        auto r = tree_.insert_unique(value, [&](value_type* slot) {
+            mystl::construct(slot, mystl::move(value));
+        });
+        return mystl::pair<const_iterator, bool>(r.first, r.second);
+    }
+
+    mystl::pair<const_iterator, bool> insert(const value_type& value) {
+        auto r = tree_.insert_unique(value, [&](value_type* slot) {
+            mystl::construct(slot, value);
+        });
+        return mystl::pair<const_iterator, bool>(r.first, r.second);
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    void insert(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+
+    // 删除 pos 处的元素，返回下一个元素的位置
+    const_iterator erase(const_iterator pos) {
+        key_type key = *pos;
+        tree_.erase_unique(key);
+        return lower_bound(key);
+    }
+
+    void clear() noexcept { tree_.clear(); }
+    void swap(btree_set& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+};
+
+// 重载比较操作符
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator==(const btree_map<Key, T, Compare, Alloc>& lhs,
+                const btree_map<Key, T, Compare, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (auto i = lhs.begin(), j = rhs.begin(); i != lhs.end(); ++i, ++j) {
+        if (!(*i == *j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator!=(const btree_map<Key, T, Compare, Alloc>& lhs,
+                const btree_map<Key, T, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator==(const btree_set<Key, Compare, Alloc>& lhs,
+                const btree_set<Key, Compare, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (auto i = lhs.begin(), j = rhs.begin(); i != lhs.end(); ++i, ++j) {
+        if (!(*i == *j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator!=(const btree_set<Key, Compare, Alloc>& lhs,
+                const btree_set<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(btree_map<Key, T, Compare, Alloc>& lhs,
+          btree_map<Key, T, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(btree_set<Key, Compare, Alloc>& lhs,
+          btree_set<Key, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
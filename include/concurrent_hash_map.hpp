@@ -0,0 +1,429 @@
+#pragma once
+
+// 这个头文件包含一个模板类 concurrent_hash_map
+// concurrent_hash_map : 多线程共享的哈希表，按哈希值分成若干分片，
+//                       每个分片是一张带自己的互斥锁的链式哈希表
+// 读操作不加锁：进入纪元临界区后读取分片的桶数组并沿链表查找，步数只取决于
+// 链表长度，不等待写者也不会被写者阻塞 (wait-free)
+// 写操作只锁住键所在的分片，不同分片上的写者互不影响
+// 已经发布的节点不再修改：insert_or_assign 构造新节点替换旧节点，扩容时把
+// 全部节点复制到新的桶数组；被替换、删除的节点与旧的桶数组交给 epoch_domain，
+// 所有可能读到它们的读者离开之后才用 destory 析构并释放
+// 读到的元素只在 visit / for_each 的回调中以引用的形式可见，find 返回副本
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "epoch.hpp"
+#include "flat_hash_map.hpp"
+#include "util.hpp"
+#include "vector.hpp"
+
+namespace mystl {
+
+// 模板类：concurrent_hash_map
+// 模板参数分别代表键类型、值类型、哈希函数和键比较函数
+// 扩容时复制节点，因此要求键与值可以复制构造
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class concurrent_hash_map {
+    static_assert(std::is_copy_constructible_v<Key> &&
+                      std::is_copy_constructible_v<T>,
+                  "concurrent_hash_map copies entries when a shard grows");
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = mystl::pair<const Key, T>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    static constexpr size_type kCacheLine = 64;
+    static constexpr size_type kDefaultShards = 64;
+
+private:
+    struct node {
+        std::atomic<node*> next;
+        size_t hash;
+        value_type value;
+
+        template <typename... Args>
+        node(size_t h, Args&&... args)
+            : next(nullptr), hash(h), value(mystl::forward<Args>(args)...) {}
+    };
+
+    // 桶数组，桶的个数为 2 的幂
+    struct table {
+        size_type mask;
+        std::atomic<node*>* buckets;
+    };
+
+    // 等待回收的节点或桶数组
+    struct retired {
+        uint64_t epoch;
+        void* ptr;
+        void (*release)(void*);
+    };
+
+    // 读者只读取 table_，写者使用的锁与计数放在另一条缓存行上
+    struct shard {
+        alignas(kCacheLine) std::atomic<table*> table_{nullptr};
+        alignas(kCacheLine) std::mutex mutex;
+        std::atomic<size_type> size{0};
+        mystl::vector<retired> retired_;
+    };
+
+    using node_allocator = mystl::allocator<node>;
+    using bucket_allocator = mystl::allocator<std::atomic<node*>>;
+    using table_allocator = mystl::allocator<table>;
+
+    static constexpr size_type kMinBuckets = 8;
+    // 每个分片积累这么多待回收的对象后尝试推进纪元并回收
+    static constexpr size_type kReclaimBatch = 64;
+
+    shard* shards_ = nullptr;
+    size_type shard_mask_ = 0;
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] KeyEqual equal_;
+
+public:
+    // 分片个数向上取整为 2 的幂
+    explicit concurrent_hash_map(size_type shard_count = kDefaultShards,
+                                 const Hash& hash = Hash(),
+                                 const KeyEqual& equal = KeyEqual())
+        : hash_(hash), equal_(equal) {
+        size_type n = 1;
+        while (n < shard_count) {
+            n <<= 1;
+        }
+        // 分片按缓存行对齐，使用带对齐的 new
+        shards_ = new shard[n];
+        shard_mask_ = n - 1;
+        try {
+            for (size_type i = 0; i < n; ++i) {
+                shards_[i].table_.store(create_table(kMinBuckets),
+                                        std::memory_order_relaxed);
+            }
+        } catch (...) {
+            destroy_shards();
+            throw;
+        }
+    }
+
+    concurrent_hash_map(const concurrent_hash_map&) = delete;
+    concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+    // 析构时不能有其他线程访问
+    ~concurrent_hash_map() { destroy_shards(); }
+
+public:
+    // 容量相关操作，并发修改时只是一个近似值
+    size_type size() const noexcept {
+        size_type n = 0;
+        for (size_type i = 0; i <= shard_mask_; ++i) {
+            n += shards_[i].size.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    size_type shard_count() const noexcept { return shard_mask_ + 1; }
+
+    // 查找相关操作，不加锁
+    // 找到时以 const mapped_type& 调用 fn，引用只在回调期间有效
+    template <typename Fn>
+    bool visit(const key_type& key, Fn&& fn) const {
+        const size_t h = hash_of(key);
+        epoch_guard guard;
+        const node* n = find_node(shard_of(h), key, h);
+        if (n == nullptr) {
+            return false;
+        }
+        fn(n->value.second);
+        return true;
+    }
+
+    std::optional<mapped_type> find(const key_type& key) const {
+        std::optional<mapped_type> result;
+        visit(key, [&](const mapped_type& value) { result.emplace(value); });
+        return result;
+    }
+
+    bool contains(const key_type& key) const {
+        const size_t h = hash_of(key);
+        epoch_guard guard;
+        return find_node(shard_of(h), key, h) != nullptr;
+    }
+
+    size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // 以 const value_type& 依次调用 fn；与写操作并发时，遍历期间插入或删除的
+    // 元素可能看到也可能看不到
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        epoch_guard guard;
+        for (size_type i = 0; i <= shard_mask_; ++i) {
+            const table* t = shards_[i].table_.load(std::memory_order_acquire);
+            for (size_type b = 0; b <= t->mask; ++b) {
+                for (const node* n =
+                         t->buckets[b].load(std::memory_order_acquire);
+                     n != nullptr;
+                     n = n->next.load(std::memory_order_acquire)) {
+                    fn(static_cast<const value_type&>(n->value));
+                }
+            }
+        }
+    }
+
+    // 修改容器相关操作，只锁住键所在的分片
+    // 键已经存在时不插入，返回 false
+    template <typename M>
+    bool insert(const key_type& key, M&& value) {
+        const size_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        table* t = s.table_.load(std::memory_order_relaxed);
+        if (find_link(t, key, h) != nullptr) {
+            return false;
+        }
+        insert_new(s, t, create_node(h, key, mystl::forward<M>(value)));
+        return true;
+    }
+
+    // 键已经存在时用新节点替换旧节点，返回是否插入了新的键
+    template <typename M>
+    bool insert_or_assign(const key_type& key, M&& value) {
+        const size_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        table* t = s.table_.load(std::memory_order_relaxed);
+        reserve_retired(s);
+        node* n = create_node(h, key, mystl::forward<M>(value));
+        std::atomic<node*>* link = find_link(t, key, h);
+        if (link == nullptr) {
+            insert_new(s, t, n);
+            return true;
+        }
+        node* old = link->load(std::memory_order_relaxed);
+        n->next.store(old->next.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+        link->store(n, std::memory_order_release);
+        retire(s, old, &free_node);
+        return false;
+    }
+
+    // 返回是否删除了元素
+    bool erase(const key_type& key) {
+        const size_t h = hash_of(key);
+        shard& s = shard_of(h);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        std::atomic<node*>* link =
+            find_link(s.table_.load(std::memory_order_relaxed), key, h);
+        if (link == nullptr) {
+            return false;
+        }
+        reserve_retired(s);
+        node* old = link->load(std::memory_order_relaxed);
+        link->store(old->next.load(std::memory_order_relaxed),
+                    std::memory_order_release);
+        s.size.fetch_sub(1, std::memory_order_relaxed);
+        retire(s, old, &free_node);
+        return true;
+    }
+
+    // 逐个分片换上空的桶数组
+    void clear() {
+        for (size_type i = 0; i <= shard_mask_; ++i) {
+            shard& s = shards_[i];
+            table* empty = create_table(kMinBuckets);
+            std::lock_guard<std::mutex> lock(s.mutex);
+            try {
+                reserve_retired(s);
+            } catch (...) {
+                free_table(empty);
+                throw;
+            }
+            table* old = s.table_.load(std::memory_order_relaxed);
+            s.table_.store(empty, std::memory_order_release);
+            s.size.store(0, std::memory_order_relaxed);
+            retire(s, old, &free_table);
+        }
+    }
+
+private:
+    size_t hash_of(const key_type& key) const {
+        return hash_detail::mix(hash_(key));
+    }
+
+    // 低位决定桶，高 32 位决定分片
+    shard& shard_of(size_t h) const {
+        return shards_[(h >> 32) & shard_mask_];
+    }
+
+    const node* find_node(const shard& s, const key_type& key,
+                          size_t h) const {
+        const table* t = s.table_.load(std::memory_order_acquire);
+        for (const node* n =
+                 t->buckets[h & t->mask].load(std::memory_order_acquire);
+             n != nullptr; n = n->next.load(std::memory_order_acquire)) {
+            if (n->hash == h && equal_(n->value.first, key)) {
+                return n;
+            }
+        }
+        return nullptr;
+    }
+
+    // 持有分片的锁时调用，返回指向目标节点的链接 (桶或前驱节点的 next)
+    std::atomic<node*>* find_link(table* t, const key_type& key, size_t h) {
+        std::atomic<node*>* link = &t->buckets[h & t->mask];
+        for (node* n = link->load(std::memory_order_relaxed); n != nullptr;
+             n = n->next.load(std::memory_order_relaxed)) {
+            if (n->hash == h && equal_(n->value.first, key)) {
+                return link;
+            }
+            link = &n->next;
+        }
+        return nullptr;
+    }
+
+    // 把新节点插入桶的头部，元素个数超过桶数时先扩容
+    void insert_new(shard& s, table* t, node* n) {
+        const size_type size = s.size.load(std::memory_order_relaxed);
+        if (size > t->mask) {
+            try {
+                t = grow(s, t);
+            } catch (...) {
+                free_node(n);
+                throw;
+            }
+        }
+        link_front(t, n);
+        s.size.store(size + 1, std::memory_order_relaxed);
+    }
+
+    static void link_front(table* t, node* n) {
+        std::atomic<node*>& bucket = t->buckets[n->hash & t->mask];
+        n->next.store(bucket.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+        bucket.store(n, std::memory_order_release);
+    }
+
+    // 桶数翻倍：复制全部节点到新的桶数组后再发布，
+    // 仍在旧桶数组上查找的读者看到的链表保持不变
+    table* grow(shard& s, table* old) {
+        table* t = create_table((old->mask + 1) * 2);
+        try {
+            for (size_type b = 0; b <= old->mask; ++b) {
+                for (node* n = old->buckets[b].load(std::memory_order_relaxed);
+                     n != nullptr;
+                     n = n->next.load(std::memory_order_relaxed)) {
+                    link_front(t, create_node(n->hash, n->value));
+                }
+            }
+            reserve_retired(s);
+        } catch (...) {
+            free_table(t);
+            throw;
+        }
+        s.table_.store(t, std::memory_order_release);
+        retire(s, old, &free_table);
+        return t;
+    }
+
+    // 在摘下对象之前调用，保证随后的 retire 不需要分配内存，
+    // 否则分配失败时已经摘下的对象既不可达也不会被释放
+    static void reserve_retired(shard& s) {
+        const size_type cap = s.retired_.capacity();
+        if (s.retired_.size() == cap) {
+            s.retired_.reserve(cap == 0 ? kReclaimBatch : cap * 2);
+        }
+    }
+
+    // 记下退休纪元，积累够一批后推进纪元并释放已经没有读者的对象
+    // 调用者已经通过 reserve_retired 预留了位置，这里不会抛出异常
+    static void retire(shard& s, void* ptr, void (*release)(void*)) {
+        epoch_domain& domain = epoch_domain::global();
+        s.retired_.push_back(retired{domain.retire_epoch(), ptr, release});
+        if (s.retired_.size() < kReclaimBatch) {
+            return;
+        }
+        const uint64_t now = domain.try_advance();
+        size_type n = 0;
+        while (n < s.retired_.size() &&
+               epoch_domain::reclaimable(s.retired_[n].epoch, now)) {
+            s.retired_[n].release(s.retired_[n].ptr);
+            ++n;
+        }
+        s.retired_.erase(s.retired_.begin(), s.retired_.begin() + n);
+    }
+
+    template <typename... Args>
+    static node* create_node(size_t h, Args&&... args) {
+        node* n = node_allocator::allocate();
+        try {
+            mystl::construct(n, h, mystl::forward<Args>(args)...);
+        } catch (...) {
+            node_allocator::deallocate(n);
+            throw;
+        }
+        return n;
+    }
+
+    static void free_node(void* p) {
+        node* n = static_cast<node*>(p);
+        mystl::destory(n);
+        node_allocator::deallocate(n);
+    }
+
+    static table* create_table(size_type buckets) {
+        std::atomic<node*>* b = bucket_allocator::allocate(buckets);
+        for (size_type i = 0; i < buckets; ++i) {
+            mystl::construct(b + i, nullptr);
+        }
+        table* t = table_allocator::allocate();
+        mystl::construct(t, table{buckets - 1, b});
+        return t;
+    }
+
+    // 释放桶数组以及仍然挂在上面的节点
+    static void free_table(void* p) {
+        table* t = static_cast<table*>(p);
+        for (size_type b = 0; b <= t->mask; ++b) {
+            node* n = t->buckets[b].load(std::memory_order_relaxed);
+            while (n != nullptr) {
+                node* next = n->next.load(std::memory_order_relaxed);
+                free_node(n);
+                n = next;
+            }
+        }
+        mystl::destory(t->buckets, t->buckets + t->mask + 1);
+        bucket_allocator::deallocate(t->buckets, t->mask + 1);
+        mystl::destory(t);
+        table_allocator::deallocate(t);
+    }
+
+    void destroy_shards() {
+        for (size_type i = 0; i <= shard_mask_; ++i) {
+            shard& s = shards_[i];
+            for (const retired& r : s.retired_) {
+                r.release(r.ptr);
+            }
+            table* t = s.table_.load(std::memory_order_relaxed);
+            if (t != nullptr) {
+                free_table(t);
+            }
+        }
+        delete[] shards_;
+        shards_ = nullptr;
+    }
+};
+
+}  // namespace mystl
@@ -1,9 +1,14 @@
 #pragma once
 
-// 这个头文件包含两个函数 construct，destroy
+// 这个头文件包含三个函数 construct，destroy，relocate
 // construct : 负责对象的构造
 // destroy   : 负责对象的析构
+// relocate  : 负责把对象搬到新的未初始化空间，并结束旧对象的生命周期
+// 三者都可以在常量求值中使用：编译期通过 std::construct_at 构造对象，
+// relocate 不使用 memcpy 而是逐个移动
 
+#include <cstring>
+#include <memory>
 #include <new>
 #include <type_traits>
 
@@ -20,53 +25,107 @@ namespace mystl {
 
 // construct 构造对象
 
+// 常量求值中不能使用 placement new，改用 std::construct_at
+
 template <typename Ty>
-void construct(Ty* ptr) {
-    ::new ((void)*ptr) Ty{};
+constexpr void construct(Ty* ptr) {
+    if (std::is_constant_evaluated()) {
+        std::construct_at(ptr);
+    } else {
+        ::new ((void*)ptr) Ty{};
+    }
 }
 
 template <typename Ty1, typename Ty2>
-void construct(Ty1* ptr, const Ty2& value) {
-    ::new ((void*)ptr) Ty1{value};
+constexpr void construct(Ty1* ptr, const Ty2& value) {
+    if (std::is_constant_evaluated()) {
+        std::construct_at(ptr, value);
+    } else {
+        ::new ((void*)ptr) Ty1{value};
+    }
 }
 
 template <typename Ty, typename... Args>
-void construct(Ty* ptr, Args&&... args) {
-    ::new ((void*)ptr) Ty(mystl::forward<Args>(args)...);
+constexpr void construct(Ty* ptr, Args&&... args) {
+    if (std::is_constant_evaluated()) {
+        std::construct_at(ptr, mystl::forward<Args>(args)...);
+    } else {
+        ::new ((void*)ptr) Ty(mystl::forward<Args>(args)...);
+    }
 }
 
 // destroy 将对象析构
 
 template <typename Ty>
-void destroy_one(Ty*, std::true_type) {}
+constexpr void destory_one(Ty*, std::true_type) {}
 
 template <typename Ty>
-void destory_one(Ty* pointer, std::false_type) {
+constexpr void destory_one(Ty* pointer, std::false_type) {
     if (pointer != nullptr) {
         pointer->~Ty();
     }
 }
 
+template <typename Ty>
+constexpr void destory(Ty* pointer) {
+    destory_one(pointer, std::is_trivially_destructible<Ty>{});
+}
+
 template <typename ForwardIter>
-void destory_cat(ForwardIter, ForwardIter, std::true_type){};
+constexpr void destory_cat(ForwardIter, ForwardIter, std::true_type){};
 
 template <typename ForwardIter>
-void destory_cat(ForwardIter first, ForwardIter last, std::false_type) {
+constexpr void destory_cat(ForwardIter first, ForwardIter last,
+                           std::false_type) {
     for (; first != last; ++first) {
-        destory(&*first);
+        mystl::destory(&*first);
     }
 }
 
-template <typename Ty>
-void destory(Ty* pointer) {
-    destory_one(pointer, std::is_trivially_destructible<Ty>{});
+// 连续迭代器换成原生指针再逐个析构，循环中不再经过迭代器的运算符
+template <typename ForwardIter>
+constexpr void destory(ForwardIter first, ForwardIter last) {
+    using value_type = typename iterator_traits<ForwardIter>::value_type;
+    if constexpr (is_contiguous_iterator_v<ForwardIter> &&
+                  !std::is_pointer_v<ForwardIter>) {
+        if (first != last) {
+            mystl::destory(mystl::to_address(first), mystl::to_address(last));
+        }
+    } else {
+        destory_cat(first, last,
+                    std::is_trivially_destructible<value_type>{});
+    }
 }
 
-template <typename ForwardIter>
-void destory(ForwardIter first, ForwardIter last) {
-    destory_cat(first, last,
-                std::is_trivially_destructible<
-                    typename iterator_traits<ForwardIter>::value_type>{});
+// relocate 将 [first, last) 上的对象搬到以 result 为起始处的未初始化空间
+// 返回搬运结束的位置，结束后 [first, last) 变为未初始化的空间
+// 两段空间不能重叠。可平凡重定位的类型在运行时退化为一次 memcpy，
+// 既不调用移动构造也不调用析构；其余类型先逐个移动构造，全部成功后再析构源对象，
+// 移动构造抛出异常时析构已构造的目标对象，源对象保持存活
+
+template <typename Ty>
+constexpr Ty* relocate(Ty* first, Ty* last, Ty* result) {
+    if constexpr (is_trivially_relocatable_v<Ty>) {
+        if (!std::is_constant_evaluated()) {
+            const auto n = static_cast<size_t>(last - first);
+            if (n != 0) {
+                std::memcpy(static_cast<void*>(result),
+                            static_cast<const void*>(first), n * sizeof(Ty));
+            }
+            return result + n;
+        }
+    }
+    Ty* cur = result;
+    try {
+        for (Ty* p = first; p != last; ++p, ++cur) {
+            mystl::construct(cur, mystl::move(*p));
+        }
+    } catch (...) {
+        mystl::destory(result, cur);
+        throw;
+    }
+    mystl::destory(first, last);
+    return cur;
 }
 
 #ifdef _MSC_VER
@@ -0,0 +1,742 @@
+#pragma once
+
+// 这个头文件包含一个模板类 deque
+// deque : 双端队列，元素存放在固定大小的缓冲区中，由一个中控器 (map) 记录各缓冲区的地址
+// 在两端插入或删除元素不会使其他元素的引用失效
+// 释放的缓冲区先放进备用缓冲区中，下次需要缓冲区时直接取用；
+// 中控器两端用完时若总空间足够，就把已用部分移回中间而不重新分配。
+// 因此把 deque 当作先进先出队列使用时，稳定状态下不会再分配任何内存
+
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 每个缓冲区容纳的元素个数
+template <typename T>
+struct deque_buf_size {
+    static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+};
+
+// deque 的迭代器设计
+template <typename T, bool Const>
+struct deque_iterator : public iterator<random_access_iterator_tag, T> {
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using value_pointer = T*;
+    using map_pointer = T**;
+
+    using self = deque_iterator<T, Const>;
+
+    static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+    value_pointer cur = nullptr;    // 指向所在缓冲区的当前元素
+    value_pointer first = nullptr;  // 指向所在缓冲区的头部
+    value_pointer last = nullptr;   // 指向所在缓冲区的尾部
+    map_pointer node = nullptr;     // 缓冲区所在节点
+
+    // 构造、复制、移动函数
+    deque_iterator() = default;
+
+    deque_iterator(value_pointer v, map_pointer n)
+        : cur(v), first(*n), last(*n + buffer_size), node(n) {}
+
+    // 允许 iterator 隐式转换为 const_iterator
+    template <bool C = Const>
+    requires C
+    deque_iterator(const deque_iterator<T, false>& rhs)
+        : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
+
+    // 转到另一个缓冲区
+    void set_node(map_pointer new_node) {
+        node = new_node;
+        first = *new_node;
+        last = first + buffer_size;
+    }
+
+    // 重载运算符
+    reference operator*() const { return *cur; }
+    pointer operator->() const { return cur; }
+
+    difference_type operator-(const self& x) const {
+        if (node == x.node) {
+            return cur - x.cur;
+        }
+        return static_cast<difference_type>(buffer_size) *
+                   (node - x.node - 1) +
+               (cur - first) + (x.last - x.cur);
+    }
+
+    self& operator++() {
+        ++cur;
+        if (cur == last) {  // 如果到达缓冲区的尾
+            set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        if (cur == first) {  // 如果到达缓冲区的头
+            set_node(node - 1);
+            cur = last;
+        }
+        --cur;
+        return *this;
+    }
+
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        const auto offset = n + (cur - first);
+        const auto bs = static_cast<difference_type>(buffer_size);
+        if (offset >= 0 && offset < bs) {  // 仍在当前缓冲区
+            cur += n;
+        } else {  // 要跳到其他的缓冲区
+            const auto node_offset =
+                offset > 0 ? offset / bs : -((-offset - 1) / bs) - 1;
+            set_node(node + node_offset);
+            cur = first + (offset - node_offset * bs);
+        }
+        return *this;
+    }
+
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) { return *this += -n; }
+
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return cur == rhs.cur; }
+    bool operator!=(const self& rhs) const { return cur != rhs.cur; }
+    bool operator<(const self& rhs) const {
+        return node == rhs.node ? (cur < rhs.cur) : (node < rhs.node);
+    }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+// 模板类 deque
+// 模板参数代表数据类型和空间配置器
+template <typename T, typename Alloc = mystl::allocator<T>>
+class deque {
+public:
+    using allocator_type = Alloc;
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = deque_iterator<T, false>;
+    using const_iterator = deque_iterator<T, true>;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+    // 最多缓存的空闲缓冲区个数
+    static constexpr size_type kMaxSpareBlocks = 4;
+
+private:
+    using map_pointer = T**;
+    using map_allocator = typename Alloc::template rebind<T*>::other;
+
+    static constexpr size_type kInitMapSize = 8;
+
+    iterator begin_;  // 指向第一个元素
+    iterator end_;    // 指向最后一个元素的下一个位置
+    map_pointer map_ = nullptr;  // map 中的每个元素都指向一个缓冲区
+    size_type map_size_ = 0;     // map 内指针的数目
+    T* spare_[kMaxSpareBlocks] = {};  // 备用缓冲区
+    size_type spare_count_ = 0;
+    [[no_unique_address]] Alloc alloc_;
+
+public:
+    // 构造、复制、移动、析构函数
+    deque() = default;
+
+    explicit deque(const Alloc& alloc) : alloc_(alloc) {}
+
+    explicit deque(size_type n) { resize(n); }
+
+    deque(size_type n, const value_type& value) {
+        for (; n > 0; --n) {
+            emplace_back(value);
+        }
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    deque(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    deque(std::initializer_list<value_type> ilist)
+        : deque(ilist.begin(), ilist.end()) {}
+
+    deque(const deque& rhs) : alloc_(rhs.alloc_) {
+        for (const auto& value : rhs) {
+            emplace_back(value);
+        }
+    }
+
+    deque(deque&& rhs) noexcept
+        : begin_(rhs.begin_),
+          end_(rhs.end_),
+          map_(rhs.map_),
+          map_size_(rhs.map_size_),
+          spare_count_(rhs.spare_count_),
+          alloc_(mystl::move(rhs.alloc_)) {
+        for (size_type i = 0; i < spare_count_; ++i) {
+            spare_[i] = rhs.spare_[i];
+        }
+        rhs.begin_ = rhs.end_ = iterator();
+        rhs.map_ = nullptr;
+        rhs.map_size_ = 0;
+        rhs.spare_count_ = 0;
+    }
+
+    deque& operator=(const deque& rhs) {
+        if (this != &rhs) {
+            deque tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    deque& operator=(deque&& rhs) noexcept {
+        if (this != &rhs) {
+            deque tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    deque& operator=(std::initializer_list<value_type> ilist) {
+        deque tmp(ilist);
+        swap(tmp);
+        return *this;
+    }
+
+    ~deque() {
+        if (map_ == nullptr) {
+            return;
+        }
+        clear();
+        alloc_.deallocate(begin_.first, buffer_size);
+        release_spare_blocks();
+        map_allocator(alloc_).deallocate(map_, map_size_);
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return begin_; }
+    const_iterator begin() const noexcept { return begin_; }
+    iterator end() noexcept { return end_; }
+    const_iterator end() const noexcept { return end_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return begin_ == end_; }
+    size_type size() const noexcept {
+        return static_cast<size_type>(end_ - begin_);
+    }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+    // 归还备用缓冲区
+    void shrink_to_fit() noexcept { release_spare_blocks(); }
+
+    // 访问元素相关操作
+    reference operator[](size_type n) { return begin_[n]; }
+    const_reference operator[](size_type n) const { return begin_[n]; }
+
+    reference at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("deque<T>::at() subscript out of range");
+        }
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("deque<T>::at() subscript out of range");
+        }
+        return (*this)[n];
+    }
+
+    reference front() { return *begin_; }
+    const_reference front() const { return *begin_; }
+    reference back() { return *(end_ - 1); }
+    const_reference back() const { return *(end_ - 1); }
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    // 修改容器相关操作
+
+    // emplace_front / emplace_back / emplace
+    template <typename... Args>
+    reference emplace_front(Args&&... args) {
+        if (map_ == nullptr) {
+            create_map();
+        }
+        if (begin_.cur != begin_.first) {
+            alloc_.construct(begin_.cur - 1, mystl::forward<Args>(args)...);
+            --begin_.cur;
+            return *begin_;
+        }
+        reserve_map_at_front(1);
+        *(begin_.node - 1) = allocate_block();
+        try {
+            alloc_.construct(*(begin_.node - 1) + buffer_size - 1,
+                             mystl::forward<Args>(args)...);
+        } catch (...) {
+            free_block(*(begin_.node - 1));
+            throw;
+        }
+        begin_.set_node(begin_.node - 1);
+        begin_.cur = begin_.last - 1;
+        return *begin_;
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (map_ == nullptr) {
+            create_map();
+        }
+        if (end_.cur != end_.last - 1) {
+            alloc_.construct(end_.cur, mystl::forward<Args>(args)...);
+            ++end_.cur;
+            return back();
+        }
+        // 最后一个位置构造完成后 end_ 要移到下一个缓冲区
+        reserve_map_at_back(1);
+        *(end_.node + 1) = allocate_block();
+        try {
+            alloc_.construct(end_.cur, mystl::forward<Args>(args)...);
+        } catch (...) {
+            free_block(*(end_.node + 1));
+            throw;
+        }
+        end_.set_node(end_.node + 1);
+        end_.cur = end_.first;
+        return back();
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const auto idx = static_cast<size_type>(pos - begin_);
+        if (idx == 0) {
+            emplace_front(mystl::forward<Args>(args)...);
+            return begin_;
+        }
+        if (idx == size()) {
+            emplace_back(mystl::forward<Args>(args)...);
+            return end_ - 1;
+        }
+        // 参数可能引用容器内的元素，先构造出临时对象
+        value_type tmp(mystl::forward<Args>(args)...);
+        if (idx < size() / 2) {
+            // 前半段整体前移一位
+            emplace_front(mystl::move(front()));
+            for (size_type i = 1; i < idx; ++i) {
+                begin_[i] = mystl::move(begin_[i + 1]);
+            }
+        } else {
+            // 后半段整体后移一位
+            emplace_back(mystl::move(back()));
+            for (size_type i = size() - 2; i > idx; --i) {
+                begin_[i] = mystl::move(begin_[i - 1]);
+            }
+        }
+        begin_[idx] = mystl::move(tmp);
+        return begin_ + idx;
+    }
+
+    // push_front / push_back
+    void push_front(const value_type& value) { emplace_front(value); }
+    void push_front(value_type&& value) { emplace_front(mystl::move(value)); }
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+    // pop_back / pop_front
+    void pop_front() {
+        alloc_.destory(begin_.cur);
+        if (begin_.cur != begin_.last - 1) {
+            ++begin_.cur;
+            return;
+        }
+        free_block(begin_.first);
+        begin_.set_node(begin_.node + 1);
+        begin_.cur = begin_.first;
+    }
+
+    void pop_back() {
+        if (end_.cur != end_.first) {
+            --end_.cur;
+            alloc_.destory(end_.cur);
+            return;
+        }
+        free_block(end_.first);
+        end_.set_node(end_.node - 1);
+        end_.cur = end_.last - 1;
+        alloc_.destory(end_.cur);
+    }
+
+    // insert
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        value_type tmp(value);
+        const auto idx = static_cast<size_type>(pos - begin_);
+        return insert_range_at(idx, [&](auto&& put) {
+            for (size_type i = 0; i < n; ++i) {
+                put(tmp);
+            }
+        });
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        const auto idx = static_cast<size_type>(pos - begin_);
+        return insert_range_at(idx, [&](auto&& put) {
+            for (; first != last; ++first) {
+                put(*first);
+            }
+        });
+    }
+
+    iterator insert(const_iterator pos,
+                    std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    // erase / clear
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto idx = static_cast<size_type>(first - begin_);
+        const auto n = static_cast<size_type>(last - first);
+        if (n == 0) {
+            return begin_ + idx;
+        }
+        if (idx < (size() - n) / 2) {
+            // 前面的元素较少，把它们后移后从头部删除
+            for (size_type i = idx; i > 0; --i) {
+                begin_[i - 1 + n] = mystl::move(begin_[i - 1]);
+            }
+            for (size_type i = 0; i < n; ++i) {
+                pop_front();
+            }
+        } else {
+            // 后面的元素较少，把它们前移后从尾部删除
+            const size_type old_size = size();
+            for (size_type i = idx + n; i < old_size; ++i) {
+                begin_[i - n] = mystl::move(begin_[i]);
+            }
+            for (size_type i = 0; i < n; ++i) {
+                pop_back();
+            }
+        }
+        return begin_ + idx;
+    }
+
+    // 析构所有元素，只保留头部所在的缓冲区，其余缓冲区放入备用缓冲区
+    void clear() noexcept {
+        if (map_ == nullptr) {
+            return;
+        }
+        for (map_pointer node = begin_.node + 1; node < end_.node; ++node) {
+            mystl::destory(*node, *node + buffer_size);
+            free_block(*node);
+        }
+        if (begin_.node != end_.node) {
+            mystl::destory(begin_.cur, begin_.last);
+            mystl::destory(end_.first, end_.cur);
+            free_block(end_.first);
+        } else {
+            mystl::destory(begin_.cur, end_.cur);
+        }
+        end_ = begin_;
+    }
+
+    // resize
+    void resize(size_type new_size) {
+        const size_type len = size();
+        if (new_size < len) {
+            erase(begin_ + new_size, end_);
+        } else {
+            for (size_type i = len; i < new_size; ++i) {
+                emplace_back();
+            }
+        }
+    }
+
+    void resize(size_type new_size, const value_type& value) {
+        const size_type len = size();
+        if (new_size < len) {
+            erase(begin_ + new_size, end_);
+        } else {
+            insert(end_, new_size - len, value);
+        }
+    }
+
+    void swap(deque& rhs) noexcept {
+        if (this == &rhs) {
+            return;
+        }
+        mystl::swap(begin_, rhs.begin_);
+        mystl::swap(end_, rhs.end_);
+        mystl::swap(map_, rhs.map_);
+        mystl::swap(map_size_, rhs.map_size_);
+        mystl::swap(spare_, rhs.spare_);
+        mystl::swap(spare_count_, rhs.spare_count_);
+        mystl::swap(alloc_, rhs.alloc_);
+    }
+
+private:
+    // 缓冲区的分配与回收
+    T* allocate_block() {
+        if (spare_count_ > 0) {
+            return spare_[--spare_count_];
+        }
+        return alloc_.allocate(buffer_size);
+    }
+
+    void free_block(T* block) noexcept {
+        if (spare_count_ < kMaxSpareBlocks) {
+            spare_[spare_count_++] = block;
+        } else {
+            alloc_.deallocate(block, buffer_size);
+        }
+    }
+
+    void release_spare_blocks() noexcept {
+        for (; spare_count_ > 0; --spare_count_) {
+            alloc_.deallocate(spare_[spare_count_ - 1], buffer_size);
+        }
+    }
+
+    // 创建 map 和一个位于中间的缓冲区
+    void create_map() {
+        map_ = map_allocator(alloc_).allocate(kInitMapSize);
+        map_size_ = kInitMapSize;
+        map_pointer node = map_ + kInitMapSize / 2;
+        try {
+            *node = allocate_block();
+        } catch (...) {
+            map_allocator(alloc_).deallocate(map_, map_size_);
+            map_ = nullptr;
+            map_size_ = 0;
+            throw;
+        }
+        begin_.set_node(node);
+        end_.set_node(node);
+        begin_.cur = end_.cur = begin_.first + buffer_size / 2;
+    }
+
+    void reserve_map_at_back(size_type nodes_to_add) {
+        if (nodes_to_add + 1 >
+            map_size_ - static_cast<size_type>(end_.node - map_)) {
+            reallocate_map(nodes_to_add, false);
+        }
+    }
+
+    void reserve_map_at_front(size_type nodes_to_add) {
+        if (nodes_to_add > static_cast<size_type>(begin_.node - map_)) {
+            reallocate_map(nodes_to_add, true);
+        }
+    }
+
+    // map 一端的空间不足时调用
+    // map 总空间足够时把已用节点移到中间，否则分配一个更大的 map
+    void reallocate_map(size_type nodes_to_add, bool add_at_front) {
+        const auto old_num_nodes =
+            static_cast<size_type>(end_.node - begin_.node) + 1;
+        const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+
+        map_pointer new_start;
+        if (map_size_ > 2 * new_num_nodes) {
+            new_start = map_ + (map_size_ - new_num_nodes) / 2 +
+                        (add_at_front ? nodes_to_add : 0);
+            std::memmove(new_start, begin_.node,
+                         old_num_nodes * sizeof(map_pointer));
+        } else {
+            const size_type new_map_size =
+                map_size_ + (map_size_ > nodes_to_add ? map_size_
+                                                      : nodes_to_add) +
+                2;
+            map_pointer new_map =
+                map_allocator(alloc_).allocate(new_map_size);
+            new_start = new_map + (new_map_size - new_num_nodes) / 2 +
+                        (add_at_front ? nodes_to_add : 0);
+            std::memcpy(new_start, begin_.node,
+                        old_num_nodes * sizeof(map_pointer));
+            map_allocator(alloc_).deallocate(map_, map_size_);
+            map_ = new_map;
+            map_size_ = new_map_size;
+        }
+        begin_.set_node(new_start);
+        end_.set_node(new_start + old_num_nodes - 1);
+    }
+
+    // 把 [first, last) 反转
+    static void reverse(iterator first, iterator last) {
+        while (first != last && first != --last) {
+            mystl::swap(*first, *last);
+            ++first;
+        }
+    }
+
+    // 把 [middle, last) 旋转到 first 处
+    static void rotate(iterator first, iterator middle, iterator last) {
+        reverse(first, middle);
+        reverse(middle, last);
+        reverse(first, last);
+    }
+
+    // 在第 idx 个位置插入 produce 产生的元素
+    // 靠近尾部时先追加到尾部再旋转到位，靠近头部时先插入到头部再旋转到位
+    // produce 以回调 put(value) 的方式逐个给出元素
+    template <typename Produce>
+    iterator insert_range_at(size_type idx, Produce&& produce) {
+        const size_type old_size = size();
+        size_type added = 0;
+        if (idx >= old_size / 2) {
+            try {
+                produce([&](auto&& value) {
+                    emplace_back(mystl::forward<decltype(value)>(value));
+                    ++added;
+                });
+            } catch (...) {
+                for (; added > 0; --added) {
+                    pop_back();
+                }
+                throw;
+            }
+            rotate(begin_ + idx, begin_ + old_size, end_);
+        } else {
+            try {
+                produce([&](auto&& value) {
+                    emplace_front(mystl::forward<decltype(value)>(value));
+                    ++added;
+                });
+            } catch (...) {
+                for (; added > 0; --added) {
+                    pop_front();
+                }
+                throw;
+            }
+            // 插入到头部的元素是逆序的
+            reverse(begin_, begin_ + added);
+            rotate(begin_, begin_ + added, begin_ + added + idx);
+        }
+        return begin_ + idx;
+    }
+};
+
+// 重载比较操作符
+template <typename T, typename Alloc>
+bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (auto i = lhs.begin(), j = rhs.begin(); i != lhs.end(); ++i, ++j) {
+        if (!(*i == *j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename Alloc>
+bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    auto i = lhs.begin();
+    auto j = rhs.begin();
+    for (; i != lhs.end() && j != rhs.end(); ++i, ++j) {
+        if (*i < *j) {
+            return true;
+        }
+        if (*j < *i) {
+            return false;
+        }
+    }
+    return i == lhs.end() && j != rhs.end();
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename Alloc>
+bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, typename Alloc>
+void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
@@ -0,0 +1,160 @@
+#pragma once
+
+// 这个头文件包含基于纪元的内存回收 (epoch-based reclamation)
+// epoch_domain : 全局纪元与各线程的纪元记录
+// epoch_guard  : 读者访问无锁结构期间持有，期间读到的节点不会被释放
+// 写者把节点从结构中摘下后记下当时的全局纪元 e，延后释放；全局纪元只在所有
+// 活跃的读者都已观察到当前纪元时前进，因此全局纪元到达 e + 2 时已经没有读者
+// 可能持有该节点，可以安全释放
+// 读者进入临界区只需一次原子交换，离开只需一次存储，
+// 既不等待写者也不会阻塞写者；推进纪元与释放节点由写者完成
+
+#include <atomic>
+#include <cstdint>
+
+namespace mystl {
+
+class epoch_guard;
+
+// 进程内唯一的纪元域，通过 global() 访问
+class epoch_domain {
+    friend class epoch_guard;
+
+public:
+    static constexpr uint64_t kInactive = UINT64_MAX;
+
+private:
+    // 每个线程一个记录，线程退出后归还给后来的线程复用，记录本身从不释放
+    struct alignas(64) record {
+        std::atomic<uint64_t> epoch{kInactive};
+        std::atomic<bool> in_use{true};
+        record* next = nullptr;
+        uint32_t depth = 0;  // 嵌套的 epoch_guard 层数，只由拥有者线程访问
+    };
+
+    struct record_owner {
+        record* rec = nullptr;
+
+        ~record_owner() {
+            if (rec != nullptr) {
+                rec->epoch.store(kInactive, std::memory_order_release);
+                rec->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    alignas(64) std::atomic<uint64_t> epoch_{0};
+    alignas(64) std::atomic<record*> records_{nullptr};
+
+    epoch_domain() = default;
+
+public:
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    static epoch_domain& global() {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    uint64_t current() const {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    // 写者摘下节点之后调用，返回节点的退休纪元
+    uint64_t retire_epoch() const {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_relaxed);
+    }
+
+    // 所有活跃读者都已观察到当前纪元时把全局纪元加一，返回此后的全局纪元
+    // 读取读者记录与纪元都使用 acquire，读者离开前的读取因此先于
+    // 依据返回值进行的释放
+    uint64_t try_advance() {
+        const uint64_t global = epoch_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (record* r = records_.load(std::memory_order_acquire);
+             r != nullptr; r = r->next) {
+            const uint64_t e = r->epoch.load(std::memory_order_acquire);
+            if (e != kInactive && e != global) {
+                return global;
+            }
+        }
+        uint64_t expected = global;
+        if (epoch_.compare_exchange_strong(expected, global + 1,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+            return global + 1;
+        }
+        return expected;
+    }
+
+    // 退休纪元为 retired 的节点在全局纪元为 now 时能否释放
+    static constexpr bool reclaimable(uint64_t retired, uint64_t now) {
+        return now >= retired + 2;
+    }
+
+private:
+    record* enter() {
+        record* rec = local();
+        if (rec->depth++ == 0) {
+            // 顺序一致的交换同时充当屏障：之后对共享结构的读取不能提前到
+            // 记录纪元之前；它是读-改-写操作，上一次离开时的 release 存储
+            // 经由它延续到推进纪元的写者
+            rec->epoch.exchange(epoch_.load(std::memory_order_relaxed),
+                                std::memory_order_seq_cst);
+        }
+        return rec;
+    }
+
+    static void leave(record* rec) {
+        if (--rec->depth == 0) {
+            rec->epoch.store(kInactive, std::memory_order_release);
+        }
+    }
+
+    record* local() {
+        thread_local record_owner owner;
+        if (owner.rec == nullptr) {
+            owner.rec = acquire_record();
+        }
+        return owner.rec;
+    }
+
+    // 先尝试复用已退出线程的记录，没有空闲记录时新建一个插入链表头部
+    record* acquire_record() {
+        for (record* r = records_.load(std::memory_order_acquire);
+             r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed) &&
+                r->in_use.compare_exchange_strong(expected, true,
+                                                  std::memory_order_acq_rel)) {
+                return r;
+            }
+        }
+        // 记录按缓存行对齐，使用带对齐的 new
+        record* r = new record;
+        record* head = records_.load(std::memory_order_relaxed);
+        do {
+            r->next = head;
+        } while (!records_.compare_exchange_weak(head, r,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        return r;
+    }
+};
+
+// 读者临界区，可以嵌套
+class epoch_guard {
+private:
+    epoch_domain::record* rec_;
+
+public:
+    epoch_guard() : rec_(epoch_domain::global().enter()) {}
+    ~epoch_guard() { epoch_domain::leave(rec_); }
+
+    epoch_guard(const epoch_guard&) = delete;
+    epoch_guard& operator=(const epoch_guard&) = delete;
+};
+
+}  // namespace mystl
@@ -0,0 +1,454 @@
+#pragma once
+
+// 这个头文件包含执行策略以及算法的并行版本
+// execution::seq       : 顺序执行，直接调用普通版本
+// execution::par       : 在全局线程池上并行执行
+// execution::par_unseq : 与 par 相同，块内调用的普通版本已经使用 SIMD 内核
+// for_each / transform / reduce / sort / copy / fill / find
+// 随机访问迭代器的区间按缓存大小切成若干块，由线程池的工作线程和调用线程一起处理；
+// 其他迭代器或区间只有一块时退化为普通版本
+// 并行执行时某一块抛出异常，等所有块结束后在调用线程重新抛出第一个异常
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "numeric.hpp"
+#include "thread_pool.hpp"
+#include "util.hpp"
+#include "vector.hpp"
+
+namespace mystl {
+
+namespace execution {
+
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+}  // namespace execution
+
+// 判断是否为执行策略
+template <typename T>
+struct is_execution_policy : public m_false_type {};
+
+template <>
+struct is_execution_policy<execution::sequenced_policy> : public m_true_type {
+};
+
+template <>
+struct is_execution_policy<execution::parallel_policy> : public m_true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_unsequenced_policy>
+    : public m_true_type {};
+
+template <typename T>
+inline constexpr bool is_execution_policy_v =
+    is_execution_policy<std::remove_cvref_t<T>>::value;
+
+namespace execution_detail {
+
+// 每块大约占用的字节数，使一块数据能放进 L2 缓存
+inline constexpr size_t kChunkBytes = 64 * 1024;
+// 每块至少包含的元素个数，避免元素较大时块过小
+inline constexpr size_t kMinChunkElems = 1024;
+// 元素个数小于这个值时直接顺序排序
+inline constexpr size_t kParallelSortMin = 1 << 14;
+
+template <typename Iter>
+constexpr size_t chunk_size() noexcept {
+    constexpr size_t n =
+        kChunkBytes / sizeof(typename iterator_traits<Iter>::value_type);
+    return n > kMinChunkElems ? n : kMinChunkElems;
+}
+
+// 执行策略为 par / par_unseq 且所有迭代器都可以随机访问时并行执行
+template <typename Policy, typename... Iters>
+inline constexpr bool is_parallel_v =
+    !std::is_same_v<std::remove_cvref_t<Policy>,
+                    execution::sequenced_policy> &&
+    (is_random_access_iterator<Iters>::value && ...);
+
+// 把 [0, n) 按 chunk 切成若干块，对每块调用 fn(begin, end)
+// 调用线程也参与计算，所有块完成后才返回
+template <typename Fn>
+void parallel_chunks(size_t n, size_t chunk, Fn& fn) {
+    const size_t nchunks = (n + chunk - 1) / chunk;
+    thread_pool& pool = thread_pool::global();
+    if (nchunks <= 1 || pool.size() == 0) {
+        if (n != 0) {
+            fn(size_t(0), n);
+        }
+        return;
+    }
+
+    // 工作线程可能在调用返回后才开始执行，状态由 shared_ptr 保活；
+    // 此时已经没有剩余的块，不会再访问 fn
+    struct state {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+    auto st = std::make_shared<state>();
+    auto work = [st, nchunks, n, chunk, fp = &fn] {
+        for (;;) {
+            const size_t i = st->next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= nchunks) {
+                return;
+            }
+            const size_t begin = i * chunk;
+            const size_t end = n - begin > chunk ? begin + chunk : n;
+            try {
+                (*fp)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(st->mutex);
+                if (!st->error) {
+                    st->error = std::current_exception();
+                }
+            }
+            if (st->done.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+                nchunks) {
+                st->done.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = pool.size() < nchunks - 1 ? pool.size()
+                                                     : nchunks - 1;
+    for (size_t i = 0; i < helpers; ++i) {
+        pool.post(work);
+    }
+    work();
+    for (size_t d = st->done.load(std::memory_order_acquire); d != nchunks;
+         d = st->done.load(std::memory_order_acquire)) {
+        st->done.wait(d, std::memory_order_acquire);
+    }
+    if (st->error) {
+        std::rethrow_exception(st->error);
+    }
+}
+
+// 并行归约：每块用 chunk_fn 求出部分结果，再按块的顺序用 op 合并
+template <typename RandomIter, typename T, typename BinaryOp,
+          typename ChunkFn>
+T parallel_reduce(RandomIter first, RandomIter last, T init, BinaryOp op,
+                  ChunkFn chunk_fn) {
+    const auto n = static_cast<size_t>(last - first);
+    const size_t chunk = chunk_size<RandomIter>();
+    vector<T> partial((n + chunk - 1) / chunk, init);
+    auto body = [&](size_t b, size_t e) {
+        partial[b / chunk] = chunk_fn(first + b, first + e);
+    };
+    parallel_chunks(n, chunk, body);
+    for (auto& x : partial) {
+        init = op(mystl::move(init), mystl::move(x));
+    }
+    return init;
+}
+
+// 把 src 上相邻的两段已排序区间两两归并到 dst，每段宽度为 width
+// 较长的归并按前一段切成若干片，用 lower_bound 找到后一段对应的位置，各片并行归并
+template <typename SrcIter, typename DstIter, typename Compared>
+void merge_round(SrcIter src, DstIter dst, size_t n, size_t width,
+                 size_t piece, Compared& comp) {
+    struct merge_task {
+        size_t a0, a1, b0, b1, out;
+    };
+    vector<merge_task> tasks;
+    for (size_t lo = 0; lo < n; lo += 2 * width) {
+        const size_t mid = n - lo > width ? lo + width : n;
+        const size_t hi = n - mid > width ? mid + width : n;
+        size_t b0 = mid;
+        for (size_t a0 = lo; a0 < mid; a0 += piece) {
+            const size_t a1 = mid - a0 > piece ? a0 + piece : mid;
+            const size_t b1 =
+                a1 == mid ? hi
+                          : static_cast<size_t>(
+                                mystl::lower_bound(src + b0, src + hi,
+                                                   src[a1], comp) -
+                                src);
+            tasks.push_back(merge_task{a0, a1, b0, b1, a0 + b0 - mid});
+            b0 = b1;
+        }
+    }
+    auto body = [&](size_t b, size_t e) {
+        for (; b != e; ++b) {
+            const merge_task& t = tasks[b];
+            size_t i = t.a0, j = t.b0, k = t.out;
+            while (i != t.a1 && j != t.b1) {
+                if (comp(src[j], src[i])) {
+                    dst[k++] = mystl::move(src[j++]);
+                } else {
+                    dst[k++] = mystl::move(src[i++]);
+                }
+            }
+            for (; i != t.a1; ++i) {
+                dst[k++] = mystl::move(src[i]);
+            }
+            for (; j != t.b1; ++j) {
+                dst[k++] = mystl::move(src[j]);
+            }
+        }
+    };
+    parallel_chunks(tasks.size(), 1, body);
+}
+
+// 并行排序：先把区间切成线程数个段并行排序，再逐轮两两归并
+template <typename RandomIter, typename Compared>
+void parallel_sort(RandomIter first, RandomIter last, Compared comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    const auto n = static_cast<size_t>(last - first);
+    const size_t threads = thread_pool::global().size() + 1;
+    if (n < kParallelSortMin || threads == 1) {
+        mystl::sort(first, last, comp);
+        return;
+    }
+    const size_t run = (n + threads - 1) / threads;
+    auto sort_run = [&](size_t b, size_t e) {
+        mystl::sort(first + b, first + e, comp);
+    };
+    parallel_chunks(n, run, sort_run);
+
+    // 归并在区间和缓冲区之间来回进行
+    vector<value_type> buf;
+    buf.reserve(n);
+    for (auto it = first; it != last; ++it) {
+        buf.emplace_back(mystl::move(*it));
+    }
+    const size_t piece = chunk_size<RandomIter>() * 4;
+    bool in_buf = true;
+    for (size_t width = run; width < n; width *= 2) {
+        if (in_buf) {
+            merge_round(buf.begin(), first, n, width, piece, comp);
+        } else {
+            merge_round(first, buf.begin(), n, width, piece, comp);
+        }
+        in_buf = !in_buf;
+    }
+    if (in_buf) {
+        auto move_back = [&](size_t b, size_t e) {
+            for (; b != e; ++b) {
+                first[b] = mystl::move(buf[b]);
+            }
+        };
+        parallel_chunks(n, chunk_size<RandomIter>(), move_back);
+    }
+}
+
+}  // namespace execution_detail
+
+/*****************************************************************************************/
+// for_each
+/*****************************************************************************************/
+
+template <typename Policy, typename ForwardIter, typename Function>
+requires is_execution_policy_v<Policy>
+void for_each(Policy&&, ForwardIter first, ForwardIter last, Function f) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter>) {
+        auto body = [&](size_t b, size_t e) {
+            mystl::for_each(first + b, first + e, f);
+        };
+        execution_detail::parallel_chunks(
+            static_cast<size_t>(last - first),
+            execution_detail::chunk_size<ForwardIter>(), body);
+    } else {
+        mystl::for_each(first, last, f);
+    }
+}
+
+/*****************************************************************************************/
+// transform
+/*****************************************************************************************/
+
+template <typename Policy, typename ForwardIter1, typename ForwardIter2,
+          typename UnaryOperation>
+requires is_execution_policy_v<Policy>
+ForwardIter2 transform(Policy&&, ForwardIter1 first, ForwardIter1 last,
+                       ForwardIter2 result, UnaryOperation unary_op) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter1,
+                                                  ForwardIter2>) {
+        const auto n = static_cast<size_t>(last - first);
+        auto body = [&](size_t b, size_t e) {
+            mystl::transform(first + b, first + e, result + b, unary_op);
+        };
+        execution_detail::parallel_chunks(
+            n, execution_detail::chunk_size<ForwardIter1>(), body);
+        return result + n;
+    } else {
+        return mystl::transform(first, last, result, unary_op);
+    }
+}
+
+template <typename Policy, typename ForwardIter1, typename ForwardIter2,
+          typename ForwardIter3, typename BinaryOperation>
+requires is_execution_policy_v<Policy>
+ForwardIter3 transform(Policy&&, ForwardIter1 first1, ForwardIter1 last1,
+                       ForwardIter2 first2, ForwardIter3 result,
+                       BinaryOperation binary_op) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter1,
+                                                  ForwardIter2,
+                                                  ForwardIter3>) {
+        const auto n = static_cast<size_t>(last1 - first1);
+        auto body = [&](size_t b, size_t e) {
+            mystl::transform(first1 + b, first1 + e, first2 + b, result + b,
+                             binary_op);
+        };
+        execution_detail::parallel_chunks(
+            n, execution_detail::chunk_size<ForwardIter1>(), body);
+        return result + n;
+    } else {
+        return mystl::transform(first1, last1, first2, result, binary_op);
+    }
+}
+
+/*****************************************************************************************/
+// reduce
+/*****************************************************************************************/
+
+template <typename Policy, typename ForwardIter, typename T,
+          typename BinaryOp>
+requires is_execution_policy_v<Policy>
+T reduce(Policy&&, ForwardIter first, ForwardIter last, T init,
+         BinaryOp binary_op) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter>) {
+        return execution_detail::parallel_reduce(
+            first, last, mystl::move(init), binary_op,
+            [&](ForwardIter f, ForwardIter l) {
+                return mystl::reduce(f + 1, l, T(*f), binary_op);
+            });
+    } else {
+        return mystl::reduce(first, last, mystl::move(init), binary_op);
+    }
+}
+
+template <typename Policy, typename ForwardIter, typename T>
+requires is_execution_policy_v<Policy>
+T reduce(Policy&&, ForwardIter first, ForwardIter last, T init) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter>) {
+        // 每块调用不带操作的版本，整数求和可以使用 SIMD 内核
+        return execution_detail::parallel_reduce(
+            first, last, mystl::move(init), std::plus<>(),
+            [](ForwardIter f, ForwardIter l) {
+                return mystl::reduce(f + 1, l, T(*f));
+            });
+    } else {
+        return mystl::reduce(first, last, mystl::move(init));
+    }
+}
+
+template <typename Policy, typename ForwardIter>
+requires is_execution_policy_v<Policy>
+typename iterator_traits<ForwardIter>::value_type reduce(Policy&& policy,
+                                                         ForwardIter first,
+                                                         ForwardIter last) {
+    return mystl::reduce(mystl::forward<Policy>(policy), first, last,
+                         typename iterator_traits<ForwardIter>::value_type{});
+}
+
+/*****************************************************************************************/
+// sort
+/*****************************************************************************************/
+
+template <typename Policy, typename RandomIter, typename Compared>
+requires is_execution_policy_v<Policy>
+void sort(Policy&&, RandomIter first, RandomIter last, Compared comp) {
+    if constexpr (execution_detail::is_parallel_v<Policy, RandomIter>) {
+        execution_detail::parallel_sort(first, last, comp);
+    } else {
+        mystl::sort(first, last, comp);
+    }
+}
+
+template <typename Policy, typename RandomIter>
+requires is_execution_policy_v<Policy>
+void sort(Policy&& policy, RandomIter first, RandomIter last) {
+    mystl::sort(mystl::forward<Policy>(policy), first, last, std::less<>());
+}
+
+/*****************************************************************************************/
+// copy
+/*****************************************************************************************/
+
+template <typename Policy, typename ForwardIter1, typename ForwardIter2>
+requires is_execution_policy_v<Policy>
+ForwardIter2 copy(Policy&&, ForwardIter1 first, ForwardIter1 last,
+                  ForwardIter2 result) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter1,
+                                                  ForwardIter2>) {
+        const auto n = static_cast<size_t>(last - first);
+        auto body = [&](size_t b, size_t e) {
+            mystl::copy(first + b, first + e, result + b);
+        };
+        execution_detail::parallel_chunks(
+            n, execution_detail::chunk_size<ForwardIter1>(), body);
+        return result + n;
+    } else {
+        return mystl::copy(first, last, result);
+    }
+}
+
+/*****************************************************************************************/
+// fill
+/*****************************************************************************************/
+
+template <typename Policy, typename ForwardIter, typename T>
+requires is_execution_policy_v<Policy>
+void fill(Policy&&, ForwardIter first, ForwardIter last, const T& value) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter>) {
+        auto body = [&](size_t b, size_t e) {
+            mystl::fill(first + b, first + e, value);
+        };
+        execution_detail::parallel_chunks(
+            static_cast<size_t>(last - first),
+            execution_detail::chunk_size<ForwardIter>(), body);
+    } else {
+        mystl::fill(first, last, value);
+    }
+}
+
+/*****************************************************************************************/
+// find
+// 各块按顺序被领取，位于已找到的位置之后的块直接跳过
+/*****************************************************************************************/
+
+template <typename Policy, typename ForwardIter, typename T>
+requires is_execution_policy_v<Policy>
+ForwardIter find(Policy&&, ForwardIter first, ForwardIter last,
+                 const T& value) {
+    if constexpr (execution_detail::is_parallel_v<Policy, ForwardIter>) {
+        const auto n = static_cast<size_t>(last - first);
+        std::atomic<size_t> found{n};
+        auto body = [&](size_t b, size_t e) {
+            if (b >= found.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const auto it = mystl::find(first + b, first + e, value);
+            if (it == first + e) {
+                return;
+            }
+            const auto idx = static_cast<size_t>(it - first);
+            size_t cur = found.load(std::memory_order_relaxed);
+            while (idx < cur && !found.compare_exchange_weak(
+                                    cur, idx, std::memory_order_relaxed)) {
+            }
+        };
+        execution_detail::parallel_chunks(
+            n, execution_detail::chunk_size<ForwardIter>(), body);
+        return first + found.load(std::memory_order_relaxed);
+    } else {
+        return mystl::find(first, last, value);
+    }
+}
+
+}  // namespace mystl
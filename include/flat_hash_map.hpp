@@ -0,0 +1,755 @@
+#pragma once
+
+// 这个头文件包含一个模板类 flat_hash_map
+// flat_hash_map : 开放寻址的哈希表，元素连续存放在槽位数组中，
+//                 每个槽位对应一个控制字节，查找时用 SSE2 一次比较 16 个控制字节
+
+// 控制字节为 kEmpty 表示空槽位，否则保存哈希值的低 7 位 (H2)
+// 槽位的起始探测位置由哈希值的其余位 (H1) 决定，采用线性探测：
+// 从起始位置开始每次读取 16 个控制字节，先用 H2 过滤候选槽位，
+// 遇到空槽位即可停止。删除时把后续元素向前移动 (backward shift)，
+// 因此表中不会留下墓碑，查找长度不会随删除次数增加
+// 控制字节数组尾部复制了前 kGroupWidth 个控制字节，使跨越末尾的读取无需回绕
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "util.hpp"
+#include "vector.hpp"
+
+namespace mystl {
+
+namespace hash_detail {
+
+using ctrl_t = int8_t;
+
+constexpr ctrl_t kEmpty = -128;
+constexpr size_t kGroupWidth = 16;
+
+// 一组控制字节，match 系列函数返回的位掩码中第 i 位对应组内第 i 个槽位
+#if defined(__SSE2__)
+struct group {
+    __m128i ctrl;
+
+    explicit group(const ctrl_t* p)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    uint32_t match(ctrl_t h2) const {
+        return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    uint32_t match_empty() const { return match(kEmpty); }
+
+    uint32_t match_full() const {
+        return ~static_cast<uint32_t>(_mm_movemask_epi8(ctrl)) & 0xFFFF;
+    }
+};
+#else
+struct group {
+    ctrl_t ctrl[kGroupWidth];
+
+    explicit group(const ctrl_t* p) { std::memcpy(ctrl, p, kGroupWidth); }
+
+    uint32_t match(ctrl_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t match_empty() const { return match(kEmpty); }
+
+    uint32_t match_full() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] >= 0) << i;
+        }
+        return mask;
+    }
+};
+#endif
+
+// 位掩码中最低位 1 的位置
+inline uint32_t lowest_bit(uint32_t mask) {
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+}
+
+// 对用户哈希值再做一次混合，避免 std::hash<int> 这类恒等哈希在线性探测下聚集
+inline size_t mix(size_t h) {
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    const unsigned __int128 m = static_cast<unsigned __int128>(h) * kMul;
+    return static_cast<size_t>(static_cast<uint64_t>(m) ^
+                               static_cast<uint64_t>(m >> 64));
+}
+
+inline size_t h1(size_t hash) { return hash >> 7; }
+inline ctrl_t h2(size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+}  // namespace hash_detail
+
+// 模板类：flat_hash_map
+// 模板参数分别代表键类型、值类型、哈希函数、键比较函数和空间配置器
+// 插入和 rehash 会使所有迭代器与引用失效，erase 会移动被删元素之后的元素
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Alloc = mystl::allocator<mystl::pair<const Key, T>>>
+class flat_hash_map {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = mystl::pair<const Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Alloc;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+private:
+    using ctrl_t = hash_detail::ctrl_t;
+    using ctrl_allocator = typename Alloc::template rebind<ctrl_t>::other;
+
+    static constexpr size_t kGroupWidth = hash_detail::kGroupWidth;
+    static constexpr size_t kMinCapacity = kGroupWidth;
+    // 槽位数是 2 的幂，取不会让 cap * sizeof(value_type) 溢出的最大值
+    static constexpr size_t kMaxCapacity =
+        std::bit_floor(static_cast<size_t>(-1) / 2 / sizeof(value_type));
+    // rehash 搬运元素时不会抛出异常；不可复制的类型只能搬运
+    static constexpr bool kNothrowRelocate =
+        is_trivially_relocatable_v<value_type> ||
+        std::is_nothrow_move_constructible_v<value_type> ||
+        !std::is_copy_constructible_v<value_type>;
+
+    template <bool Const>
+    class basic_iterator
+        : public mystl::iterator<forward_iterator_tag, value_type> {
+        friend class flat_hash_map;
+        template <bool>
+        friend class basic_iterator;
+
+        using ctrl_ptr = const ctrl_t*;
+        using slot_ptr =
+            std::conditional_t<Const, const value_type*, value_type*>;
+
+        ctrl_ptr ctrl_ = nullptr;
+        ctrl_ptr ctrl_end_ = nullptr;
+        slot_ptr slot_ = nullptr;
+
+        basic_iterator(ctrl_ptr ctrl, ctrl_ptr ctrl_end, slot_ptr slot)
+            : ctrl_(ctrl), ctrl_end_(ctrl_end), slot_(slot) {
+            skip_empty();
+        }
+
+        // 跳过空槽位，一次检查一组控制字节
+        void skip_empty() {
+            while (ctrl_ != ctrl_end_) {
+                uint32_t full = hash_detail::group(ctrl_).match_full();
+                const auto left = static_cast<size_t>(ctrl_end_ - ctrl_);
+                if (left < kGroupWidth) {
+                    full &= (1u << left) - 1;
+                }
+                if (full != 0) {
+                    const uint32_t n = hash_detail::lowest_bit(full);
+                    ctrl_ += n;
+                    slot_ += n;
+                    return;
+                }
+                const size_t step = left < kGroupWidth ? left : kGroupWidth;
+                ctrl_ += step;
+                slot_ += step;
+            }
+        }
+
+    public:
+        using reference =
+            std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = slot_ptr;
+
+        basic_iterator() = default;
+
+        // 允许 iterator 隐式转换为 const_iterator
+        template <bool C = Const>
+        requires C
+        basic_iterator(const basic_iterator<false>& other)
+            : ctrl_(other.ctrl_),
+              ctrl_end_(other.ctrl_end_),
+              slot_(other.slot_) {}
+
+        reference operator*() const { return *slot_; }
+        pointer operator->() const { return slot_; }
+
+        basic_iterator& operator++() {
+            ++ctrl_;
+            ++slot_;
+            skip_empty();
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) {
+            return lhs.ctrl_ == rhs.ctrl_;
+        }
+
+        friend bool operator!=(const basic_iterator& lhs,
+                               const basic_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+private:
+    ctrl_t* ctrl_ = nullptr;
+    value_type* slots_ = nullptr;
+    size_type size_ = 0;
+    size_type capacity_ = 0;  // 槽位数，0 或者不小于 kMinCapacity 的 2 的幂
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] KeyEqual eq_;
+    [[no_unique_address]] Alloc alloc_;
+
+public:
+    // 构造、复制、移动、析构函数
+    flat_hash_map() = default;
+
+    explicit flat_hash_map(size_type bucket_count, const Hash& hash = Hash(),
+                           const KeyEqual& eq = KeyEqual(),
+                           const Alloc& alloc = Alloc())
+        : hash_(hash), eq_(eq), alloc_(alloc) {
+        reserve(bucket_count);
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    flat_hash_map(Iter first, Iter last, size_type bucket_count = 0)
+        : flat_hash_map(bucket_count) {
+        insert(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> ilist)
+        : flat_hash_map(ilist.size()) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    flat_hash_map(const flat_hash_map& rhs)
+        : hash_(rhs.hash_), eq_(rhs.eq_), alloc_(rhs.alloc_) {
+        reserve(rhs.size_);
+        for (const auto& value : rhs) {
+            emplace_new(hash_of(value.first), value);
+        }
+    }
+
+    flat_hash_map(flat_hash_map&& rhs) noexcept
+        : ctrl_(rhs.ctrl_),
+          slots_(rhs.slots_),
+          size_(rhs.size_),
+          capacity_(rhs.capacity_),
+          hash_(mystl::move(rhs.hash_)),
+          eq_(mystl::move(rhs.eq_)),
+          alloc_(mystl::move(rhs.alloc_)) {
+        rhs.ctrl_ = nullptr;
+        rhs.slots_ = nullptr;
+        rhs.size_ = 0;
+        rhs.capacity_ = 0;
+    }
+
+    flat_hash_map& operator=(const flat_hash_map& rhs) {
+        if (this != &rhs) {
+            flat_hash_map tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& rhs) noexcept {
+        if (this != &rhs) {
+            flat_hash_map tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~flat_hash_map() {
+        clear();
+        deallocate_storage(ctrl_, slots_, capacity_);
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        return iterator(ctrl_, ctrl_ + capacity_, slots_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(ctrl_, ctrl_ + capacity_, slots_);
+    }
+    iterator end() noexcept {
+        return iterator(ctrl_ + capacity_, ctrl_ + capacity_,
+                        slots_ + capacity_);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(ctrl_ + capacity_, ctrl_ + capacity_,
+                              slots_ + capacity_);
+    }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    size_type bucket_count() const noexcept { return capacity_; }
+
+    float load_factor() const noexcept {
+        return capacity_ == 0 ? 0.0f
+                              : static_cast<float>(size_) / capacity_;
+    }
+    float max_load_factor() const noexcept { return 0.875f; }
+    size_type max_size() const noexcept { return growth_limit(kMaxCapacity); }
+
+    // 保证能容纳 n 个元素而不触发 rehash
+    void reserve(size_type n) {
+        if (n > growth_limit(capacity_)) {
+            rehash(n);
+        }
+    }
+
+    // 重新分配槽位数组，槽位数至少能以最大负载因子容纳 max(n, size()) 个元素
+    void rehash(size_type n) {
+        if (n < size_) {
+            n = size_;
+        }
+        if (n > max_size()) {
+            throw std::length_error("flat_hash_map's size too big");
+        }
+        size_type new_cap = 0;
+        if (n != 0) {
+            new_cap = kMinCapacity;
+            while (growth_limit(new_cap) < n) {
+                new_cap *= 2;
+            }
+        }
+        if (new_cap != capacity_) {
+            resize(new_cap);
+        }
+    }
+
+    // 查找相关操作
+    iterator find(const key_type& key) {
+        const size_type i = find_index(key, hash_of(key));
+        return i == capacity_ ? end() : iterator_at(i);
+    }
+
+    const_iterator find(const key_type& key) const {
+        const size_type i = find_index(key, hash_of(key));
+        return i == capacity_ ? end() : const_iterator_at(i);
+    }
+
+    bool contains(const key_type& key) const { return find(key) != end(); }
+
+    size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    mapped_type& at(const key_type& key) {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("flat_hash_map<Key, T>::at() no such key");
+        }
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("flat_hash_map<Key, T>::at() no such key");
+        }
+        return it->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(mystl::move(key)).first->second;
+    }
+
+    // 修改容器相关操作
+
+    // try_emplace：键不存在时才用 args 构造值
+    template <typename K, typename... Args>
+    requires std::is_constructible_v<key_type, K&&>
+    mystl::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const size_t hash = hash_of(key);
+        const size_type i = find_index(key, hash);
+        if (i != capacity_) {
+            return mystl::pair<iterator, bool>(iterator_at(i), false);
+        }
+        const size_type pos =
+            emplace_new(hash, mystl::forward<K>(key),
+                        mapped_type(mystl::forward<Args>(args)...));
+        return mystl::pair<iterator, bool>(iterator_at(pos), true);
+    }
+
+    template <typename... Args>
+    mystl::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(mystl::forward<Args>(args)...);
+        const size_t hash = hash_of(value.first);
+        const size_type i = find_index(value.first, hash);
+        if (i != capacity_) {
+            return mystl::pair<iterator, bool>(iterator_at(i), false);
+        }
+        const size_type pos = emplace_new(hash, mystl::move(value));
+        return mystl::pair<iterator, bool>(iterator_at(pos), true);
+    }
+
+    mystl::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    mystl::pair<iterator, bool> insert(value_type&& value) {
+        return emplace(mystl::move(value));
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    void insert(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    template <typename M>
+    mystl::pair<iterator, bool> insert_or_assign(const key_type& key,
+                                                 M&& obj) {
+        auto result = try_emplace(key, mystl::forward<M>(obj));
+        if (!result.second) {
+            result.first->second = mystl::forward<M>(obj);
+        }
+        return result;
+    }
+
+    // erase：删除后把后续元素前移，不留下墓碑
+    // 删除会移动其他元素，所以不返回迭代器；遍历中删除请使用 erase_if
+    size_type erase(const key_type& key) {
+        const size_type i = find_index(key, hash_of(key));
+        if (i == capacity_) {
+            return 0;
+        }
+        erase_at(i);
+        return 1;
+    }
+
+    void erase(const_iterator pos) {
+        erase_at(static_cast<size_type>(pos.ctrl_ - ctrl_));
+    }
+
+    // 删除所有满足 pred 的元素，返回删除的个数
+    template <typename Pred>
+    size_type erase_if(Pred pred) {
+        const size_type old_size = size_;
+        for (size_type i = 0; i < capacity_;) {
+            // 前移可能把一个尚未检查的元素移到 i，因此删除后不前进
+            if (ctrl_[i] != hash_detail::kEmpty && pred(slots_[i])) {
+                erase_at(i);
+            } else {
+                ++i;
+            }
+        }
+        return old_size - size_;
+    }
+
+    void clear() noexcept {
+        if (size_ == 0) {
+            return;
+        }
+        destroy_slots(ctrl_, slots_, capacity_);
+        std::memset(ctrl_, hash_detail::kEmpty, capacity_ + kGroupWidth);
+        size_ = 0;
+    }
+
+    void swap(flat_hash_map& rhs) noexcept {
+        mystl::swap(ctrl_, rhs.ctrl_);
+        mystl::swap(slots_, rhs.slots_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(capacity_, rhs.capacity_);
+        mystl::swap(hash_, rhs.hash_);
+        mystl::swap(eq_, rhs.eq_);
+        mystl::swap(alloc_, rhs.alloc_);
+    }
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return eq_; }
+    allocator_type get_allocator() const { return alloc_; }
+
+private:
+    static size_type growth_limit(size_type cap) { return cap - cap / 8; }
+
+    size_t hash_of(const key_type& key) const {
+        return hash_detail::mix(hash_(key));
+    }
+
+    size_type home_of(size_t hash) const {
+        return hash_detail::h1(hash) & (capacity_ - 1);
+    }
+
+    iterator iterator_at(size_type i) {
+        iterator it;
+        it.ctrl_ = ctrl_ + i;
+        it.ctrl_end_ = ctrl_ + capacity_;
+        it.slot_ = slots_ + i;
+        return it;
+    }
+
+    const_iterator const_iterator_at(size_type i) const {
+        const_iterator it;
+        it.ctrl_ = ctrl_ + i;
+        it.ctrl_end_ = ctrl_ + capacity_;
+        it.slot_ = slots_ + i;
+        return it;
+    }
+
+    // 设置控制字节，同时维护尾部的副本
+    static void set_ctrl(ctrl_t* ctrl, size_type cap, size_type i,
+                         ctrl_t value) {
+        ctrl[i] = value;
+        if (i < kGroupWidth) {
+            ctrl[cap + i] = value;
+        }
+    }
+
+    void set_ctrl(size_type i, ctrl_t value) {
+        set_ctrl(ctrl_, capacity_, i, value);
+    }
+
+    // 返回 key 所在的槽位，不存在时返回 capacity_
+    size_type find_index(const key_type& key, size_t hash) const {
+        if (capacity_ == 0) {
+            return capacity_;
+        }
+        const size_type mask = capacity_ - 1;
+        const ctrl_t tag = hash_detail::h2(hash);
+        size_type pos = home_of(hash);
+        while (true) {
+            hash_detail::group g(ctrl_ + pos);
+            for (uint32_t m = g.match(tag); m != 0; m &= m - 1) {
+                const size_type i = (pos + hash_detail::lowest_bit(m)) & mask;
+                if (eq_(slots_[i].first, key)) {
+                    return i;
+                }
+            }
+            if (g.match_empty() != 0) {
+                return capacity_;
+            }
+            pos = (pos + kGroupWidth) & mask;
+        }
+    }
+
+    // 返回从 hash 的起始位置开始的第一个空槽位，调用者保证表未满
+    static size_type find_empty(const ctrl_t* ctrl, size_type cap,
+                                size_t hash) {
+        const size_type mask = cap - 1;
+        size_type pos = hash_detail::h1(hash) & mask;
+        while (true) {
+            const uint32_t m = hash_detail::group(ctrl + pos).match_empty();
+            if (m != 0) {
+                return (pos + hash_detail::lowest_bit(m)) & mask;
+            }
+            pos = (pos + kGroupWidth) & mask;
+        }
+    }
+
+    size_type find_empty(size_t hash) const {
+        return find_empty(ctrl_, capacity_, hash);
+    }
+
+    // 插入一个确定不存在的元素，返回其槽位
+    template <typename... Args>
+    size_type emplace_new(size_t hash, Args&&... args) {
+        if (size_ + 1 > growth_limit(capacity_)) {
+            rehash(capacity_ == 0 ? 1 : growth_limit(capacity_) + 1);
+        }
+        const size_type i = find_empty(hash);
+        alloc_.construct(slots_ + i, mystl::forward<Args>(args)...);
+        set_ctrl(i, hash_detail::h2(hash));
+        ++size_;
+        return i;
+    }
+
+    // 删除槽位 i 上的元素，之后把探测链上能前移的元素逐个移入空位
+    // 先算出探测链上后续元素的起始位置再改动表，哈希函数抛出异常时表保持不变
+    void erase_at(size_type i) {
+        const size_type mask = capacity_ - 1;
+        mystl::small_vector<size_type, 16> homes;
+        for (size_type j = (i + 1) & mask; ctrl_[j] != hash_detail::kEmpty;
+             j = (j + 1) & mask) {
+            homes.push_back(home_of(hash_of(slots_[j].first)));
+        }
+        mystl::destory(slots_ + i);
+        set_ctrl(i, hash_detail::kEmpty);
+        --size_;
+        size_type hole = i;
+        size_type j = i;
+        for (const size_type home : homes) {
+            j = (j + 1) & mask;
+            // 元素的起始位置不在 (hole, j] 之间时，移到 hole 仍在其探测链上
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                mystl::relocate(slots_ + j, slots_ + j + 1, slots_ + hole);
+                set_ctrl(hole, ctrl_[j]);
+                set_ctrl(j, hash_detail::kEmpty);
+                hole = j;
+            }
+        }
+    }
+
+    // 先在新空间建好整张表再换入，构建失败时原表保持不变
+    // 第一遍算出全部元素的哈希值，哈希函数抛出异常时还没有搬动任何元素；
+    // 第二遍按同样的顺序放入新表，元素可以不抛出异常地搬运时直接搬运，
+    // 否则复制到新表，全部成功后再析构旧元素
+    void resize(size_type new_cap) {
+        mystl::vector<size_t> hashes;
+        hashes.reserve(size_);
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] != hash_detail::kEmpty) {
+                hashes.push_back(hash_of(slots_[i].first));
+            }
+        }
+
+        ctrl_t* new_ctrl = nullptr;
+        value_type* new_slots = nullptr;
+        if (new_cap > kMaxCapacity) {
+            throw std::length_error("flat_hash_map's size too big");
+        }
+        if (new_cap != 0) {
+            new_ctrl = ctrl_allocator(alloc_).allocate(new_cap + kGroupWidth);
+            try {
+                new_slots = alloc_.allocate(new_cap);
+            } catch (...) {
+                ctrl_allocator(alloc_).deallocate(new_ctrl,
+                                                  new_cap + kGroupWidth);
+                throw;
+            }
+            std::memset(new_ctrl, hash_detail::kEmpty, new_cap + kGroupWidth);
+        }
+
+        size_type i = 0;
+        size_type placed = 0;
+        try {
+            for (; i < capacity_; ++i) {
+                if (ctrl_[i] == hash_detail::kEmpty) {
+                    continue;
+                }
+                const size_t hash = hashes[placed];
+                const size_type pos = find_empty(new_ctrl, new_cap, hash);
+                if constexpr (kNothrowRelocate) {
+                    mystl::relocate(slots_ + i, slots_ + i + 1,
+                                    new_slots + pos);
+                } else {
+                    alloc_.construct(new_slots + pos, slots_[i]);
+                }
+                set_ctrl(new_ctrl, new_cap, pos, hash_detail::h2(hash));
+                ++placed;
+            }
+        } catch (...) {
+            if constexpr (kNothrowRelocate) {
+                if (placed != 0) {
+                    // 只有不可复制、移动会抛出异常的元素会走到这里：
+                    // 已搬走的元素无法放回，新表中的前 placed 个元素本身是
+                    // 完整的一张表，放弃旧表中剩余的元素，改用新表
+                    destroy_slots(ctrl_ + i, slots_ + i, capacity_ - i);
+                    adopt_storage(new_ctrl, new_slots, new_cap);
+                    size_ = placed;
+                    throw;
+                }
+            } else {
+                destroy_slots(new_ctrl, new_slots, new_cap);
+            }
+            deallocate_storage(new_ctrl, new_slots, new_cap);
+            throw;
+        }
+        if constexpr (!kNothrowRelocate) {
+            destroy_slots(ctrl_, slots_, capacity_);
+        }
+        adopt_storage(new_ctrl, new_slots, new_cap);
+    }
+
+    // 析构控制字节非空的槽位上的元素
+    static void destroy_slots(const ctrl_t* ctrl, value_type* slots,
+                              size_type n) {
+        for (size_type i = 0; i < n; ++i) {
+            if (ctrl[i] != hash_detail::kEmpty) {
+                mystl::destory(slots + i);
+            }
+        }
+    }
+
+    // 释放当前的存储空间，换成 ctrl / slots
+    void adopt_storage(ctrl_t* ctrl, value_type* slots, size_type cap) {
+        deallocate_storage(ctrl_, slots_, capacity_);
+        ctrl_ = ctrl;
+        slots_ = slots;
+        capacity_ = cap;
+    }
+
+    void deallocate_storage(ctrl_t* ctrl, value_type* slots, size_type cap) {
+        if (cap != 0) {
+            ctrl_allocator(alloc_).deallocate(ctrl, cap + kGroupWidth);
+            alloc_.deallocate(slots, cap);
+        }
+    }
+};
+
+// 重载比较操作符
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+bool operator==(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (const auto& value : lhs) {
+        auto it = rhs.find(value.first);
+        if (it == rhs.end() || !(it->second == value.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+bool operator!=(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
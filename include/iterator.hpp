@@ -1,6 +1,8 @@
 #pragma once
 
 // 包含迭代器设计
+// 原生指针属于连续迭代器 (contiguous_iterator_tag)，容器的批量操作据此退化为
+// memcpy / memcmp 等内存原语
 
 #include <concepts>
 #include <cstddef>
@@ -16,6 +18,9 @@ struct output_iterator_tag {};
 struct forward_iterator_tag : public input_iterator_tag {};
 struct bidirectional_iterator_tag : public forward_iterator_tag {};
 struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+// 连续迭代器：元素在内存中按顺序连续存放，区间可以整体交给 memcpy / memcmp
+// 只接受 random_access_iterator_tag 的分派版本同样适用于它
+struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
 // iterator template
 template <typename Category, typename T, typename Distance = ptrdiff_t,
@@ -73,7 +78,7 @@ struct iterator_traits
 // 针对原生指针的偏特化版本
 template <typename T>
 struct iterator_traits<T*> {
-    using iterator_category = random_access_iterator_tag;
+    using iterator_category = contiguous_iterator_tag;
     using value_type = T;
     using pointer = T*;
     using reference = T&;
@@ -82,7 +87,7 @@ struct iterator_traits<T*> {
 
 template <typename T>
 struct iterator_traits<const T*> {
-    using iterator_category = random_access_iterator_tag;
+    using iterator_category = contiguous_iterator_tag;
     using value_type = T;
     using pointer = const T*;
     using reference = const T&;
@@ -119,6 +124,14 @@ template <typename Iter>
 struct is_random_access_iterator
     : public has_iterator_cat_of<Iter, random_access_iterator_tag> {};
 
+template <typename Iter>
+struct is_contiguous_iterator
+    : public has_iterator_cat_of<Iter, contiguous_iterator_tag> {};
+
+template <typename Iter>
+inline constexpr bool is_contiguous_iterator_v =
+    is_contiguous_iterator<Iter>::value;
+
 template <typename Iterator>
 struct is_iterator
     : public m_bool_constant<is_input_iterator<Iterator>::value ||
@@ -126,15 +139,28 @@ struct is_iterator
 
 // 萃取某个迭代器的 category
 template <typename Iterator>
-typename iterator_traits<Iterator>::iterator_category iterator_category(
-    const Iterator&) {
+constexpr typename iterator_traits<Iterator>::iterator_category
+iterator_category(const Iterator&) {
     using Category = typename iterator_traits<Iterator>::iterator_category;
     return Category{};
 }
 
+// 取得连续迭代器所指元素的地址，不解引用迭代器，因此对尾后迭代器同样适用
+// 类类型的连续迭代器需要提供 operator->
+template <typename T>
+constexpr T* to_address(T* p) noexcept {
+    return p;
+}
+
+template <typename Iter>
+requires is_contiguous_iterator<Iter>::value
+constexpr auto to_address(const Iter& it) noexcept {
+    return it.operator->();
+}
+
 // 萃取某个迭代器的 distance_type
 template <typename Iterator>
-typename iterator_traits<Iterator>::difference_type* distance_type(
+constexpr typename iterator_traits<Iterator>::difference_type* distance_type(
     const Iterator&) {
     return static_cast<typename iterator_traits<Iterator>::difference_type*>(0);
 }
@@ -142,7 +168,8 @@ typename iterator_traits<Iterator>::difference_type* distance_type(
 // 萃取某个迭代器的 value_type
 
 template <typename Iterator>
-typename iterator_traits<Iterator>::value_type* value_type(const Iterator&) {
+constexpr typename iterator_traits<Iterator>::value_type* value_type(
+    const Iterator&) {
     return static_cast<typename iterator_traits<Iterator>::value_type*>(0);
 }
 
@@ -150,8 +177,8 @@ typename iterator_traits<Iterator>::value_type* value_type(const Iterator&) {
 
 // distance 的 input_iterator_tag 的版本
 template <typename InputIterator>
-typename iterator_traits<InputIterator>::difference_type distance_dispatch(
-    InputIterator first, InputIterator last, input_iterator_tag) {
+constexpr typename iterator_traits<InputIterator>::difference_type
+distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag) {
     typename iterator_traits<InputIterator>::difference_type n = 0;
     while (first != last) {
         ++first;
@@ -162,13 +189,14 @@ typename iterator_traits<InputIterator>::difference_type distance_dispatch(
 
 // distance 的 random_access_iterator_tag 的版本
 template <typename RandomIter>
-typename iterator_traits<RandomIter>::difference_type distance_dispatch(
-    RandomIter first, RandomIter last, random_access_iterator_tag) {
+constexpr typename iterator_traits<RandomIter>::difference_type
+distance_dispatch(RandomIter first, RandomIter last,
+                  random_access_iterator_tag) {
     return last - first;
 }
 
 template <typename InputIterator>
-typename iterator_traits<InputIterator>::difference_type distance(
+constexpr typename iterator_traits<InputIterator>::difference_type distance(
     InputIterator first, InputIterator last) {
     return distance_dispatch(first, last, iterator_category(first));
 }
@@ -177,7 +205,8 @@ typename iterator_traits<InputIterator>::difference_type distance(
 
 // advance 的 input_iterator_tag 的版本
 template <typename InputIterator, typename Distance>
-void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag) {
+constexpr void advance_dispatch(InputIterator& i, Distance n,
+                                input_iterator_tag) {
     while (n--) {
         ++i;
     }
@@ -185,8 +214,8 @@ void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag) {
 
 // advance 的 bidirectional_iterator_tag 的版本
 template <typename BidirectionalIterator, typename Distance>
-void advance_dispatch(BidirectionalIterator& i, Distance n,
-                      bidirectional_iterator_tag) {
+constexpr void advance_dispatch(BidirectionalIterator& i, Distance n,
+                                bidirectional_iterator_tag) {
     if (n >= 0) {
         while (n--) {
             ++i;
@@ -200,12 +229,13 @@ void advance_dispatch(BidirectionalIterator& i, Distance n,
 
 // advance 的 random_access_iterator_tag 的版本
 template <typename RandomIter, typename Distance>
-void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag) {
+constexpr void advance_dispatch(RandomIter& i, Distance n,
+                                random_access_iterator_tag) {
     i += n;
 }
 
 template <typename InputIterator, typename Distance>
-void advance(InputIterator& i, Distance n) {
+constexpr void advance(InputIterator& i, Distance n) {
     advance_dispatch(i, n, iterator_category(i));
 }
 
@@ -220,7 +250,10 @@ private:
 
 public:
     // 反向迭代器的五种相应型别
-    using iterator_category = typename iterator_traits<Iterator>::category;
+    // 反向遍历时地址递减，连续迭代器的反向迭代器只是随机访问迭代器
+    using iterator_category = std::conditional_t<
+        is_contiguous_iterator<Iterator>::value, random_access_iterator_tag,
+        typename iterator_traits<Iterator>::iterator_category>;
     using value_type = typename iterator_traits<Iterator>::value_type;
     using difference_type = typename iterator_traits<Iterator>::difference_type;
     using pointer = typename iterator_traits<Iterator>::pointer;
@@ -231,67 +264,73 @@ public:
 
 public:
     // constructor
-    reverse_iterator() = default;
-    explicit reverse_iterator(iterator_type i) : current(i) {}
-    reverse_iterator(const self& rhs) : current(rhs.current) {}
+    constexpr reverse_iterator() = default;
+    constexpr explicit reverse_iterator(iterator_type i) : current(i) {}
+    constexpr reverse_iterator(const self& rhs) : current(rhs.current) {}
 
 public:
     // 取出对应的正向迭代器
-    iterator_type base() const { return current; }
+    constexpr iterator_type base() const { return current; }
 
     // 重载操作符
-    reference operator*() const {
+    constexpr reference operator*() const {
         // 实际对应正向迭代器的前一个位置
         auto tmp = current;
         return *(--tmp);
     }
 
-    pointer operator->() const { return &(operator*()); }
+    constexpr pointer operator->() const { return &(operator*()); }
 
     // 前进(++)变为后退(--)
-    self& operator++() {
+    constexpr self& operator++() {
         --current;
         return *this;
     }
 
-    self operator++(int) {
+    constexpr self operator++(int) {
         self tmp = *this;
         --current;
         return tmp;
     }
 
     // 后退(--)变为前进(++)
-    self& operator--() {
+    constexpr self& operator--() {
         ++current;
         return *this;
     }
 
-    self operator--(int) {
+    constexpr self operator--(int) {
         self tmp = *this;
         ++current;
         return tmp;
     }
 
-    self& operator+=(difference_type n) {
+    constexpr self& operator+=(difference_type n) {
         current -= n;
         return *this;
     }
 
-    self operator+(difference_type n) const { return self(current - n); }
+    constexpr self operator+(difference_type n) const {
+        return self(current - n);
+    }
 
-    self& operator-=(difference_type n) {
+    constexpr self& operator-=(difference_type n) {
         current += n;
         return *this;
     }
 
-    self operator-(difference_type n) const { return self(current + n); }
+    constexpr self operator-(difference_type n) const {
+        return self(current + n);
+    }
 
-    reference operator[](difference_type n) const { return *(*this + n); }
+    constexpr reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
 };
 
 // 重载 operator-
 template <typename Iterator>
-typename reverse_iterator<Iterator>::difference_type operator-(
+constexpr typename reverse_iterator<Iterator>::difference_type operator-(
     const reverse_iterator<Iterator>& lhs,
     const reverse_iterator<Iterator>& rhs) {
     return rhs.base() - lhs.base();
@@ -299,39 +338,53 @@ typename reverse_iterator<Iterator>::difference_type operator-(
 
 // 重载比较操作符
 template <typename Iterator>
-bool operator==(const reverse_iterator<Iterator>& lhs,
-                const reverse_iterator<Iterator>& rhs) {
+constexpr bool operator==(const reverse_iterator<Iterator>& lhs,
+                          const reverse_iterator<Iterator>& rhs) {
     return lhs.base() == rhs.base();
 }
 
 template <typename Iterator>
-bool operator<(const reverse_iterator<Iterator>& lhs,
-               const reverse_iterator<Iterator>& rhs) {
+constexpr bool operator<(const reverse_iterator<Iterator>& lhs,
+                         const reverse_iterator<Iterator>& rhs) {
     return rhs.base() < lhs.base();
 }
 
 template <typename Iterator>
-bool operator!=(const reverse_iterator<Iterator>& lhs,
-                const reverse_iterator<Iterator>& rhs) {
+constexpr bool operator!=(const reverse_iterator<Iterator>& lhs,
+                          const reverse_iterator<Iterator>& rhs) {
     return !(lhs == rhs);
 }
 
 template <typename Iterator>
-bool operator>(const reverse_iterator<Iterator>& lhs,
-               const reverse_iterator<Iterator>& rhs) {
+constexpr bool operator>(const reverse_iterator<Iterator>& lhs,
+                         const reverse_iterator<Iterator>& rhs) {
     return rhs < lhs;
 }
 
 template <typename Iterator>
-bool operator<=(const reverse_iterator<Iterator>& lhs,
-                const reverse_iterator<Iterator>& rhs) {
+constexpr bool operator<=(const reverse_iterator<Iterator>& lhs,
+                          const reverse_iterator<Iterator>& rhs) {
     return !(rhs < lhs);
 }
 
 template <typename Iterator>
-bool operator>=(const reverse_iterator<Iterator>& lhs,
-                const reverse_iterator<Iterator>& rhs) {
+constexpr bool operator>=(const reverse_iterator<Iterator>& lhs,
+                          const reverse_iterator<Iterator>& rhs) {
     return !(lhs < rhs);
 }
 
+// 判断是否为连续迭代器的反向迭代器
+// 反向区间 [first, last) 与正向区间 [last.base(), first.base()) 是同一段内存，
+// 与顺序无关的操作 (填充、判断相等) 以及方向一致的复制可以改在正向区间上做
+template <typename Iter>
+struct is_reverse_contiguous_iterator : public m_false_type {};
+
+template <typename Iter>
+struct is_reverse_contiguous_iterator<reverse_iterator<Iter>>
+    : public m_bool_constant<is_contiguous_iterator<Iter>::value> {};
+
+template <typename Iter>
+inline constexpr bool is_reverse_contiguous_iterator_v =
+    is_reverse_contiguous_iterator<Iter>::value;
+
 }  // namespace mystl
\ No newline at end of file
@@ -0,0 +1,304 @@
+#pragma once
+
+// 这个头文件包含模板类 mmap_span 以及只读的 mmap_vector
+// mmap_span   : 用 mmap 把整个文件映射为 T 的数组，迭代器为原生指针
+//               不读取文件内容，页面在第一次访问时才由内核装入，
+//               MAP_SHARED 映射的页面在进程间共享
+//               T 不是 const 时映射为可写，修改直接写回文件
+// mmap_vector : mmap_span<const T>，只读映射
+// 只接受可平凡复制的 T，文件中的字节就是对象的内存布局
+// 仅支持 POSIX 系统
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "iterator.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 传给 madvise 的访问模式提示
+enum class mmap_advice {
+    normal,      // 默认的预读策略
+    sequential,  // 顺序访问：加大预读，读过的页面可以尽早回收
+    random,      // 随机访问：关闭预读
+    willneed,    // 马上会用到：异步地把页面读入内存
+    dontneed,    // 暂时不用：允许内核回收这些页面
+    hugepage,    // 使用透明大页，减少 TLB 缺失 (需要内核支持文件映射的大页)
+};
+
+// 模板类：mmap_span
+// 模板参数 T 代表元素类型，为 const 时以只读方式映射
+template <typename T>
+class mmap_span {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "mmap_span requires a trivially copyable type");
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static constexpr bool is_writable = !std::is_const_v<T>;
+
+private:
+    void* base_ = nullptr;  // mmap 返回的地址，按页对齐
+    size_type mapped_ = 0;  // 映射的字节数
+    T* data_ = nullptr;
+    size_type size_ = 0;
+
+public:
+    mmap_span() noexcept = default;
+
+    // 映射文件 path 中从 offset 字节开始的全部内容
+    // 剩余的字节数必须是 sizeof(T) 的整数倍，offset 必须满足 T 的对齐要求
+    explicit mmap_span(const char* path, size_type offset = 0) {
+        const int fd = ::open(path, is_writable ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            throw_errno("open", path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw_errno("fstat", path, err);
+        }
+        try {
+            map(fd, static_cast<size_type>(st.st_size), offset, path);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        // 映射建立后文件描述符就不再需要了
+        ::close(fd);
+    }
+
+    explicit mmap_span(const std::string& path, size_type offset = 0)
+        : mmap_span(path.c_str(), offset) {}
+
+    // 创建 (或截断) 文件 path，长度为 n 个元素，内容全为 0，并以可写方式映射
+    static mmap_span create(const char* path, size_type n)
+    requires is_writable
+    {
+        const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw_errno("open", path);
+        }
+        mmap_span result;
+        try {
+            if (::ftruncate(fd, static_cast<off_t>(n * sizeof(T))) != 0) {
+                throw_errno("ftruncate", path);
+            }
+            result.map(fd, n * sizeof(T), 0, path);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+        return result;
+    }
+
+    mmap_span(const mmap_span&) = delete;
+    mmap_span& operator=(const mmap_span&) = delete;
+
+    mmap_span(mmap_span&& rhs) noexcept { take(rhs); }
+
+    mmap_span& operator=(mmap_span&& rhs) noexcept {
+        if (this != &rhs) {
+            unmap();
+            take(rhs);
+        }
+        return *this;
+    }
+
+    ~mmap_span() { unmap(); }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+    bool is_open() const noexcept { return base_ != nullptr; }
+
+    // 访问元素相关操作
+    reference operator[](size_type n) { return data_[n]; }
+    const_reference operator[](size_type n) const { return data_[n]; }
+
+    reference at(size_type n) {
+        check_index(n);
+        return data_[n];
+    }
+    const_reference at(size_type n) const {
+        check_index(n);
+        return data_[n];
+    }
+
+    reference front() { return data_[0]; }
+    const_reference front() const { return data_[0]; }
+    reference back() { return data_[size_ - 1]; }
+    const_reference back() const { return data_[size_ - 1]; }
+
+    pointer data() noexcept { return data_; }
+    const_pointer data() const noexcept { return data_; }
+
+    // 对 [first, first + n) 个元素所在的页面给出访问模式提示
+    // 提示只影响性能，内核不支持时返回 false 而不抛出异常
+    bool advise(mmap_advice advice, size_type first = 0,
+                size_type n = static_cast<size_type>(-1)) const noexcept {
+        if (empty() || first >= size_) {
+            return true;
+        }
+        if (n > size_ - first) {
+            n = size_ - first;
+        }
+        // madvise 要求起始地址按页对齐，向前扩展到所在页的开头
+        const auto page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = reinterpret_cast<uintptr_t>(data_ + first);
+        const auto end = reinterpret_cast<uintptr_t>(data_ + first + n);
+        const uintptr_t aligned = begin & ~(page - 1);
+        return ::madvise(reinterpret_cast<void*>(aligned), end - aligned,
+                         to_native(advice)) == 0;
+    }
+
+    // 把修改过的页面同步写回文件，只对可写映射有意义
+    void flush()
+    requires is_writable
+    {
+        if (base_ != nullptr && ::msync(base_, mapped_, MS_SYNC) != 0) {
+            throw_errno("msync", "mapping");
+        }
+    }
+
+    void swap(mmap_span& rhs) noexcept {
+        mystl::swap(base_, rhs.base_);
+        mystl::swap(mapped_, rhs.mapped_);
+        mystl::swap(data_, rhs.data_);
+        mystl::swap(size_, rhs.size_);
+    }
+
+private:
+    void map(int fd, size_type file_size, size_type offset, const char* path) {
+        if (offset > file_size || offset % alignof(T) != 0 ||
+            (file_size - offset) % sizeof(T) != 0) {
+            throw std::runtime_error(
+                std::string("mmap_span: size of ") + path +
+                " does not match the element type");
+        }
+        if (file_size == 0) {
+            return;
+        }
+        const int prot = is_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* addr = ::mmap(nullptr, file_size, prot, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            throw_errno("mmap", path);
+        }
+        base_ = addr;
+        mapped_ = file_size;
+        data_ = reinterpret_cast<T*>(static_cast<char*>(addr) + offset);
+        size_ = (file_size - offset) / sizeof(T);
+    }
+
+    void unmap() noexcept {
+        if (base_ != nullptr) {
+            ::munmap(base_, mapped_);
+        }
+        base_ = nullptr;
+        mapped_ = 0;
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void take(mmap_span& rhs) noexcept {
+        base_ = rhs.base_;
+        mapped_ = rhs.mapped_;
+        data_ = rhs.data_;
+        size_ = rhs.size_;
+        rhs.base_ = nullptr;
+        rhs.mapped_ = 0;
+        rhs.data_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    void check_index(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range(
+                "mmap_span<T>::at() subscript out of range");
+        }
+    }
+
+    static int to_native(mmap_advice advice) noexcept {
+        switch (advice) {
+            case mmap_advice::sequential:
+                return MADV_SEQUENTIAL;
+            case mmap_advice::random:
+                return MADV_RANDOM;
+            case mmap_advice::willneed:
+                return MADV_WILLNEED;
+            case mmap_advice::dontneed:
+                return MADV_DONTNEED;
+            case mmap_advice::hugepage:
+#ifdef MADV_HUGEPAGE
+                return MADV_HUGEPAGE;
+#else
+                return MADV_NORMAL;
+#endif
+            default:
+                return MADV_NORMAL;
+        }
+    }
+
+    [[noreturn]] static void throw_errno(const char* what, const char* path,
+                                         int err = errno) {
+        throw std::system_error(err, std::generic_category(),
+                                std::string("mmap_span: ") + what + " " +
+                                    path);
+    }
+};
+
+template <typename T>
+void swap(mmap_span<T>& lhs, mmap_span<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 只读的映射，元素不能修改
+template <typename T>
+using mmap_vector = mmap_span<const T>;
+
+}  // namespace mystl
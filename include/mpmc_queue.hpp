@@ -0,0 +1,218 @@
+#pragma once
+
+// 这个头文件包含一个模板类 mpmc_queue
+// mpmc_queue : 有界无锁环形队列，仿照 Dmitry Vyukov 的 bounded MPMC queue，
+//              每个槽位带一个序号，生产者和消费者通过序号判断槽位是否可用
+// 模板参数 MultiProducer / MultiConsumer 为 false 时，对应一端只有一个线程，
+// 申请位置时直接写入计数器而不使用 CAS 循环
+// spsc_queue : 单生产者单消费者
+// mpsc_queue : 多生产者单消费者
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 模板类 mpmc_queue
+// 模板参数分别代表数据类型、是否有多个生产者、是否有多个消费者和空间配置器
+// 元素在槽位上原地构造，要求 T 的移动构造、移动赋值和析构不抛出异常
+template <typename T, bool MultiProducer = true, bool MultiConsumer = true,
+          typename Alloc = mystl::allocator<T>>
+class mpmc_queue {
+    static_assert(std::is_nothrow_move_constructible_v<T> &&
+                      std::is_nothrow_move_assignable_v<T> &&
+                      std::is_nothrow_destructible_v<T>,
+                  "mpmc_queue requires nothrow move and destruction");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using allocator_type = Alloc;
+
+    static constexpr size_type kCacheLine = 64;
+
+private:
+    // 槽位：序号 seq 等于位置 pos 时可写，等于 pos + 1 时可读
+    struct cell {
+        std::atomic<size_type> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* ptr() noexcept { return reinterpret_cast<T*>(storage); }
+    };
+
+    using cell_allocator = typename Alloc::template rebind<cell>::other;
+
+    // 生产者和消费者的位置各占一条缓存行，避免伪共享
+    alignas(kCacheLine) std::atomic<size_type> enqueue_pos_{0};
+    alignas(kCacheLine) std::atomic<size_type> dequeue_pos_{0};
+    alignas(kCacheLine) cell* cells_ = nullptr;
+    size_type mask_ = 0;
+    [[no_unique_address]] Alloc alloc_;
+
+public:
+    // 容量向上取整为 2 的幂，至少为 2
+    explicit mpmc_queue(size_type capacity, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        size_type cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        mask_ = cap - 1;
+        cells_ = cell_allocator(alloc_).allocate(cap);
+        for (size_type i = 0; i < cap; ++i) {
+            ::new (static_cast<void*>(&cells_[i].seq))
+                std::atomic<size_type>(i);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() {
+        // 析构时不会再有并发访问，直接析构剩余的元素
+        const auto tail = enqueue_pos_.load(std::memory_order_relaxed);
+        for (auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+             pos != tail; ++pos) {
+            mystl::destory(cells_[pos & mask_].ptr());
+        }
+        cell_allocator(alloc_).deallocate(cells_, mask_ + 1);
+    }
+
+public:
+    size_type capacity() const noexcept { return mask_ + 1; }
+
+    // 并发访问时只是一个近似值
+    size_type size_approx() const noexcept {
+        const auto head = dequeue_pos_.load(std::memory_order_relaxed);
+        const auto tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    // 在队尾构造一个元素，队列已满时返回 false
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            size_type pos;
+            if (claim<MultiProducer>(enqueue_pos_, 1, 0, pos) == 0) {
+                return false;
+            }
+            cell& c = cells_[pos & mask_];
+            mystl::construct(c.ptr(), mystl::forward<Args>(args)...);
+            c.seq.store(pos + 1, std::memory_order_release);
+            return true;
+        } else {
+            // 构造可能抛出异常，先在队列外构造好，避免申请到的槽位无法发布
+            T tmp(mystl::forward<Args>(args)...);
+            return try_emplace(mystl::move(tmp));
+        }
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(mystl::move(value)); }
+
+    // 从队头取出一个元素移动赋值给 out，队列为空时返回 false
+    bool try_pop(T& out) noexcept {
+        size_type pos;
+        if (claim<MultiConsumer>(dequeue_pos_, 1, 1, pos) == 0) {
+            return false;
+        }
+        release(pos, out);
+        return true;
+    }
+
+    // 从 first 开始最多放入 n 个元素，返回实际放入的个数
+    // 一次申请一段连续的槽位，多生产者时只需要一次 CAS
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    size_type push_n(Iter first, size_type n) {
+        if constexpr (!std::is_nothrow_constructible_v<T, decltype(*first)>) {
+            // 复制可能抛出异常时退化为逐个放入
+            size_type count = 0;
+            for (; count < n && try_emplace(*first); ++count, ++first) {
+            }
+            return count;
+        } else {
+            size_type pos;
+            const size_type count =
+                claim<MultiProducer>(enqueue_pos_, n, 0, pos);
+            for (size_type i = 0; i < count; ++i, ++first) {
+                cell& c = cells_[(pos + i) & mask_];
+                mystl::construct(c.ptr(), *first);
+                c.seq.store(pos + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+    }
+
+    // 最多取出 n 个元素依次写入 out，返回实际取出的个数，对 out 的赋值不能抛出异常
+    template <typename OutputIter>
+    size_type pop_n(OutputIter out, size_type n) {
+        size_type pos;
+        const size_type count = claim<MultiConsumer>(dequeue_pos_, n, 1, pos);
+        for (size_type i = 0; i < count; ++i, ++out) {
+            release(pos + i, *out);
+        }
+        return count;
+    }
+
+private:
+    // 从 counter 处申请最多 n 个连续位置，位置 p 可用的条件是 seq == p + offset
+    // 返回申请到的个数，起始位置写入 start；队列满 (或空) 时返回 0
+    template <bool Multi>
+    size_type claim(std::atomic<size_type>& counter, size_type n,
+                    size_type offset, size_type& start) noexcept {
+        auto pos = counter.load(std::memory_order_relaxed);
+        for (;;) {
+            size_type k = 0;
+            while (k < n && seq_at(pos + k) == pos + k + offset) {
+                ++k;
+            }
+            if (k == 0) {
+                const auto seq = seq_at(pos);
+                if (static_cast<std::intptr_t>(seq - (pos + offset)) < 0) {
+                    return 0;
+                }
+                // 其他线程已经越过了这个位置，重新读取计数器
+                pos = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+            if constexpr (Multi) {
+                if (!counter.compare_exchange_weak(pos, pos + k,
+                                                   std::memory_order_relaxed)) {
+                    continue;
+                }
+            } else {
+                counter.store(pos + k, std::memory_order_relaxed);
+            }
+            start = pos;
+            return k;
+        }
+    }
+
+    size_type seq_at(size_type pos) const noexcept {
+        return cells_[pos & mask_].seq.load(std::memory_order_acquire);
+    }
+
+    // 取出位置 pos 上的元素，并把槽位交还给下一轮的生产者
+    template <typename Out>
+    void release(size_type pos, Out&& out) {
+        cell& c = cells_[pos & mask_];
+        out = mystl::move(*c.ptr());
+        mystl::destory(c.ptr());
+        c.seq.store(pos + mask_ + 1, std::memory_order_release);
+    }
+};
+
+template <typename T, typename Alloc = mystl::allocator<T>>
+using spsc_queue = mpmc_queue<T, false, false, Alloc>;
+
+template <typename T, typename Alloc = mystl::allocator<T>>
+using mpsc_queue = mpmc_queue<T, true, false, Alloc>;
+
+}  // namespace mystl
@@ -0,0 +1,85 @@
+#pragma once
+
+// 这个头文件包含一些数值算法
+// accumulate : 以初值 init 对 [first, last) 区间内的元素进行累积
+// reduce     : 与 accumulate 相同，但不保证累积的顺序，要求操作满足结合律和交换律
+// 连续迭代器上的整数且初值类型与元素相同时，交给 simd.hpp 中的 SIMD 内核求和；
+// 浮点数求和改变顺序会改变结果，仍然按顺序逐个累加
+
+#include <type_traits>
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "simd.hpp"
+
+namespace mystl {
+
+/*****************************************************************************************/
+// accumulate
+// 版本1：以初值 init 对每个元素进行累加
+// 版本2：以初值 init 对每个元素进行二元操作
+/*****************************************************************************************/
+
+template <typename InputIter, typename T>
+T accumulate_dispatch(InputIter first, InputIter last, T init,
+                      input_iterator_tag) {
+    for (; first != last; ++first) {
+        init = init + *first;
+    }
+    return init;
+}
+
+template <typename RandomIter, typename T>
+T accumulate_dispatch(RandomIter first, RandomIter last, T init,
+                      random_access_iterator_tag) {
+    using E = typename iterator_traits<RandomIter>::value_type;
+    if constexpr (is_simd_iterator_v<RandomIter> && std::is_integral_v<E> &&
+                  std::is_same_v<E, T>) {
+        using U = simd_detail::sum_type<T>;
+        const E* p = mystl::to_address(first);
+        return static_cast<T>(
+            static_cast<U>(init) +
+            static_cast<U>(simd_detail::sum<E>(p, p + (last - first))));
+    } else {
+        return accumulate_dispatch(first, last, init, input_iterator_tag());
+    }
+}
+
+template <typename InputIter, typename T>
+T accumulate(InputIter first, InputIter last, T init) {
+    return accumulate_dispatch(first, last, init, iterator_category(first));
+}
+
+template <typename InputIter, typename T, typename BinaryOp>
+T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    for (; first != last; ++first) {
+        init = binary_op(init, *first);
+    }
+    return init;
+}
+
+/*****************************************************************************************/
+// reduce
+// 版本1：以元素类型的值初始化结果，对每个元素进行累加
+// 版本2：以初值 init 对每个元素进行累加
+// 版本3：以初值 init 对每个元素进行二元操作
+/*****************************************************************************************/
+
+template <typename InputIter, typename T, typename BinaryOp>
+T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    return mystl::accumulate(first, last, init, binary_op);
+}
+
+template <typename InputIter, typename T>
+T reduce(InputIter first, InputIter last, T init) {
+    return mystl::accumulate(first, last, init);
+}
+
+template <typename InputIter>
+typename iterator_traits<InputIter>::value_type reduce(InputIter first,
+                                                       InputIter last) {
+    return mystl::reduce(first, last,
+                         typename iterator_traits<InputIter>::value_type{});
+}
+
+}  // namespace mystl
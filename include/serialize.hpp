@@ -0,0 +1,561 @@
+#pragma once
+
+// 这个头文件包含二进制序列化的相关组件
+// binary_writer / binary_reader : 带固定大小缓冲区的输出 / 输入流，
+//                                 超过缓冲区大小的数据绕过缓冲区直接读写
+// file_sink / file_source       : 基于文件描述符的输出端 / 输入端
+// memory_sink / memory_source   : 基于内存的输出端 / 输入端
+// serialize / deserialize       : 可平凡复制的类型按字节整块写出，
+//                                 mystl::pair 递归处理两个成员，
+//                                 容器先写元素个数再写元素，连续存放的平凡元素只写一次
+// serialize_chunk / deserialize_chunks : 分块的流式格式，每块先写元素个数，
+//                                 以 0 结束，读取时只需要一块大小的内存
+// 多字节整数按本机字节序写出，数据只在同一种机器之间交换
+// 其他类型可以特化 serializer<T> 提供静态成员函数 write / read
+// 输入端提供 remaining() 时，读取容器前先用剩余字节数检查元素个数，
+// 损坏或伪造的长度不会引起巨大的内存分配
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "type_traits.hpp"
+#include "util.hpp"
+#include "vector.hpp"
+
+namespace mystl {
+
+/*****************************************************************************************/
+// 输出端与输入端
+// 输出端提供 write(const void*, size_t)，写入失败时抛出异常
+// 输入端提供 read(void*, size_t)，返回实际读到的字节数，读到结尾时返回 0
+/*****************************************************************************************/
+
+namespace serialize_detail {
+
+[[noreturn]] inline void throw_errno(const char* what, const char* path) {
+    throw std::system_error(errno, std::generic_category(),
+                            std::string(what) + " " + path);
+}
+
+// 只能移动的文件描述符
+class file_handle {
+protected:
+    int fd_ = -1;
+
+    file_handle(const char* path, int flags) {
+        fd_ = ::open(path, flags, 0644);
+        if (fd_ < 0) {
+            throw_errno("open", path);
+        }
+    }
+
+    file_handle(file_handle&& rhs) noexcept : fd_(rhs.fd_) { rhs.fd_ = -1; }
+    file_handle& operator=(file_handle&& rhs) noexcept {
+        if (this != &rhs) {
+            close();
+            fd_ = rhs.fd_;
+            rhs.fd_ = -1;
+        }
+        return *this;
+    }
+
+    ~file_handle() { close(); }
+
+    void close() noexcept {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+};
+
+}  // namespace serialize_detail
+
+class file_sink : private serialize_detail::file_handle {
+public:
+    explicit file_sink(const char* path)
+        : file_handle(path, O_WRONLY | O_CREAT | O_TRUNC) {}
+    explicit file_sink(const std::string& path) : file_sink(path.c_str()) {}
+
+    file_sink(file_sink&&) noexcept = default;
+    file_sink& operator=(file_sink&&) noexcept = default;
+
+    void write(const void* data, size_t n) {
+        const char* p = static_cast<const char*>(data);
+        while (n > 0) {
+            const ssize_t written = ::write(fd_, p, n);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                serialize_detail::throw_errno("write", "file_sink");
+            }
+            p += written;
+            n -= static_cast<size_t>(written);
+        }
+    }
+};
+
+class file_source : private serialize_detail::file_handle {
+public:
+    explicit file_source(const char* path) : file_handle(path, O_RDONLY) {}
+    explicit file_source(const std::string& path)
+        : file_source(path.c_str()) {}
+
+    file_source(file_source&&) noexcept = default;
+    file_source& operator=(file_source&&) noexcept = default;
+
+    // 普通文件返回剩余的字节数，管道等无法得知时返回 UINT64_MAX
+    uint64_t remaining() const {
+        struct stat st;
+        const off_t pos = ::lseek(fd_, 0, SEEK_CUR);
+        if (pos < 0 || ::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode) ||
+            st.st_size < pos) {
+            return UINT64_MAX;
+        }
+        return static_cast<uint64_t>(st.st_size - pos);
+    }
+
+    size_t read(void* data, size_t n) {
+        for (;;) {
+            const ssize_t got = ::read(fd_, data, n);
+            if (got >= 0) {
+                return static_cast<size_t>(got);
+            }
+            if (errno != EINTR) {
+                serialize_detail::throw_errno("read", "file_source");
+            }
+        }
+    }
+};
+
+// 追加到一个 mystl::vector<char> 的末尾
+class memory_sink {
+    mystl::vector<char>* out_;
+
+public:
+    explicit memory_sink(mystl::vector<char>& out) : out_(&out) {}
+
+    void write(const void* data, size_t n) {
+        const char* p = static_cast<const char*>(data);
+        out_->insert(out_->end(), p, p + n);
+    }
+};
+
+// 从一段内存中读取，例如 mmap_span 映射的文件
+class memory_source {
+    const char* cur_;
+    const char* end_;
+
+public:
+    memory_source(const void* data, size_t n)
+        : cur_(static_cast<const char*>(data)), end_(cur_ + n) {}
+
+    size_t read(void* data, size_t n) {
+        const size_t rest = static_cast<size_t>(end_ - cur_);
+        if (n > rest) {
+            n = rest;
+        }
+        if (n != 0) {
+            std::memcpy(data, cur_, n);
+        }
+        cur_ += n;
+        return n;
+    }
+
+    uint64_t remaining() const { return static_cast<uint64_t>(end_ - cur_); }
+};
+
+/*****************************************************************************************/
+// binary_writer / binary_reader
+/*****************************************************************************************/
+
+inline constexpr size_t kDefaultStreamBuffer = 64 * 1024;
+
+// 模板类：binary_writer
+// 小块数据先拷贝到缓冲区，缓冲区满了才交给 Sink，每次调用 Sink 都是一整块
+template <typename Sink>
+class binary_writer {
+    Sink sink_;
+    char* buf_;
+    size_t cap_;
+    size_t len_ = 0;
+    uint64_t written_ = 0;
+
+public:
+    explicit binary_writer(Sink sink, size_t buffer_size = kDefaultStreamBuffer)
+        : sink_(mystl::move(sink)),
+          buf_(mystl::allocator<char>::allocate(buffer_size)),
+          cap_(buffer_size) {}
+
+    binary_writer(const binary_writer&) = delete;
+    binary_writer& operator=(const binary_writer&) = delete;
+
+    // 析构时写出缓冲区中剩下的数据，需要得知写入错误时应先显式调用 flush
+    ~binary_writer() {
+        try {
+            flush();
+        } catch (...) {
+        }
+        mystl::allocator<char>::deallocate(buf_, cap_);
+    }
+
+    void write_bytes(const void* data, size_t n) {
+        if (n == 0) {
+            return;  // 空容器的 data() 可能是空指针
+        }
+        written_ += n;
+        if (n <= cap_ - len_) {
+            std::memcpy(buf_ + len_, data, n);
+            len_ += n;
+            return;
+        }
+        flush();
+        if (n >= cap_) {
+            sink_.write(data, n);
+        } else {
+            std::memcpy(buf_, data, n);
+            len_ = n;
+        }
+    }
+
+    void flush() {
+        if (len_ != 0) {
+            const size_t n = len_;
+            len_ = 0;
+            sink_.write(buf_, n);
+        }
+    }
+
+    uint64_t bytes_written() const noexcept { return written_; }
+    Sink& sink() noexcept { return sink_; }
+};
+
+// 模板类：binary_reader
+// 每次从 Source 读取一整个缓冲区，较大的读取请求直接读入目标位置
+template <typename Source>
+class binary_reader {
+    Source source_;
+    char* buf_;
+    size_t cap_;
+    size_t pos_ = 0;
+    size_t end_ = 0;
+
+public:
+    explicit binary_reader(Source source,
+                           size_t buffer_size = kDefaultStreamBuffer)
+        : source_(mystl::move(source)),
+          buf_(mystl::allocator<char>::allocate(buffer_size)),
+          cap_(buffer_size) {}
+
+    binary_reader(const binary_reader&) = delete;
+    binary_reader& operator=(const binary_reader&) = delete;
+
+    ~binary_reader() { mystl::allocator<char>::deallocate(buf_, cap_); }
+
+    // 读取 n 个字节，数据不足时抛出 std::runtime_error
+    void read_bytes(void* data, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        char* out = static_cast<char*>(data);
+        for (;;) {
+            const size_t avail = end_ - pos_;
+            if (n <= avail) {
+                std::memcpy(out, buf_ + pos_, n);
+                pos_ += n;
+                return;
+            }
+            std::memcpy(out, buf_ + pos_, avail);
+            out += avail;
+            n -= avail;
+            pos_ = end_ = 0;
+            if (n >= cap_) {
+                read_direct(out, n);
+                return;
+            }
+            end_ = source_.read(buf_, cap_);
+            if (end_ == 0) {
+                throw_truncated();
+            }
+        }
+    }
+
+    // 是否已经没有数据可读
+    bool at_end() {
+        if (pos_ == end_) {
+            pos_ = 0;
+            end_ = source_.read(buf_, cap_);
+        }
+        return pos_ == end_;
+    }
+
+    // 还能读取的字节数，Source 不提供 remaining() 或者无法得知时返回 UINT64_MAX
+    uint64_t remaining() const {
+        if constexpr (requires(const Source& src) { src.remaining(); }) {
+            const uint64_t rest = source_.remaining();
+            return rest == UINT64_MAX ? rest : rest + (end_ - pos_);
+        } else {
+            return UINT64_MAX;
+        }
+    }
+
+    Source& source() noexcept { return source_; }
+
+private:
+    void read_direct(char* out, size_t n) {
+        while (n > 0) {
+            const size_t got = source_.read(out, n);
+            if (got == 0) {
+                throw_truncated();
+            }
+            out += got;
+            n -= got;
+        }
+    }
+
+    [[noreturn]] static void throw_truncated() {
+        throw std::runtime_error("binary_reader: unexpected end of input");
+    }
+};
+
+/*****************************************************************************************/
+// serialize / deserialize
+/*****************************************************************************************/
+
+// 用户可以为自己的类型特化 serializer，提供
+// static void write(Writer&, const T&) 和 static void read(Reader&, T&)
+template <typename T>
+struct serializer;
+
+// 可以按字节整块读写的类型
+template <typename T>
+inline constexpr bool is_bulk_serializable_v =
+    std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+    !std::is_member_pointer_v<T>;
+
+namespace serialize_detail {
+
+template <typename T>
+inline constexpr bool always_false_v = false;
+
+template <typename T, typename Writer>
+concept has_serializer = requires(Writer& w, const T& value) {
+    serializer<T>::write(w, value);
+};
+
+template <typename T, typename Reader>
+concept has_deserializer = requires(Reader& r, T& value) {
+    serializer<T>::read(r, value);
+};
+
+template <typename C>
+concept sized_range = requires(const C& c) {
+    typename C::value_type;
+    c.begin();
+    c.end();
+    c.size();
+};
+
+// 元素连续存放，可以通过 data() 整块读写
+template <typename C>
+concept contiguous_range = sized_range<C> && requires(const C& c) {
+    { c.data() } -> std::convertible_to<const typename C::value_type*>;
+};
+
+// 输入剩余的字节数，Reader 无法得知时返回 UINT64_MAX
+template <typename Reader>
+uint64_t remaining_of(const Reader& r) {
+    if constexpr (requires { r.remaining(); }) {
+        return r.remaining();
+    } else {
+        return UINT64_MAX;
+    }
+}
+
+// 读取容器的元素个数，每个元素至少占 min_bytes 字节
+// 个数超出剩余输入或者字节数会溢出时抛出异常，不按这个长度分配内存
+template <typename Reader>
+size_t read_length(Reader& r, size_t min_bytes) {
+    uint64_t n = 0;
+    r.read_bytes(&n, sizeof(n));
+    const size_t unit = min_bytes == 0 ? 1 : min_bytes;
+    if (n > SIZE_MAX / unit ||
+        (min_bytes != 0 && n > remaining_of(r) / min_bytes)) {
+        throw std::runtime_error(
+            "deserialize: element count exceeds the remaining input");
+    }
+    return static_cast<size_t>(n);
+}
+
+// 关联容器的 value_type 是 pair<const Key, T>
+template <typename V>
+inline constexpr bool is_map_value_v = [] {
+    if constexpr (is_pair<std::remove_cv_t<V>>::value) {
+        return std::is_const_v<typename V::first_type>;
+    } else {
+        return false;
+    }
+}();
+
+}  // namespace serialize_detail
+
+template <typename Writer, typename T>
+void serialize(Writer& w, const T& value) {
+    using namespace serialize_detail;
+    if constexpr (has_serializer<T, Writer>) {
+        serializer<T>::write(w, value);
+    } else if constexpr (is_bulk_serializable_v<T>) {
+        w.write_bytes(&value, sizeof(T));
+    } else if constexpr (std::is_array_v<T>) {
+        for (const auto& elem : value) {
+            mystl::serialize(w, elem);
+        }
+    } else if constexpr (is_pair<T>::value) {
+        mystl::serialize(w, value.first);
+        mystl::serialize(w, value.second);
+    } else if constexpr (sized_range<T>) {
+        using V = typename T::value_type;
+        const uint64_t n = value.size();
+        w.write_bytes(&n, sizeof(n));
+        if constexpr (contiguous_range<T> && is_bulk_serializable_v<V>) {
+            w.write_bytes(value.data(), n * sizeof(V));
+        } else {
+            for (const auto& elem : value) {
+                mystl::serialize(w, elem);
+            }
+        }
+    } else {
+        static_assert(always_false_v<T>, "type is not serializable");
+    }
+}
+
+template <typename Reader, typename T>
+void deserialize(Reader& r, T& value) {
+    using namespace serialize_detail;
+    if constexpr (has_deserializer<T, Reader>) {
+        serializer<T>::read(r, value);
+    } else if constexpr (is_bulk_serializable_v<T>) {
+        r.read_bytes(&value, sizeof(T));
+    } else if constexpr (std::is_array_v<T>) {
+        for (auto& elem : value) {
+            mystl::deserialize(r, elem);
+        }
+    } else if constexpr (is_pair<T>::value) {
+        mystl::deserialize(r, value.first);
+        mystl::deserialize(r, value.second);
+    } else if constexpr (sized_range<T>) {
+        using V = typename T::value_type;
+        value.clear();
+        if constexpr (contiguous_range<T> && is_bulk_serializable_v<V> &&
+                      requires(size_t k) { value.resize(k); }) {
+            const size_t n = read_length(r, sizeof(V));
+            value.resize(n);
+            r.read_bytes(value.data(), n * sizeof(V));
+        } else {
+            // 元素序列化后的最小长度未知，预留的空间不超过剩余的字节数
+            const size_t n = read_length(r, 0);
+            if constexpr (requires(size_t k) { value.reserve(k); }) {
+                const uint64_t rest = remaining_of(r);
+                value.reserve(n < rest ? n : static_cast<size_t>(rest));
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if constexpr (is_map_value_v<V>) {
+                    std::remove_const_t<typename V::first_type> key{};
+                    typename V::second_type mapped{};
+                    mystl::deserialize(r, key);
+                    mystl::deserialize(r, mapped);
+                    value.emplace(mystl::move(key), mystl::move(mapped));
+                } else {
+                    V elem{};
+                    mystl::deserialize(r, elem);
+                    if constexpr (requires { value.push_back(elem); }) {
+                        value.push_back(mystl::move(elem));
+                    } else {
+                        value.emplace(mystl::move(elem));
+                    }
+                }
+            }
+        }
+    } else {
+        static_assert(always_false_v<T>, "type is not deserializable");
+    }
+}
+
+template <typename T, typename Reader>
+T deserialize(Reader& r) {
+    T value{};
+    mystl::deserialize(r, value);
+    return value;
+}
+
+/*****************************************************************************************/
+// 分块的流式格式
+// [n1][n1 个元素][n2][n2 个元素]...[0]
+// 写入时不需要事先知道元素总数，读取时每次只把一块放在内存中
+/*****************************************************************************************/
+
+// 写出 [first, last) 作为一块，连续迭代器上可平凡复制的元素整块写出
+template <typename Writer, typename Iter>
+void serialize_chunk(Writer& w, Iter first, Iter last) {
+    const uint64_t n = static_cast<uint64_t>(mystl::distance(first, last));
+    if (n == 0) {
+        return;  // 0 是结束标记
+    }
+    w.write_bytes(&n, sizeof(n));
+    using V = typename iterator_traits<Iter>::value_type;
+    if constexpr (is_contiguous_iterator_v<Iter> && is_bulk_serializable_v<V>) {
+        w.write_bytes(mystl::to_address(first), n * sizeof(V));
+    } else {
+        for (; first != last; ++first) {
+            mystl::serialize(w, *first);
+        }
+    }
+}
+
+template <typename Writer>
+void serialize_end(Writer& w) {
+    const uint64_t zero = 0;
+    w.write_bytes(&zero, sizeof(zero));
+}
+
+// 依次读取每一块并调用 fn(const T* data, size_t n)，返回元素总数
+// 读取每块时复用同一个缓冲区
+template <typename T, typename Reader, typename Fn>
+uint64_t deserialize_chunks(Reader& r, Fn&& fn) {
+    mystl::vector<T> chunk;
+    uint64_t total = 0;
+    for (;;) {
+        const size_t n = serialize_detail::read_length(
+            r, is_bulk_serializable_v<T> ? sizeof(T) : 0);
+        if (n == 0) {
+            return total;
+        }
+        if constexpr (is_bulk_serializable_v<T>) {
+            chunk.resize(n);
+            r.read_bytes(chunk.data(), n * sizeof(T));
+        } else {
+            chunk.clear();
+            for (size_t i = 0; i < n; ++i) {
+                T elem{};
+                mystl::deserialize(r, elem);
+                chunk.push_back(mystl::move(elem));
+            }
+        }
+        fn(static_cast<const T*>(chunk.data()), chunk.size());
+        total += n;
+    }
+}
+
+}  // namespace mystl
@@ -0,0 +1,609 @@
+#pragma once
+
+// 这个头文件包含算法使用的 SIMD 内核，只处理连续存放的算术类型
+// 运行时检测 CPU 是否支持 AVX2，不支持时使用 SSE2 (x86-64 的基础指令集)，
+// 其他平台使用标量循环
+// AVX2 内核通过 target 属性单独编译，不要求整个程序开启 -mavx2
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define MYSTL_SIMD_AVX2 1
+#define MYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#else
+#define MYSTL_SIMD_AVX2 0
+#endif
+
+namespace mystl {
+
+namespace simd_detail {
+
+// 可以使用 SIMD 内核的元素类型：1、2、4、8 字节的整数以及 float、double
+template <typename T>
+inline constexpr bool is_simd_type_v =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// 按字节的比较掩码中，每个元素只保留其首字节对应的位
+template <size_t Size>
+constexpr uint32_t first_byte_bits(uint32_t mask) noexcept {
+    if constexpr (Size == 1) {
+        return mask;
+    } else if constexpr (Size == 2) {
+        return mask & 0x55555555u;
+    } else if constexpr (Size == 4) {
+        return mask & 0x11111111u;
+    } else {
+        return mask & 0x01010101u;
+    }
+}
+
+// 整数求和按无符号数回绕，避免有符号溢出
+template <typename T>
+using sum_type = std::conditional_t<std::is_integral_v<T>,
+                                    std::make_unsigned_t<T>, T>;
+
+/*****************************************************************************************/
+// 标量版本，也用于处理 SIMD 循环剩下的尾部
+/*****************************************************************************************/
+
+template <typename T>
+const T* find_scalar(const T* first, const T* last, T value) noexcept {
+    for (; first != last; ++first) {
+        if (*first == value) {
+            break;
+        }
+    }
+    return first;
+}
+
+template <typename T>
+size_t count_scalar(const T* first, const T* last, T value) noexcept {
+    size_t n = 0;
+    for (; first != last; ++first) {
+        n += *first == value;
+    }
+    return n;
+}
+
+// 返回第一个不相等元素的下标，全部相等时返回 n
+template <typename T>
+size_t mismatch_scalar(const T* a, const T* b, size_t n) noexcept {
+    size_t i = 0;
+    for (; i < n; ++i) {
+        if (!(a[i] == b[i])) {
+            break;
+        }
+    }
+    return i;
+}
+
+template <typename T>
+const T* min_scalar(const T* first, const T* last) noexcept {
+    const T* result = first;
+    for (; first != last; ++first) {
+        if (*first < *result) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+const T* max_scalar(const T* first, const T* last) noexcept {
+    const T* result = first;
+    for (; first != last; ++first) {
+        if (*result < *first) {
+            result = first;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+T sum_scalar(const T* first, const T* last) noexcept {
+    sum_type<T> sum = 0;
+    for (; first != last; ++first) {
+        sum += static_cast<sum_type<T>>(*first);
+    }
+    return static_cast<T>(sum);
+}
+
+template <typename T>
+void fill_scalar(T* first, T* last, T value) noexcept {
+    for (; first != last; ++first) {
+        *first = value;
+    }
+}
+
+/*****************************************************************************************/
+// SSE2 版本，每次处理 16 字节
+/*****************************************************************************************/
+
+#if defined(__SSE2__)
+
+template <typename T>
+__m128i broadcast_sse2(T value) noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm_castps_si128(_mm_set1_ps(value));
+    } else if constexpr (std::is_same_v<T, double>) {
+        return _mm_castpd_si128(_mm_set1_pd(value));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm_set1_epi8(static_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_set1_epi16(static_cast<short>(value));
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm_set1_epi32(static_cast<int>(value));
+    } else {
+        return _mm_set1_epi64x(static_cast<long long>(value));
+    }
+}
+
+inline __m128i load_sse2(const void* ptr) noexcept {
+    return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+
+// 逐个元素比较是否相等，返回按元素的位掩码
+template <typename T>
+uint32_t eq_bits_sse2(__m128i a, __m128i b) noexcept {
+    uint32_t mask;
+    if constexpr (std::is_same_v<T, float>) {
+        mask = _mm_movemask_epi8(_mm_castps_si128(
+            _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))));
+    } else if constexpr (std::is_same_v<T, double>) {
+        mask = _mm_movemask_epi8(_mm_castpd_si128(
+            _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))));
+    } else if constexpr (sizeof(T) == 1) {
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+    } else if constexpr (sizeof(T) == 2) {
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi16(a, b));
+    } else if constexpr (sizeof(T) == 4) {
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi32(a, b));
+    } else {
+        // SSE2 没有 64 位整数比较，两个 32 位的半边都相等才算相等
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi32(a, b));
+        mask &= mask >> 4;
+    }
+    return first_byte_bits<sizeof(T)>(mask);
+}
+
+template <typename T>
+__m128i add_sse2(__m128i a, __m128i b) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm_add_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_add_epi16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm_add_epi32(a, b);
+    } else {
+        return _mm_add_epi64(a, b);
+    }
+}
+
+template <typename T>
+const T* find_sse2(const T* first, const T* last, T value) noexcept {
+    constexpr size_t kLanes = 16 / sizeof(T);
+    const __m128i v = broadcast_sse2(value);
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        const uint32_t bits = eq_bits_sse2<T>(load_sse2(first), v);
+        if (bits != 0) {
+            return first + std::countr_zero(bits) / sizeof(T);
+        }
+    }
+    return find_scalar(first, last, value);
+}
+
+template <typename T>
+size_t count_sse2(const T* first, const T* last, T value) noexcept {
+    constexpr size_t kLanes = 16 / sizeof(T);
+    const __m128i v = broadcast_sse2(value);
+    size_t n = 0;
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        n += std::popcount(eq_bits_sse2<T>(load_sse2(first), v));
+    }
+    return n + count_scalar(first, last, value);
+}
+
+template <typename T>
+size_t mismatch_sse2(const T* a, const T* b, size_t n) noexcept {
+    constexpr size_t kLanes = 16 / sizeof(T);
+    constexpr uint32_t kAll = first_byte_bits<sizeof(T)>(0xFFFFu);
+    size_t i = 0;
+    for (; n - i >= kLanes; i += kLanes) {
+        const uint32_t ne =
+            ~eq_bits_sse2<T>(load_sse2(a + i), load_sse2(b + i)) & kAll;
+        if (ne != 0) {
+            return i + std::countr_zero(ne) / sizeof(T);
+        }
+    }
+    return i + mismatch_scalar(a + i, b + i, n - i);
+}
+
+template <typename T>
+T sum_sse2(const T* first, const T* last) noexcept {
+    constexpr size_t kLanes = 16 / sizeof(T);
+    __m128i acc = _mm_setzero_si128();
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        acc = add_sse2<T>(acc, load_sse2(first));
+    }
+    T lanes[kLanes];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return static_cast<T>(
+        static_cast<sum_type<T>>(sum_scalar(lanes, lanes + kLanes)) +
+        static_cast<sum_type<T>>(sum_scalar(first, last)));
+}
+
+template <typename T>
+void fill_sse2(T* first, T* last, T value) noexcept {
+    constexpr size_t kLanes = 16 / sizeof(T);
+    const __m128i v = broadcast_sse2(value);
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first), v);
+    }
+    fill_scalar(first, last, value);
+}
+
+#endif  // __SSE2__
+
+/*****************************************************************************************/
+// AVX2 版本，每次处理 32 字节，运行时确认 CPU 支持后才会调用
+/*****************************************************************************************/
+
+#if MYSTL_SIMD_AVX2
+
+template <typename T>
+MYSTL_TARGET_AVX2 __m256i broadcast_avx2(T value) noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm256_castps_si256(_mm256_set1_ps(value));
+    } else if constexpr (std::is_same_v<T, double>) {
+        return _mm256_castpd_si256(_mm256_set1_pd(value));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm256_set1_epi8(static_cast<char>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16(static_cast<short>(value));
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_set1_epi32(static_cast<int>(value));
+    } else {
+        return _mm256_set1_epi64x(static_cast<long long>(value));
+    }
+}
+
+MYSTL_TARGET_AVX2 inline __m256i load_avx2(const void* ptr) noexcept {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 uint32_t eq_bits_avx2(__m256i a, __m256i b) noexcept {
+    __m256i eq;
+    if constexpr (std::is_same_v<T, float>) {
+        eq = _mm256_castps_si256(_mm256_cmp_ps(
+            _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    } else if constexpr (std::is_same_v<T, double>) {
+        eq = _mm256_castpd_si256(_mm256_cmp_pd(
+            _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    } else if constexpr (sizeof(T) == 1) {
+        eq = _mm256_cmpeq_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+        eq = _mm256_cmpeq_epi16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+        eq = _mm256_cmpeq_epi32(a, b);
+    } else {
+        eq = _mm256_cmpeq_epi64(a, b);
+    }
+    return first_byte_bits<sizeof(T)>(
+        static_cast<uint32_t>(_mm256_movemask_epi8(eq)));
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 __m256i add_avx2(__m256i a, __m256i b) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_add_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_add_epi16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_add_epi32(a, b);
+    } else {
+        return _mm256_add_epi64(a, b);
+    }
+}
+
+// 是否有 AVX2 的 min / max 指令 (64 位整数没有)
+template <typename T>
+inline constexpr bool has_minmax_avx2_v =
+    std::is_floating_point_v<T> || sizeof(T) <= 4;
+
+template <typename T, bool Max>
+MYSTL_TARGET_AVX2 __m256i minmax_op_avx2(__m256i a, __m256i b) noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 x = _mm256_castsi256_ps(a);
+        const __m256 y = _mm256_castsi256_ps(b);
+        return _mm256_castps_si256(Max ? _mm256_max_ps(x, y)
+                                       : _mm256_min_ps(x, y));
+    } else if constexpr (std::is_same_v<T, double>) {
+        const __m256d x = _mm256_castsi256_pd(a);
+        const __m256d y = _mm256_castsi256_pd(b);
+        return _mm256_castpd_si256(Max ? _mm256_max_pd(x, y)
+                                       : _mm256_min_pd(x, y));
+    } else if constexpr (sizeof(T) == 1) {
+        if constexpr (std::is_signed_v<T>) {
+            return Max ? _mm256_max_epi8(a, b) : _mm256_min_epi8(a, b);
+        } else {
+            return Max ? _mm256_max_epu8(a, b) : _mm256_min_epu8(a, b);
+        }
+    } else if constexpr (sizeof(T) == 2) {
+        if constexpr (std::is_signed_v<T>) {
+            return Max ? _mm256_max_epi16(a, b) : _mm256_min_epi16(a, b);
+        } else {
+            return Max ? _mm256_max_epu16(a, b) : _mm256_min_epu16(a, b);
+        }
+    } else {
+        if constexpr (std::is_signed_v<T>) {
+            return Max ? _mm256_max_epi32(a, b) : _mm256_min_epi32(a, b);
+        } else {
+            return Max ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b);
+        }
+    }
+}
+
+// 浮点数中是否有 NaN 的掩码
+template <typename T>
+MYSTL_TARGET_AVX2 __m256i unordered_avx2(__m256i v) noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 x = _mm256_castsi256_ps(v);
+        return _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    } else {
+        const __m256d x = _mm256_castsi256_pd(v);
+        return _mm256_castpd_si256(_mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+    }
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 const T* find_avx2(const T* first, const T* last,
+                                     T value) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    const __m256i v = broadcast_avx2(value);
+    // 每次检查两个向量，减少分支
+    for (; static_cast<size_t>(last - first) >= 2 * kLanes;
+         first += 2 * kLanes) {
+        const uint32_t lo = eq_bits_avx2<T>(load_avx2(first), v);
+        const uint32_t hi = eq_bits_avx2<T>(load_avx2(first + kLanes), v);
+        if ((lo | hi) != 0) {
+            return lo != 0 ? first + std::countr_zero(lo) / sizeof(T)
+                           : first + kLanes + std::countr_zero(hi) / sizeof(T);
+        }
+    }
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        const uint32_t bits = eq_bits_avx2<T>(load_avx2(first), v);
+        if (bits != 0) {
+            return first + std::countr_zero(bits) / sizeof(T);
+        }
+    }
+    return find_scalar(first, last, value);
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 size_t count_avx2(const T* first, const T* last,
+                                    T value) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    const __m256i v = broadcast_avx2(value);
+    size_t n = 0;
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        n += std::popcount(eq_bits_avx2<T>(load_avx2(first), v));
+    }
+    return n + count_scalar(first, last, value);
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 size_t mismatch_avx2(const T* a, const T* b,
+                                       size_t n) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    constexpr uint32_t kAll = first_byte_bits<sizeof(T)>(0xFFFFFFFFu);
+    size_t i = 0;
+    for (; n - i >= kLanes; i += kLanes) {
+        const uint32_t ne =
+            ~eq_bits_avx2<T>(load_avx2(a + i), load_avx2(b + i)) & kAll;
+        if (ne != 0) {
+            return i + std::countr_zero(ne) / sizeof(T);
+        }
+    }
+    return i + mismatch_scalar(a + i, b + i, n - i);
+}
+
+// 先用向量指令求出最值，再找到它第一次出现的位置
+// 浮点数中有 NaN 时比较结果与标量版本不同，此时退回标量版本
+template <typename T, bool Max>
+MYSTL_TARGET_AVX2 const T* minmax_avx2(const T* first,
+                                       const T* last) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    if (static_cast<size_t>(last - first) < 2 * kLanes) {
+        return Max ? max_scalar(first, last) : min_scalar(first, last);
+    }
+    const T* cur = first;
+    __m256i acc = load_avx2(cur);
+    __m256i nan = _mm256_setzero_si256();
+    for (; static_cast<size_t>(last - cur) >= kLanes; cur += kLanes) {
+        const __m256i v = load_avx2(cur);
+        acc = minmax_op_avx2<T, Max>(acc, v);
+        if constexpr (std::is_floating_point_v<T>) {
+            nan = _mm256_or_si256(nan, unordered_avx2<T>(v));
+        }
+    }
+    if (!_mm256_testz_si256(nan, nan)) {
+        return Max ? max_scalar(first, last) : min_scalar(first, last);
+    }
+    T lanes[kLanes];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    T best = Max ? *max_scalar(lanes, lanes + kLanes)
+                 : *min_scalar(lanes, lanes + kLanes);
+    for (; cur != last; ++cur) {
+        if (Max ? best < *cur : *cur < best) {
+            best = *cur;
+        }
+    }
+    return find_avx2(first, last, best);
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 T sum_avx2(const T* first, const T* last) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    // 两个累加器交替使用，缩短依赖链
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    for (; static_cast<size_t>(last - first) >= 2 * kLanes;
+         first += 2 * kLanes) {
+        acc0 = add_avx2<T>(acc0, load_avx2(first));
+        acc1 = add_avx2<T>(acc1, load_avx2(first + kLanes));
+    }
+    acc0 = add_avx2<T>(acc0, acc1);
+    T lanes[kLanes];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc0);
+    return static_cast<T>(
+        static_cast<sum_type<T>>(sum_scalar(lanes, lanes + kLanes)) +
+        static_cast<sum_type<T>>(sum_scalar(first, last)));
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 void fill_avx2(T* first, T* last, T value) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    const __m256i v = broadcast_avx2(value);
+    for (; static_cast<size_t>(last - first) >= kLanes; first += kLanes) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(first), v);
+    }
+    fill_scalar(first, last, value);
+}
+
+#endif  // MYSTL_SIMD_AVX2
+
+// CPU 是否支持 AVX2，只检测一次
+inline bool has_avx2() noexcept {
+#if MYSTL_SIMD_AVX2
+    static const bool value = __builtin_cpu_supports("avx2");
+    return value;
+#else
+    return false;
+#endif
+}
+
+/*****************************************************************************************/
+// 对外的接口，按 CPU 支持的指令集选择内核
+/*****************************************************************************************/
+
+template <typename T>
+const T* find(const T* first, const T* last, T value) noexcept {
+#if MYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return find_avx2(first, last, value);
+    }
+#endif
+#if defined(__SSE2__)
+    return find_sse2(first, last, value);
+#else
+    return find_scalar(first, last, value);
+#endif
+}
+
+template <typename T>
+size_t count(const T* first, const T* last, T value) noexcept {
+#if MYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return count_avx2(first, last, value);
+    }
+#endif
+#if defined(__SSE2__)
+    return count_sse2(first, last, value);
+#else
+    return count_scalar(first, last, value);
+#endif
+}
+
+template <typename T>
+size_t mismatch(const T* a, const T* b, size_t n) noexcept {
+    if constexpr (std::is_integral_v<T>) {
+        // 整数相等等价于字节相等，先用 memcmp 快速确认整体是否相等
+        if (n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0) {
+            return n;
+        }
+    }
+#if MYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return mismatch_avx2(a, b, n);
+    }
+#endif
+#if defined(__SSE2__)
+    return mismatch_sse2(a, b, n);
+#else
+    return mismatch_scalar(a, b, n);
+#endif
+}
+
+template <typename T>
+const T* min_element(const T* first, const T* last) noexcept {
+#if MYSTL_SIMD_AVX2
+    if constexpr (has_minmax_avx2_v<T>) {
+        if (has_avx2()) {
+            return minmax_avx2<T, false>(first, last);
+        }
+    }
+#endif
+    return min_scalar(first, last);
+}
+
+template <typename T>
+const T* max_element(const T* first, const T* last) noexcept {
+#if MYSTL_SIMD_AVX2
+    if constexpr (has_minmax_avx2_v<T>) {
+        if (has_avx2()) {
+            return minmax_avx2<T, true>(first, last);
+        }
+    }
+#endif
+    return max_scalar(first, last);
+}
+
+// 只用于整数，浮点数求和改变顺序会改变结果
+template <typename T>
+T sum(const T* first, const T* last) noexcept {
+    static_assert(std::is_integral_v<T>, "sum only supports integers");
+#if MYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        return sum_avx2(first, last);
+    }
+#endif
+#if defined(__SSE2__)
+    return sum_sse2(first, last);
+#else
+    return sum_scalar(first, last);
+#endif
+}
+
+template <typename T>
+void fill(T* first, T* last, T value) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        if (first != last) {
+            std::memset(first, static_cast<unsigned char>(value),
+                        static_cast<size_t>(last - first));
+        }
+        return;
+    }
+#if MYSTL_SIMD_AVX2
+    if (has_avx2()) {
+        fill_avx2(first, last, value);
+        return;
+    }
+#endif
+#if defined(__SSE2__)
+    fill_sse2(first, last, value);
+#else
+    fill_scalar(first, last, value);
+#endif
+}
+
+}  // namespace simd_detail
+
+}  // namespace mystl
@@ -0,0 +1,540 @@
+#pragma once
+
+// 这个头文件包含模板类 soa_vector
+// soa_vector : 按列存储的动态数组 (structure of arrays)，每个成员类型各自存放在
+//              一段连续的数组中，所有列共用一块内存，每列的起点按 64 字节对齐
+// 只用到部分字段的扫描只读取对应的列，不会把其余字段一起读进缓存；
+// column<I>() 返回第 I 列的 subrange，它的迭代器是原生指针，可以直接交给
+// SIMD 内核、并行算法与视图
+// 迭代器是代理迭代器，解引用得到由各列元素的引用组成的记录：两列时为
+// pair<T1&, T2&>，其余情况为 std::tuple<Ts&...>，对记录赋值会写回各列
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "uninitialized.hpp"
+#include "util.hpp"
+#include "views.hpp"
+
+namespace mystl {
+
+namespace soa_detail {
+
+// 每列起点的对齐：一个缓存行，也满足 AVX-512 的对齐加载
+inline constexpr size_t kColumnAlign = 64;
+
+// 记录类型：两个成员时为 pair，其余情况为 std::tuple
+template <typename... Ts>
+struct record {
+    using type = std::tuple<Ts...>;
+};
+
+template <typename T1, typename T2>
+struct record<T1, T2> {
+    using type = pair<T1, T2>;
+};
+
+template <typename... Ts>
+using record_t = typename record<Ts...>::type;
+
+// 取记录的第 I 个字段，保留记录的值类别
+template <size_t I, typename R>
+constexpr decltype(auto) field(R&& r) {
+    if constexpr (requires { r.first; }) {
+        if constexpr (I == 0) {
+            return (mystl::forward<R>(r).first);
+        } else {
+            return (mystl::forward<R>(r).second);
+        }
+    } else {
+        return std::get<I>(mystl::forward<R>(r));
+    }
+}
+
+// 依次调用 fn.template operator()<I>()，I 从 0 到 N - 1
+template <size_t N, typename Fn>
+constexpr void for_each_index(Fn&& fn) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (fn.template operator()<I>(), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+}  // namespace soa_detail
+
+// 模板类：soa_iterator
+// 保存各列的起始地址与下标，解引用时按下标组成记录；Ts 带 const 时为只读迭代器
+template <typename... Ts>
+class soa_iterator
+    : public views_detail::iterator_facade<soa_iterator<Ts...>,
+                                           soa_detail::record_t<Ts&...>> {
+public:
+    using iterator_category = random_access_iterator_tag;
+    using value_type = soa_detail::record_t<std::remove_const_t<Ts>...>;
+    using reference = soa_detail::record_t<Ts&...>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+
+private:
+    friend views_detail::iterator_facade<soa_iterator, reference>;
+    template <typename...>
+    friend class soa_iterator;
+
+    std::tuple<Ts*...> cols_{};
+    ptrdiff_t index_ = 0;
+
+    constexpr reference read() const {
+        return std::apply(
+            [this](Ts*... cols) { return reference(cols[index_]...); }, cols_);
+    }
+    constexpr void next() { ++index_; }
+    constexpr void prev() { --index_; }
+    constexpr void advance(ptrdiff_t n) { index_ += n; }
+    constexpr bool equal(const soa_iterator& rhs) const {
+        return index_ == rhs.index_;
+    }
+    constexpr ptrdiff_t distance_to(const soa_iterator& rhs) const {
+        return rhs.index_ - index_;
+    }
+
+public:
+    constexpr soa_iterator() = default;
+    constexpr soa_iterator(const std::tuple<Ts*...>& cols, ptrdiff_t index)
+        : cols_(cols), index_(index) {}
+
+    // iterator 可以转换为 const_iterator
+    template <typename... Us>
+    requires(std::is_convertible_v<Us*, Ts*>&&...)
+    constexpr soa_iterator(const soa_iterator<Us...>& other)
+        : cols_(other.cols_), index_(other.index_) {}
+
+    constexpr ptrdiff_t index() const { return index_; }
+};
+
+// 模板类：soa_vector
+// 模板参数 Ts 代表各列的元素类型
+template <typename... Ts>
+class soa_vector {
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+public:
+    using value_type = soa_detail::record_t<Ts...>;
+    using reference = soa_detail::record_t<Ts&...>;
+    using const_reference = soa_detail::record_t<const Ts&...>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = soa_iterator<Ts...>;
+    using const_iterator = soa_iterator<const Ts...>;
+
+    template <size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    static constexpr size_type columns = sizeof...(Ts);
+
+private:
+    using byte_allocator = allocator<unsigned char>;
+
+    // 一块内存及其中各列的起点
+    struct storage {
+        unsigned char* raw = nullptr;
+        size_type bytes = 0;
+        std::tuple<Ts*...> cols{};
+    };
+
+    static constexpr size_type kSizes[] = {sizeof(Ts)...};
+    static constexpr size_type kAligns[] = {(
+        alignof(Ts) > soa_detail::kColumnAlign ? alignof(Ts)
+                                               : soa_detail::kColumnAlign)...};
+    static constexpr size_type kMaxAlign = [] {
+        size_type a = 0;
+        for (size_type x : kAligns) {
+            a = x > a ? x : a;
+        }
+        return a;
+    }();
+    static constexpr size_type kMaxSize =
+        static_cast<size_type>(-1) / 2 / (sizeof(Ts) + ...);
+
+    storage mem_;
+    size_type size_ = 0;
+    size_type cap_ = 0;
+
+public:
+    // 构造、复制、移动、析构函数
+    soa_vector() = default;
+
+    explicit soa_vector(size_type n) { resize(n); }
+
+    soa_vector(const soa_vector& rhs) : mem_(allocate_storage(rhs.size_)) {
+        try {
+            construct_columns(mem_.cols, 0, rhs.size_,
+                              [&]<size_t I>(auto* first, auto*) {
+                                  auto* src = std::get<I>(rhs.mem_.cols);
+                                  mystl::uninitialized_copy(
+                                      src, src + rhs.size_, first);
+                              });
+        } catch (...) {
+            deallocate_storage(mem_);
+            throw;
+        }
+        size_ = rhs.size_;
+        cap_ = rhs.size_;
+    }
+
+    soa_vector(soa_vector&& rhs) noexcept
+        : mem_(rhs.mem_), size_(rhs.size_), cap_(rhs.cap_) {
+        rhs.mem_ = storage();
+        rhs.size_ = 0;
+        rhs.cap_ = 0;
+    }
+
+    soa_vector& operator=(const soa_vector& rhs) {
+        if (this != &rhs) {
+            soa_vector tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& rhs) noexcept {
+        soa_vector tmp(mystl::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~soa_vector() {
+        clear();
+        deallocate_storage(mem_);
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(mem_.cols, 0); }
+    const_iterator begin() const noexcept {
+        return const_iterator(const_columns(), 0);
+    }
+    iterator end() noexcept {
+        return iterator(mem_.cols, static_cast<difference_type>(size_));
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(const_columns(),
+                              static_cast<difference_type>(size_));
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return cap_; }
+    size_type max_size() const noexcept { return kMaxSize; }
+
+    void reserve(size_type n) {
+        if (n > cap_) {
+            reallocate(n);
+        }
+    }
+
+    // 访问元素相关操作
+    reference operator[](size_type n) {
+        return std::apply([n](Ts*... cols) { return reference(cols[n]...); },
+                          mem_.cols);
+    }
+    const_reference operator[](size_type n) const {
+        return std::apply(
+            [n](const Ts*... cols) { return const_reference(cols[n]...); },
+            const_columns());
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[size_ - 1]; }
+    const_reference back() const { return (*this)[size_ - 1]; }
+
+    // 第 I 列的起始地址与整列，起始地址按 64 字节对齐
+    template <size_t I>
+    column_type<I>* data() noexcept {
+        return std::get<I>(mem_.cols);
+    }
+    template <size_t I>
+    const column_type<I>* data() const noexcept {
+        return std::get<I>(mem_.cols);
+    }
+
+    template <size_t I>
+    subrange<column_type<I>*> column() noexcept {
+        return subrange<column_type<I>*>(data<I>(), data<I>() + size_);
+    }
+    template <size_t I>
+    subrange<const column_type<I>*> column() const noexcept {
+        return subrange<const column_type<I>*>(data<I>(), data<I>() + size_);
+    }
+
+    // 修改容器相关操作
+    // 每列一个参数，第 I 个参数构造第 I 列的元素
+    template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Ts))
+    reference emplace_back(Args&&... args) {
+        auto refs = std::forward_as_tuple(mystl::forward<Args>(args)...);
+        auto construct_one = [&]<size_t I>(auto* first, auto*) {
+            mystl::construct(first, std::get<I>(mystl::move(refs)));
+        };
+        if (size_ == cap_) {
+            // 先在新空间构造新元素，参数可能引用容器中原有的元素
+            const size_type new_cap = next_capacity();
+            storage s = allocate_storage(new_cap);
+            try {
+                construct_columns(s.cols, size_, size_ + 1, construct_one);
+            } catch (...) {
+                deallocate_storage(s);
+                throw;
+            }
+            try {
+                transfer(s);
+            } catch (...) {
+                destroy_columns(s.cols, size_, size_ + 1);
+                deallocate_storage(s);
+                throw;
+            }
+            deallocate_storage(mem_);
+            mem_ = s;
+            cap_ = new_cap;
+        } else {
+            construct_columns(mem_.cols, size_, size_ + 1, construct_one);
+        }
+        ++size_;
+        return back();
+    }
+
+    void push_back(const value_type& value) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            emplace_back(soa_detail::field<I>(value)...);
+        }(std::make_index_sequence<columns>{});
+    }
+    void push_back(value_type&& value) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            emplace_back(soa_detail::field<I>(mystl::move(value))...);
+        }(std::make_index_sequence<columns>{});
+    }
+
+    void pop_back() {
+        --size_;
+        destroy_columns(mem_.cols, size_, size_ + 1);
+    }
+
+    void resize(size_type new_size) {
+        if (new_size < size_) {
+            destroy_columns(mem_.cols, new_size, size_);
+        } else if (new_size > size_) {
+            reserve(new_size);
+            construct_columns(mem_.cols, size_, new_size,
+                              []<size_t I>(auto* first, auto* last) {
+                                  mystl::uninitialized_value_construct(first,
+                                                                       last);
+                              });
+        }
+        size_ = new_size;
+    }
+
+    void clear() noexcept {
+        destroy_columns(mem_.cols, 0, size_);
+        size_ = 0;
+    }
+
+    void swap(soa_vector& rhs) noexcept {
+        mystl::swap(mem_, rhs.mem_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(cap_, rhs.cap_);
+    }
+
+private:
+    std::tuple<const Ts*...> const_columns() const { return mem_.cols; }
+
+    size_type next_capacity() const {
+        if (size_ == max_size()) {
+            throw std::length_error("soa_vector's size too big");
+        }
+        return cap_ > max_size() / 2 ? max_size()
+                                     : (cap_ == 0 ? 8 : cap_ * 2);
+    }
+
+    // 容量为 cap 时各列在内存块中的偏移，返回各列总共占用的字节数
+    static size_type layout(size_type cap, size_type (&offsets)[columns]) {
+        size_type bytes = 0;
+        for (size_type i = 0; i < columns; ++i) {
+            bytes = (bytes + kAligns[i] - 1) / kAligns[i] * kAligns[i];
+            offsets[i] = bytes;
+            bytes += cap * kSizes[i];
+        }
+        return bytes;
+    }
+
+    // 多分配 kMaxAlign - 1 字节，把块的起点对齐
+    static storage allocate_storage(size_type cap) {
+        storage s;
+        if (cap == 0) {
+            return s;
+        }
+        if (cap > kMaxSize) {
+            throw std::length_error("soa_vector's size too big");
+        }
+        size_type offsets[columns];
+        s.bytes = layout(cap, offsets) + kMaxAlign - 1;
+        s.raw = byte_allocator::allocate(s.bytes);
+        const auto addr = reinterpret_cast<uintptr_t>(s.raw);
+        unsigned char* base =
+            s.raw + (kMaxAlign - addr % kMaxAlign) % kMaxAlign;
+        soa_detail::for_each_index<columns>([&]<size_t I>() {
+            std::get<I>(s.cols) =
+                reinterpret_cast<column_type<I>*>(base + offsets[I]);
+        });
+        return s;
+    }
+
+    static void deallocate_storage(storage& s) {
+        byte_allocator::deallocate(s.raw, s.bytes);
+        s = storage();
+    }
+
+    static void destroy_columns(const std::tuple<Ts*...>& cols,
+                                size_type first, size_type last) {
+        soa_detail::for_each_index<columns>([&]<size_t I>() {
+            mystl::destory(std::get<I>(cols) + first, std::get<I>(cols) + last);
+        });
+    }
+
+    // 依次在每一列的 [first, last) 上调用 fn.template operator()<I>(起点, 终点)
+    // 构造元素；某一列抛出异常时析构此前各列已构造的元素
+    template <typename Fn>
+    static void construct_columns(const std::tuple<Ts*...>& cols,
+                                  size_type first, size_type last, Fn&& fn) {
+        size_type done = 0;
+        try {
+            soa_detail::for_each_index<columns>([&]<size_t I>() {
+                auto* p = std::get<I>(cols);
+                fn.template operator()<I>(p + first, p + last);
+                ++done;
+            });
+        } catch (...) {
+            soa_detail::for_each_index<columns>([&]<size_t I>() {
+                if (I < done) {
+                    mystl::destory(std::get<I>(cols) + first,
+                                   std::get<I>(cols) + last);
+                }
+            });
+            throw;
+        }
+    }
+
+    // 搬运一列的方式：0 复制，1 可能抛出异常的移动 (不可复制)，
+    // 2 不会抛出异常的移动或按字节复制
+    template <typename T>
+    static constexpr int transfer_kind() {
+        if constexpr (is_trivially_relocatable_v<T> ||
+                      std::is_nothrow_move_constructible_v<T>) {
+            return 2;
+        } else if constexpr (!std::is_copy_constructible_v<T>) {
+            return 1;
+        } else {
+            return 0;
+        }
+    }
+
+    // 把原有元素搬到 s 中：先复制移动可能抛出异常的列，全部成功后才移动
+    // 其余的列，最后结束原有元素的生命周期。复制失败时原有元素都没有被
+    // 移动过，保证强异常安全；只有不可复制且移动可能抛出异常的列做不到
+    void transfer(const storage& s) {
+        bool built[columns] = {};
+        try {
+            for (int kind = 0; kind < 3; ++kind) {
+                soa_detail::for_each_index<columns>([&]<size_t I>() {
+                    using T = column_type<I>;
+                    if (transfer_kind<T>() != kind) {
+                        return;
+                    }
+                    T* src = std::get<I>(mem_.cols);
+                    T* dst = std::get<I>(s.cols);
+                    if constexpr (is_trivially_relocatable_v<T>) {
+                        if (size_ != 0) {
+                            std::memcpy(static_cast<void*>(dst),
+                                        static_cast<const void*>(src),
+                                        size_ * sizeof(T));
+                        }
+                    } else if constexpr (transfer_kind<T>() == 0) {
+                        mystl::uninitialized_copy(src, src + size_, dst);
+                    } else {
+                        mystl::uninitialized_move(src, src + size_, dst);
+                    }
+                    built[I] = true;
+                });
+            }
+        } catch (...) {
+            soa_detail::for_each_index<columns>([&]<size_t I>() {
+                using T = column_type<I>;
+                if (built[I] && !is_trivially_relocatable_v<T>) {
+                    mystl::destory(std::get<I>(s.cols),
+                                   std::get<I>(s.cols) + size_);
+                }
+            });
+            throw;
+        }
+        soa_detail::for_each_index<columns>([&]<size_t I>() {
+            using T = column_type<I>;
+            if constexpr (!is_trivially_relocatable_v<T>) {
+                T* src = std::get<I>(mem_.cols);
+                mystl::destory(src, src + size_);
+            }
+        });
+    }
+
+    void reallocate(size_type new_cap) {
+        storage s = allocate_storage(new_cap);
+        try {
+            transfer(s);
+        } catch (...) {
+            deallocate_storage(s);
+            throw;
+        }
+        deallocate_storage(mem_);
+        mem_ = s;
+        cap_ = new_cap;
+    }
+};
+
+// 重载比较操作符：逐列比较，每列都是连续区间
+template <typename... Ts>
+bool operator==(const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    bool result = true;
+    soa_detail::for_each_index<sizeof...(Ts)>([&]<size_t I>() {
+        result = result && mystl::equal(lhs.template data<I>(),
+                                        lhs.template data<I>() + lhs.size(),
+                                        rhs.template data<I>());
+    });
+    return result;
+}
+
+template <typename... Ts>
+bool operator!=(const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs) {
+    return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename... Ts>
+void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
@@ -0,0 +1,829 @@
+#pragma once
+
+// 这个头文件包含排序相关的算法，均要求随机访问迭代器，通过 iterator_category 分派
+// sort         : pattern-defeating quicksort (pdqsort)
+//                小区间插入排序，枢轴连续不理想时退化为堆排序，
+//                整体已经有序或逆序时线性时间完成
+//                算术类型配合默认比较器时使用无分支的分块分割
+//                连续迭代器上的整数 (升序或降序) 使用 LSD 基数排序
+// stable_sort  : 归并排序，需要一半长度的额外缓冲区
+// partial_sort : 堆选择 + 堆排序
+// nth_element  : 内省式选择，分割次数过多时改用堆选择
+// 以上算法都可以在常量求值中使用，此时 sort 不走基数排序与无分支分割
+
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "uninitialized.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+namespace sort_detail {
+
+// 小于这个长度的区间交给插入排序
+inline constexpr ptrdiff_t kInsertionSortThreshold = 24;
+// 大于这个长度的区间用九数取中选择枢轴
+inline constexpr ptrdiff_t kNintherThreshold = 128;
+// 试探性插入排序最多移动的元素个数
+inline constexpr size_t kPartialInsertionSortLimit = 8;
+// 无分支分割每次处理的块大小，偏移量用 unsigned char 保存
+inline constexpr size_t kBlockSize = 64;
+// 不小于这个长度时整数使用基数排序
+inline constexpr ptrdiff_t kRadixSortThreshold = 1024;
+// stable_sort 中用插入排序处理的小段长度
+inline constexpr ptrdiff_t kStableChunk = 32;
+
+template <typename Compared, typename T>
+inline constexpr bool is_less_v =
+    std::is_same_v<Compared, std::less<T>> ||
+    std::is_same_v<Compared, std::less<>>;
+
+template <typename Compared, typename T>
+inline constexpr bool is_greater_v =
+    std::is_same_v<Compared, std::greater<T>> ||
+    std::is_same_v<Compared, std::greater<>>;
+
+// 比较结果可以直接当作整数累加而不产生分支
+template <typename Compared, typename T>
+inline constexpr bool is_branchless_v =
+    std::is_arithmetic_v<T> &&
+    (is_less_v<Compared, T> || is_greater_v<Compared, T>);
+
+// 连续迭代器上的整数才走基数排序
+template <typename Iter, typename Compared>
+inline constexpr bool is_radix_sortable_v = [] {
+    if constexpr (is_contiguous_iterator_v<Iter>) {
+        using T = typename iterator_traits<Iter>::value_type;
+        using R = typename iterator_traits<Iter>::reference;
+        return std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+               !std::is_const_v<std::remove_reference_t<R>> &&
+               (is_less_v<Compared, T> || is_greater_v<Compared, T>);
+    } else {
+        return false;
+    }
+}();
+
+template <typename Size>
+constexpr Size log2(Size n) {
+    Size k = 0;
+    for (; n > 1; n >>= 1) {
+        ++k;
+    }
+    return k;
+}
+
+template <typename RandomIter>
+constexpr void reverse(RandomIter first, RandomIter last) {
+    for (; first < last; ++first) {
+        --last;
+        mystl::swap(*first, *last);
+    }
+}
+
+/*****************************************************************************************/
+// 插入排序
+/*****************************************************************************************/
+
+template <typename RandomIter, typename Compared>
+constexpr void insertion_sort(RandomIter first, RandomIter last,
+                              Compared comp) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev)) {
+            auto value = mystl::move(*hole);
+            do {
+                *hole-- = mystl::move(*prev);
+            } while (hole != first && comp(value, *--prev));
+            *hole = mystl::move(value);
+        }
+    }
+}
+
+// 要求 *(first - 1) 不大于区间内的任何元素，省去边界检查
+template <typename RandomIter, typename Compared>
+constexpr void unguarded_insertion_sort(RandomIter first, RandomIter last,
+                                        Compared comp) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev)) {
+            auto value = mystl::move(*hole);
+            do {
+                *hole-- = mystl::move(*prev);
+            } while (comp(value, *--prev));
+            *hole = mystl::move(value);
+        }
+    }
+}
+
+// 试探性的插入排序，移动的元素超过 kPartialInsertionSortLimit 时放弃
+// 返回区间是否已经排好序
+template <typename RandomIter, typename Compared>
+constexpr bool partial_insertion_sort(RandomIter first, RandomIter last,
+                                      Compared comp) {
+    if (first == last) {
+        return true;
+    }
+    size_t moved = 0;
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev)) {
+            auto value = mystl::move(*hole);
+            do {
+                *hole-- = mystl::move(*prev);
+            } while (hole != first && comp(value, *--prev));
+            *hole = mystl::move(value);
+            moved += static_cast<size_t>(cur - hole);
+        }
+        if (moved > kPartialInsertionSortLimit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************************/
+// 堆
+/*****************************************************************************************/
+
+// 以 first 为根的堆中，把 hole 处的元素下沉到合适的位置
+template <typename RandomIter, typename Distance, typename T,
+          typename Compared>
+constexpr void adjust_heap(RandomIter first, Distance hole, Distance len,
+                           T value, Compared comp) {
+    const Distance top = hole;
+    Distance child = 2 * hole + 2;
+    while (child < len) {
+        if (comp(*(first + child), *(first + (child - 1)))) {
+            --child;
+        }
+        *(first + hole) = mystl::move(*(first + child));
+        hole = child;
+        child = 2 * child + 2;
+    }
+    if (child == len) {
+        *(first + hole) = mystl::move(*(first + (child - 1)));
+        hole = child - 1;
+    }
+    // 上溯
+    Distance parent = (hole - 1) / 2;
+    while (hole > top && comp(*(first + parent), value)) {
+        *(first + hole) = mystl::move(*(first + parent));
+        hole = parent;
+        parent = (hole - 1) / 2;
+    }
+    *(first + hole) = mystl::move(value);
+}
+
+template <typename RandomIter, typename Compared>
+constexpr void make_heap(RandomIter first, RandomIter last, Compared comp) {
+    const auto len = last - first;
+    for (auto parent = (len - 2) / 2; len >= 2 && parent >= 0; --parent) {
+        adjust_heap(first, parent, len, mystl::move(*(first + parent)), comp);
+    }
+}
+
+// 把堆顶换到 result，原来 result 处的元素放入堆中
+template <typename RandomIter, typename Compared>
+constexpr void pop_heap_to(RandomIter first, RandomIter last, RandomIter result,
+                           Compared comp) {
+    auto value = mystl::move(*result);
+    *result = mystl::move(*first);
+    adjust_heap(first, decltype(last - first)(0), last - first,
+                mystl::move(value), comp);
+}
+
+template <typename RandomIter, typename Compared>
+constexpr void sort_heap(RandomIter first, RandomIter last, Compared comp) {
+    for (; last - first > 1; --last) {
+        pop_heap_to(first, last - 1, last - 1, comp);
+    }
+}
+
+// 把 [first, last) 中最小的 middle - first 个元素以堆的形式放到 [first, middle)
+template <typename RandomIter, typename Compared>
+constexpr void heap_select(RandomIter first, RandomIter middle, RandomIter last,
+                           Compared comp) {
+    sort_detail::make_heap(first, middle, comp);
+    for (RandomIter i = middle; i < last; ++i) {
+        if (comp(*i, *first)) {
+            pop_heap_to(first, middle, i, comp);
+        }
+    }
+}
+
+/*****************************************************************************************/
+// pdqsort
+/*****************************************************************************************/
+
+template <typename RandomIter, typename Compared>
+constexpr void sort2(RandomIter a, RandomIter b, Compared comp) {
+    if (comp(*b, *a)) {
+        mystl::swap(*a, *b);
+    }
+}
+
+// 排序后中值在 b
+template <typename RandomIter, typename Compared>
+constexpr void sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+// 选择枢轴并交换到 first，同时保证 *(last - 1) 不小于枢轴，作为右侧的哨兵
+template <typename RandomIter, typename Compared>
+constexpr void choose_pivot(RandomIter first, RandomIter last, Compared comp) {
+    const auto size = last - first;
+    const auto half = size / 2;
+    if (size > kNintherThreshold) {
+        sort3(first, first + half, last - 1, comp);
+        sort3(first + 1, first + (half - 1), last - 2, comp);
+        sort3(first + 2, first + (half + 1), last - 3, comp);
+        sort3(first + (half - 1), first + half, first + (half + 1), comp);
+        mystl::swap(*first, *(first + half));
+    } else {
+        sort3(first + half, first, last - 1, comp);
+    }
+}
+
+// 以 *first 为枢轴分割，等于枢轴的元素放到右边
+// 返回枢轴的最终位置，以及分割前区间是否已经是分割好的
+template <typename RandomIter, typename Compared>
+constexpr pair<RandomIter, bool> partition_right(RandomIter first,
+                                                 RandomIter last,
+                                                 Compared comp) {
+    const RandomIter begin = first;
+    auto pivot = mystl::move(*first);
+
+    // 左侧有比枢轴大的哨兵 *(last - 1)，右侧在左边找到过小元素时同样有哨兵
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+
+    const bool already_partitioned = first >= last;
+    while (first < last) {
+        mystl::swap(*first, *last);
+        while (comp(*++first, pivot)) {
+        }
+        while (!comp(*--last, pivot)) {
+        }
+    }
+
+    RandomIter pivot_pos = first - 1;
+    *begin = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 按偏移量交换左右两块中放错位置的元素
+// 个数相等时逐对交换，保证逆序输入仍然是线性的；否则用循环移位少写一半
+template <typename RandomIter>
+constexpr void swap_offsets(RandomIter first, RandomIter last,
+                            const unsigned char* offsets_l,
+                            const unsigned char* offsets_r, size_t num,
+                            bool use_swaps) {
+    if (use_swaps) {
+        for (size_t i = 0; i < num; ++i) {
+            mystl::swap(*(first + offsets_l[i]), *(last - offsets_r[i]));
+        }
+    } else if (num > 0) {
+        RandomIter l = first + offsets_l[0];
+        RandomIter r = last - offsets_r[0];
+        auto tmp = mystl::move(*l);
+        *l = mystl::move(*r);
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = mystl::move(*l);
+            r = last - offsets_r[i];
+            *l = mystl::move(*r);
+        }
+        *r = mystl::move(tmp);
+    }
+}
+
+// partition_right 的无分支版本 (BlockQuicksort)
+// 先把一整块的比较结果写成偏移量数组，再集中交换，比较本身不产生分支
+template <typename RandomIter, typename Compared>
+constexpr pair<RandomIter, bool> partition_right_branchless(RandomIter first,
+                                                            RandomIter last,
+                                                            Compared comp) {
+    const RandomIter begin = first;
+    auto pivot = mystl::move(*first);
+
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+
+    const bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        mystl::swap(*first, *last);
+        ++first;
+
+        alignas(64) unsigned char offsets_l[kBlockSize];
+        alignas(64) unsigned char offsets_r[kBlockSize];
+        RandomIter base_l = first;
+        RandomIter base_r = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // 一侧的偏移量用完之后才重新填充这一侧
+            const size_t unknown = static_cast<size_t>(last - first);
+            const size_t left_split =
+                num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+            const size_t right_split = num_r == 0 ? unknown - left_split : 0;
+
+            const size_t n_l = left_split < kBlockSize ? left_split
+                                                       : kBlockSize;
+            for (size_t i = 0; i < n_l; ++i) {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !comp(*first, pivot);
+                ++first;
+            }
+            const size_t n_r = right_split < kBlockSize ? right_split
+                                                        : kBlockSize;
+            for (size_t i = 0; i < n_r;) {
+                offsets_r[num_r] = static_cast<unsigned char>(++i);
+                num_r += comp(*--last, pivot);
+            }
+
+            const size_t num = num_l < num_r ? num_l : num_r;
+            swap_offsets(base_l, base_r, offsets_l + start_l,
+                         offsets_r + start_r, num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                base_l = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                base_r = last;
+            }
+        }
+
+        // 剩下的只有一侧还有放错的元素，逐个换到分界处
+        if (num_l) {
+            while (num_l--) {
+                mystl::swap(*(base_l + offsets_l[start_l + num_l]), *--last);
+            }
+            first = last;
+        }
+        if (num_r) {
+            while (num_r--) {
+                mystl::swap(*(base_r - offsets_r[start_r + num_r]), *first);
+                ++first;
+            }
+        }
+    }
+
+    RandomIter pivot_pos = first - 1;
+    *begin = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 以 *first 为枢轴分割，等于枢轴的元素放到左边，返回枢轴的最终位置
+// 用于大量重复元素：左边全部等于枢轴，无需再排序
+template <typename RandomIter, typename Compared>
+constexpr RandomIter partition_left(RandomIter first, RandomIter last,
+                                    Compared comp) {
+    const RandomIter begin = first;
+    const RandomIter end = last;
+    auto pivot = mystl::move(*first);
+
+    while (comp(pivot, *--last)) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {
+        }
+    } else {
+        while (!comp(pivot, *++first)) {
+        }
+    }
+
+    while (first < last) {
+        mystl::swap(*first, *last);
+        while (comp(pivot, *--last)) {
+        }
+        while (!comp(pivot, *++first)) {
+        }
+    }
+
+    *begin = mystl::move(*last);
+    *last = mystl::move(pivot);
+    return last;
+}
+
+// 打乱分割不均匀的区间中的几个元素，破坏导致退化的输入模式
+template <typename RandomIter>
+constexpr void break_patterns(RandomIter first, RandomIter pivot_pos,
+                              RandomIter last) {
+    const auto l_size = pivot_pos - first;
+    const auto r_size = last - (pivot_pos + 1);
+    if (l_size >= kInsertionSortThreshold) {
+        mystl::swap(*first, *(first + l_size / 4));
+        mystl::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+        if (l_size > kNintherThreshold) {
+            mystl::swap(*(first + 1), *(first + (l_size / 4 + 1)));
+            mystl::swap(*(first + 2), *(first + (l_size / 4 + 2)));
+            mystl::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+            mystl::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+        }
+    }
+    if (r_size >= kInsertionSortThreshold) {
+        mystl::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+        mystl::swap(*(last - 1), *(last - r_size / 4));
+        if (r_size > kNintherThreshold) {
+            mystl::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+            mystl::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+            mystl::swap(*(last - 2), *(last - (1 + r_size / 4)));
+            mystl::swap(*(last - 3), *(last - (2 + r_size / 4)));
+        }
+    }
+}
+
+// leftmost 为 false 时 *(first - 1) 是上一次分割的枢轴，不大于区间内的所有元素
+template <bool Branchless, typename RandomIter, typename Compared>
+constexpr void pdqsort_loop(RandomIter first, RandomIter last, Compared comp,
+                            int bad_allowed, bool leftmost) {
+    for (;;) {
+        const auto size = last - first;
+        if (size < kInsertionSortThreshold) {
+            if (leftmost) {
+                insertion_sort(first, last, comp);
+            } else {
+                unguarded_insertion_sort(first, last, comp);
+            }
+            return;
+        }
+
+        choose_pivot(first, last, comp);
+
+        // 枢轴等于上一次的枢轴，说明有大量重复元素，把相等的元素收拢到左边
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        const auto part = [&] {
+            if constexpr (Branchless) {
+                return partition_right_branchless(first, last, comp);
+            } else {
+                return partition_right(first, last, comp);
+            }
+        }();
+        const RandomIter pivot_pos = part.first;
+
+        const auto l_size = pivot_pos - first;
+        const auto r_size = last - (pivot_pos + 1);
+        if (l_size < size / 8 || r_size < size / 8) {
+            // 分割不均匀的次数过多，改用堆排序保证 O(nlogn)
+            if (--bad_allowed == 0) {
+                sort_detail::make_heap(first, last, comp);
+                sort_detail::sort_heap(first, last, comp);
+                return;
+            }
+            break_patterns(first, pivot_pos, last);
+        } else if (part.second &&
+                   partial_insertion_sort(first, pivot_pos, comp) &&
+                   partial_insertion_sort(pivot_pos + 1, last, comp)) {
+            // 分割均匀且原本就是分割好的，很可能已经基本有序
+            return;
+        }
+
+        // 递归处理左半部分，右半部分继续循环
+        pdqsort_loop<Branchless>(first, pivot_pos, comp, bad_allowed,
+                                 leftmost);
+        first = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+// 整个区间已经有序时返回 true；非递增时翻转后返回 true
+// 遇到第一个破坏单调性的位置就停止，随机数据上只多几次比较
+template <typename RandomIter, typename Compared>
+constexpr bool sorted_or_reversed(RandomIter first, RandomIter last,
+                                  Compared comp) {
+    RandomIter cur = first + 1;
+    if (comp(*cur, *first)) {
+        while (++cur != last && !comp(*(cur - 1), *cur)) {
+        }
+        if (cur == last) {
+            sort_detail::reverse(first, last);
+            return true;
+        }
+    } else {
+        while (++cur != last && !comp(*cur, *(cur - 1))) {
+        }
+        if (cur == last) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*****************************************************************************************/
+// LSD 基数排序
+// 每趟按一个字节分配，所有趟的计数在一次扫描中求出
+// 某一趟上所有元素的字节都相同时跳过这一趟
+/*****************************************************************************************/
+
+template <bool Descending, typename T>
+constexpr auto radix_key(T value) {
+    using U = std::make_unsigned_t<T>;
+    U key = static_cast<U>(value);
+    if constexpr (std::is_signed_v<T>) {
+        // 翻转符号位，使负数排在前面
+        key ^= U(1) << (sizeof(T) * 8 - 1);
+    }
+    if constexpr (Descending) {
+        key = static_cast<U>(~key);
+    }
+    return key;
+}
+
+template <bool Descending, typename T>
+constexpr void radix_sort(T* first, T* last) {
+    constexpr size_t kPasses = sizeof(T);
+    const size_t n = static_cast<size_t>(last - first);
+
+    size_t counts[kPasses][256] = {};
+    for (T* p = first; p != last; ++p) {
+        const auto key = radix_key<Descending>(*p);
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            ++counts[pass][(key >> (pass * 8)) & 0xff];
+        }
+    }
+
+    T* buffer = mystl::allocator<T>::allocate(n);
+    T* src = first;
+    T* dst = buffer;
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+        size_t* count = counts[pass];
+        const size_t shift = pass * 8;
+        if (count[(radix_key<Descending>(*src) >> shift) & 0xff] == n) {
+            continue;
+        }
+        size_t sum = 0;
+        for (size_t i = 0; i < 256; ++i) {
+            const size_t c = count[i];
+            count[i] = sum;
+            sum += c;
+        }
+        for (T* p = src; p != src + n; ++p) {
+            dst[count[(radix_key<Descending>(*p) >> shift) & 0xff]++] = *p;
+        }
+        mystl::swap(src, dst);
+    }
+    if (src != first) {
+        std::memcpy(first, src, n * sizeof(T));
+    }
+    mystl::allocator<T>::deallocate(buffer, n);
+}
+
+template <typename RandomIter, typename Compared>
+constexpr void sort_dispatch(RandomIter first, RandomIter last, Compared comp,
+                             random_access_iterator_tag) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    const auto n = last - first;
+    if (n < 2 || sorted_or_reversed(first, last, comp)) {
+        return;
+    }
+    // 基数排序依赖 memcpy，分块分割依赖对齐的偏移量数组，
+    // 常量求值时只走普通的 pdqsort
+    if (std::is_constant_evaluated()) {
+        pdqsort_loop<false>(first, last, comp, static_cast<int>(log2(n)) + 1,
+                            true);
+        return;
+    }
+    if constexpr (is_radix_sortable_v<RandomIter, Compared>) {
+        if (n >= kRadixSortThreshold) {
+            radix_sort<is_greater_v<Compared, value_type>>(
+                mystl::to_address(first), mystl::to_address(last));
+            return;
+        }
+    }
+    pdqsort_loop<is_branchless_v<Compared, value_type>>(
+        first, last, comp, static_cast<int>(log2(n)) + 1, true);
+}
+
+/*****************************************************************************************/
+// 归并排序
+/*****************************************************************************************/
+
+// 缓冲区的原始内存，只负责申请和释放
+template <typename T>
+struct temporary_buffer {
+    T* data;
+    size_t size;
+
+    constexpr explicit temporary_buffer(size_t n)
+        : data(mystl::allocator<T>::allocate(n)), size(n) {}
+    constexpr ~temporary_buffer() {
+        mystl::allocator<T>::deallocate(data, size);
+    }
+
+    temporary_buffer(const temporary_buffer&) = delete;
+    temporary_buffer& operator=(const temporary_buffer&) = delete;
+};
+
+// 把 [first, middle) 移到缓冲区，再与 [middle, last) 从前往后归并回原区间
+// 比较抛出异常时把缓冲区中剩下的元素移回原区间，再析构缓冲区
+template <typename RandomIter, typename T, typename Compared>
+constexpr void merge_with_buffer(RandomIter first, RandomIter middle,
+                                 RandomIter last, T* buf, Compared comp) {
+    T* const buf_end = mystl::uninitialized_move(first, middle, buf);
+    T* b = buf;
+    RandomIter r = middle;
+    RandomIter out = first;
+    try {
+        while (b != buf_end && r != last) {
+            if (comp(*r, *b)) {
+                *out = mystl::move(*r);
+                ++r;
+            } else {
+                *out = mystl::move(*b);
+                ++b;
+            }
+            ++out;
+        }
+    } catch (...) {
+        for (; b != buf_end; ++b, ++out) {
+            *out = mystl::move(*b);
+        }
+        mystl::destory(buf, buf_end);
+        throw;
+    }
+    for (; b != buf_end; ++b, ++out) {
+        *out = mystl::move(*b);
+    }
+    mystl::destory(buf, buf_end);
+}
+
+template <typename RandomIter, typename T, typename Compared>
+constexpr void merge_sort(RandomIter first, RandomIter last, T* buf,
+                          Compared comp) {
+    const auto len = last - first;
+    if (len <= kStableChunk) {
+        insertion_sort(first, last, comp);
+        return;
+    }
+    const RandomIter middle = first + len / 2;
+    merge_sort(first, middle, buf, comp);
+    merge_sort(middle, last, buf, comp);
+    // 两段首尾已经有序时不需要归并
+    if (comp(*middle, *(middle - 1))) {
+        merge_with_buffer(first, middle, last, buf, comp);
+    }
+}
+
+template <typename RandomIter, typename Compared>
+constexpr void stable_sort_dispatch(RandomIter first, RandomIter last,
+                                    Compared comp, random_access_iterator_tag) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    const auto len = last - first;
+    if (len <= kStableChunk) {
+        insertion_sort(first, last, comp);
+        return;
+    }
+    temporary_buffer<value_type> buf(static_cast<size_t>(len / 2));
+    merge_sort(first, last, buf.data, comp);
+}
+
+template <typename RandomIter, typename Compared>
+constexpr void partial_sort_dispatch(RandomIter first, RandomIter middle,
+                                     RandomIter last, Compared comp,
+                                     random_access_iterator_tag) {
+    if (first == middle) {
+        return;
+    }
+    sort_detail::heap_select(first, middle, last, comp);
+    sort_detail::sort_heap(first, middle, comp);
+}
+
+template <typename RandomIter, typename Compared>
+constexpr void nth_element_dispatch(RandomIter first, RandomIter nth,
+                                    RandomIter last, Compared comp,
+                                    random_access_iterator_tag) {
+    if (nth == last) {
+        return;
+    }
+    auto depth = 2 * log2(last - first);
+    while (last - first >= kInsertionSortThreshold) {
+        if (depth-- == 0) {
+            // 堆顶是前 nth - first + 1 小元素中最大的一个
+            sort_detail::heap_select(first, nth + 1, last, comp);
+            mystl::swap(*first, *nth);
+            return;
+        }
+        choose_pivot(first, last, comp);
+        const RandomIter pivot_pos = partition_right(first, last, comp).first;
+        if (pivot_pos == nth) {
+            return;
+        }
+        if (nth < pivot_pos) {
+            last = pivot_pos;
+        } else {
+            first = pivot_pos + 1;
+        }
+    }
+    insertion_sort(first, last, comp);
+}
+
+}  // namespace sort_detail
+
+/*****************************************************************************************/
+// sort
+// 将 [first, last) 内的元素以递增的方式排序，不保证相等元素的相对顺序
+/*****************************************************************************************/
+
+template <typename RandomIter, typename Compared>
+constexpr void sort(RandomIter first, RandomIter last, Compared comp) {
+    sort_detail::sort_dispatch(first, last, comp, iterator_category(first));
+}
+
+template <typename RandomIter>
+constexpr void sort(RandomIter first, RandomIter last) {
+    mystl::sort(first, last, std::less<>());
+}
+
+/*****************************************************************************************/
+// stable_sort
+// 将 [first, last) 内的元素以递增的方式排序，相等元素保持原来的相对顺序
+/*****************************************************************************************/
+
+template <typename RandomIter, typename Compared>
+constexpr void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+    sort_detail::stable_sort_dispatch(first, last, comp,
+                                      iterator_category(first));
+}
+
+template <typename RandomIter>
+constexpr void stable_sort(RandomIter first, RandomIter last) {
+    mystl::stable_sort(first, last, std::less<>());
+}
+
+/*****************************************************************************************/
+// partial_sort
+// 将 [first, last) 中最小的 middle - first 个元素按递增顺序放到 [first, middle)
+/*****************************************************************************************/
+
+template <typename RandomIter, typename Compared>
+constexpr void partial_sort(RandomIter first, RandomIter middle,
+                            RandomIter last, Compared comp) {
+    sort_detail::partial_sort_dispatch(first, middle, last, comp,
+                                       iterator_category(first));
+}
+
+template <typename RandomIter>
+constexpr void partial_sort(RandomIter first, RandomIter middle,
+                            RandomIter last) {
+    mystl::partial_sort(first, middle, last, std::less<>());
+}
+
+/*****************************************************************************************/
+// nth_element
+// 使 nth 处的元素等于排序后该位置上的元素，前面的元素都不大于它，后面的都不小于它
+/*****************************************************************************************/
+
+template <typename RandomIter, typename Compared>
+constexpr void nth_element(RandomIter first, RandomIter nth, RandomIter last,
+                           Compared comp) {
+    sort_detail::nth_element_dispatch(first, nth, last, comp,
+                                      iterator_category(first));
+}
+
+template <typename RandomIter>
+constexpr void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
+    mystl::nth_element(first, nth, last, std::less<>());
+}
+
+}  // namespace mystl
@@ -0,0 +1,300 @@
+#pragma once
+
+// 这个头文件包含模板类 static_map 和键的哈希 static_hash
+// static_map : 键集合在编译期确定的只读映射，构造时求出一个最小完美哈希
+//              (CHD 的变体：键先分到桶里，每个桶再找一个把桶内的键都放进空槽位
+//              的扰动值)，元素按槽位存放在 array 中
+// 查找时对键只哈希一次，读一次扰动值、比较一次键，不分配内存
+// 用 constexpr 变量保存时全部工作都在编译期完成：
+//   constexpr auto methods = mystl::make_static_map<mystl::string_view, int>(
+//       {{"GET", 1}, {"PUT", 2}, {"POST", 3}});
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "array.hpp"
+#include "sort.hpp"
+#include "string_view.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+namespace static_map_detail {
+
+// splitmix64 的终结函数，双射
+constexpr uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// 把 [p, p + n) 的字符按小端拼成一个 64 位整数
+template <typename CharT>
+constexpr uint64_t load(const CharT* p, size_t n) {
+    using U = std::make_unsigned_t<CharT>;
+    if constexpr (sizeof(CharT) == 1 && std::endian::native ==
+                                            std::endian::little) {
+        // 运行期用至多两次有重叠的读取代替逐字节拼接，重叠的字节位置相同
+        if (!std::is_constant_evaluated()) {
+            if (n == 8) {
+                uint64_t w;
+                std::memcpy(&w, p, 8);
+                return w;
+            }
+            if (n >= 4) {
+                uint32_t lo, hi;
+                std::memcpy(&lo, p, 4);
+                std::memcpy(&hi, p + n - 4, 4);
+                return lo | (static_cast<uint64_t>(hi) << ((n - 4) * 8));
+            }
+            return static_cast<uint64_t>(static_cast<U>(p[0])) |
+                   static_cast<uint64_t>(static_cast<U>(p[n / 2]))
+                       << (n / 2 * 8) |
+                   static_cast<uint64_t>(static_cast<U>(p[n - 1]))
+                       << ((n - 1) * 8);
+        }
+    }
+    uint64_t w = 0;
+    for (size_t i = 0; i < n; ++i) {
+        w |= static_cast<uint64_t>(static_cast<U>(p[i]))
+             << (i * sizeof(CharT) * 8);
+    }
+    return w;
+}
+
+// 把 64 位的 x 均匀地映射到 [0, n)：乘法后取高 64 位，代替取模
+constexpr size_t reduce(uint64_t x, size_t n) {
+    return static_cast<size_t>(
+        (static_cast<unsigned __int128>(x) * n) >> 64);
+}
+
+// reduce 的逆：返回一个满足 reduce(x, n) == slot 的 x
+constexpr uint64_t preimage(size_t slot, size_t n) {
+    return static_cast<uint64_t>(
+        ((static_cast<unsigned __int128>(slot) << 64) + n - 1) / n);
+}
+
+// 单个桶最多尝试的扰动值个数，超过后换一个种子重新构造
+inline constexpr uint64_t kMaxPilot = 1 << 16;
+inline constexpr uint64_t kMaxSeeds = 64;
+
+}  // namespace static_map_detail
+
+// 模板类：static_hash
+// 带种子的哈希，编译期与运行期的结果相同；自定义的键类型可以特化这个模板
+template <typename Key, typename = void>
+struct static_hash;
+
+// 整数与枚举
+template <typename Key>
+struct static_hash<
+    Key, std::enable_if_t<std::is_integral_v<Key> || std::is_enum_v<Key>>> {
+    constexpr uint64_t operator()(Key key, uint64_t seed) const {
+        return static_map_detail::mix(static_cast<uint64_t>(key) ^ seed);
+    }
+};
+
+// 字符串视图：每次取 8 字节混合一次
+template <typename CharT, typename Traits>
+struct static_hash<basic_string_view<CharT, Traits>> {
+    constexpr uint64_t operator()(basic_string_view<CharT, Traits> key,
+                                  uint64_t seed) const {
+        constexpr size_t kChunk = 8 / sizeof(CharT);
+        const CharT* p = key.data();
+        size_t n = key.size();
+        uint64_t h = seed ^ (n * 0x9E3779B97F4A7C15ull);
+        for (; n >= kChunk; n -= kChunk, p += kChunk) {
+            h = static_map_detail::mix(h ^ static_map_detail::load(p, kChunk));
+        }
+        if (n != 0) {
+            h = static_map_detail::mix(h ^ static_map_detail::load(p, n));
+        }
+        return h;
+    }
+};
+
+// 模板类：static_map
+// 模板参数 Key 代表键的类型，T 代表值的类型，N 代表元素个数，
+// Hash 代表带种子的哈希函数；Key 与 T 需要可以默认构造
+// 哈希值的低 32 位决定桶，桶的扰动值与哈希值异或后由高位决定槽位
+template <typename Key, typename T, size_t N,
+          typename Hash = static_hash<Key>>
+class static_map {
+    static_assert(N > 0, "static_map needs at least one key");
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = pair<Key, T>;
+    using size_type = size_t;
+    using hasher = Hash;
+
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+private:
+    array<value_type, N> slots_{};
+    array<uint64_t, N> pilots_{};
+    uint64_t seed_ = 0;
+    [[no_unique_address]] Hash hash_{};
+
+public:
+    // 键重复时抛出 std::invalid_argument，在常量求值中表现为编译错误
+    constexpr explicit static_map(const value_type (&items)[N]) {
+        for (uint64_t s = 0; s < static_map_detail::kMaxSeeds; ++s) {
+            if (build(items, static_map_detail::mix(s))) {
+                return;
+            }
+        }
+        throw std::logic_error("static_map: failed to find a perfect hash");
+    }
+
+public:
+    // 迭代器相关操作，按槽位顺序遍历
+    constexpr const_iterator begin() const noexcept { return slots_.begin(); }
+    constexpr const_iterator end() const noexcept { return slots_.end(); }
+
+    // 容量相关操作
+    constexpr bool empty() const noexcept { return false; }
+    constexpr size_type size() const noexcept { return N; }
+
+    // 查找相关操作
+    constexpr const_iterator find(const key_type& key) const {
+        const value_type& slot = slots_[slot_of(hash_(key, seed_))];
+        return slot.first == key ? &slot : end();
+    }
+
+    constexpr bool contains(const key_type& key) const {
+        return find(key) != end();
+    }
+
+    constexpr size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    constexpr const mapped_type& at(const key_type& key) const {
+        const_iterator it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("static_map<Key, T>::at() key not found");
+        }
+        return it->second;
+    }
+
+private:
+    static constexpr size_t bucket_of(uint64_t h) {
+        return static_cast<size_t>((static_cast<uint32_t>(h) * N) >> 32);
+    }
+
+    constexpr size_t slot_of(uint64_t h) const {
+        return static_map_detail::reduce(h ^ pilots_[bucket_of(h)], N);
+    }
+
+    // 用种子 seed 尝试构造，两个不同的键哈希值完全相同时返回 false
+    constexpr bool build(const value_type (&items)[N], uint64_t seed) {
+        array<uint64_t, N> hashes{};
+        array<size_t, N + 1> starts{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = hash_(items[i].first, seed);
+            ++starts[bucket_of(hashes[i]) + 1];
+        }
+        for (size_t b = 0; b < N; ++b) {
+            starts[b + 1] += starts[b];
+        }
+        // members 中按桶连续存放元素下标，starts[b] 为桶 b 的起点
+        array<size_t, N> members{};
+        array<size_t, N> fill = to_array<size_t, N>(starts.begin());
+        for (size_t i = 0; i < N; ++i) {
+            members[fill[bucket_of(hashes[i])]++] = i;
+        }
+
+        // 大桶先放，此时空槽位还多；只有一个键的桶最后直接放进剩下的空槽位
+        array<size_t, N> order{};
+        for (size_t b = 0; b < N; ++b) {
+            order[b] = b;
+        }
+        mystl::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+        });
+
+        array<bool, N> taken{};
+        array<uint64_t, N> pilots{};
+        size_t free_slot = 0;
+        for (size_t b : order) {
+            const size_t* first = members.begin() + starts[b];
+            const size_t* last = members.begin() + starts[b + 1];
+            if (last - first == 1) {
+                // 扰动值直接取成哈希值与一个映射到目标槽位的数的异或
+                while (taken[free_slot]) {
+                    ++free_slot;
+                }
+                pilots[b] = hashes[*first] ^
+                            static_map_detail::preimage(free_slot, N);
+                taken[free_slot] = true;
+            } else if (last - first > 1) {
+                if (!place_bucket(items, hashes, first, last, taken,
+                                  pilots[b])) {
+                    return false;
+                }
+            }
+        }
+
+        seed_ = seed;
+        pilots_ = pilots;
+        for (size_t i = 0; i < N; ++i) {
+            slots_[slot_of(hashes[i])] = items[i];
+        }
+        return true;
+    }
+
+    // 为一个桶寻找扰动值，使桶内的键落在互不相同的空槽位上
+    constexpr bool place_bucket(const value_type (&items)[N],
+                                const array<uint64_t, N>& hashes,
+                                const size_t* first, const size_t* last,
+                                array<bool, N>& taken, uint64_t& pilot) {
+        for (const size_t* i = first; i != last; ++i) {
+            for (const size_t* j = first; j != i; ++j) {
+                if (hashes[*i] != hashes[*j]) {
+                    continue;
+                }
+                if (items[*i].first == items[*j].first) {
+                    throw std::invalid_argument("static_map: duplicate key");
+                }
+                return false;
+            }
+        }
+
+        for (uint64_t d = 0; d < static_map_detail::kMaxPilot; ++d) {
+            const uint64_t p = static_map_detail::mix(d + 1);
+            const size_t* i = first;
+            for (; i != last; ++i) {
+                const size_t slot =
+                    static_map_detail::reduce(hashes[*i] ^ p, N);
+                if (taken[slot]) {
+                    break;
+                }
+                taken[slot] = true;
+            }
+            if (i == last) {
+                pilot = p;
+                return true;
+            }
+            // 撤销这一轮已经占用的槽位
+            for (const size_t* j = first; j != i; ++j) {
+                taken[static_map_detail::reduce(hashes[*j] ^ p, N)] = false;
+            }
+        }
+        return false;
+    }
+};
+
+// 从花括号列表构造，自动推导元素个数
+template <typename Key, typename T, size_t N>
+constexpr static_map<Key, T, N> make_static_map(
+    const pair<Key, T> (&items)[N]) {
+    return static_map<Key, T, N>(items);
+}
+
+}  // namespace mystl
@@ -0,0 +1,759 @@
+#pragma once
+
+// 这个头文件包含模板类 basic_string
+// basic_string : 带短字符串优化 (SSO) 的字符串，对象大小为三个指针
+//                char 时最多 22 个字符直接存放在对象内部，不分配堆内存
+//                对象的最后一个字节是标记：短字符串时存放长度，
+//                长字符串时最高位为 1，此时前面依次是指针、长度和容量
+// 查找和比较通过 basic_string_view 完成，单个字符的查找使用 SIMD 内核
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "string_view.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 模板类：basic_string
+// 模板参数 CharT 代表字符类型，Traits 代表字符操作，Alloc 代表空间配置器
+template <typename CharT, typename Traits = mystl::char_traits<CharT>,
+          typename Alloc = mystl::allocator<CharT>>
+class basic_string {
+    static_assert(std::is_trivial_v<CharT>, "CharT must be a trivial type");
+
+public:
+    using traits_type = Traits;
+    using allocator_type = Alloc;
+    using value_type = CharT;
+    using pointer = CharT*;
+    using const_pointer = const CharT*;
+    using reference = CharT&;
+    using const_reference = const CharT&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = CharT*;
+    using const_iterator = const CharT*;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    using view_type = basic_string_view<CharT, Traits>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    struct long_rep {
+        CharT* ptr;
+        size_type size;
+        size_type cap;  // 编码后的容量，见 encode_cap
+    };
+
+    static constexpr size_type kRepBytes = sizeof(long_rep);
+    static constexpr unsigned char kLongTag = 0x80;
+
+public:
+    // 对象内部最多能存放的字符个数，另外还要留出结尾的空字符和标记字节
+    static constexpr size_type inline_capacity =
+        (kRepBytes - 1) / sizeof(CharT) - 1;
+
+private:
+    union rep {
+        long_rep l;
+        CharT buf[inline_capacity + 1];
+        unsigned char bytes[kRepBytes];
+    };
+
+    rep rep_;
+    [[no_unique_address]] Alloc alloc_;
+
+public:
+    // 构造、复制、移动、析构函数
+    basic_string() noexcept(noexcept(Alloc())) : alloc_() { init_short(); }
+
+    explicit basic_string(const Alloc& alloc) : alloc_(alloc) {
+        init_short();
+    }
+
+    basic_string(size_type n, CharT c, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_short();
+        Traits::assign(prepare(n), n, c);
+    }
+
+    basic_string(const CharT* s, size_type n, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_short();
+        Traits::copy(prepare(n), s, n);
+    }
+
+    basic_string(const CharT* s, const Alloc& alloc = Alloc())
+        : basic_string(s, Traits::length(s), alloc) {}
+
+    basic_string(std::nullptr_t) = delete;
+
+    explicit basic_string(view_type sv, const Alloc& alloc = Alloc())
+        : basic_string(sv.data(), sv.size(), alloc) {}
+
+    basic_string(const basic_string& rhs, size_type pos, size_type n = npos,
+                 const Alloc& alloc = Alloc())
+        : basic_string(view_type(rhs).substr(pos, n), alloc) {}
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    basic_string(Iter first, Iter last, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_short();
+        append(first, last);
+    }
+
+    basic_string(std::initializer_list<CharT> ilist,
+                 const Alloc& alloc = Alloc())
+        : basic_string(ilist.begin(), ilist.size(), alloc) {}
+
+    basic_string(const basic_string& rhs)
+        : basic_string(rhs.data(), rhs.size(), rhs.alloc_) {}
+
+    basic_string(basic_string&& rhs) noexcept
+        : rep_(rhs.rep_), alloc_(mystl::move(rhs.alloc_)) {
+        rhs.init_short();
+    }
+
+    basic_string& operator=(const basic_string& rhs) {
+        if (this != &rhs) {
+            assign(rhs.data(), rhs.size());
+        }
+        return *this;
+    }
+
+    // 与移动构造一样连同分配器一起接管 rhs 的空间，不会抛出异常
+    basic_string& operator=(basic_string&& rhs) noexcept {
+        if (this != &rhs) {
+            deallocate_storage();
+            rep_ = rhs.rep_;
+            alloc_ = mystl::move(rhs.alloc_);
+            rhs.init_short();
+        }
+        return *this;
+    }
+
+    basic_string& operator=(const CharT* s) { return assign(s); }
+    basic_string& operator=(view_type sv) { return assign(sv); }
+    basic_string& operator=(CharT c) { return assign(1, c); }
+    basic_string& operator=(std::initializer_list<CharT> ilist) {
+        return assign(ilist.begin(), ilist.size());
+    }
+
+    ~basic_string() { deallocate_storage(); }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return data(); }
+    const_iterator begin() const noexcept { return data(); }
+    iterator end() noexcept { return data() + size(); }
+    const_iterator end() const noexcept { return data() + size(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept {
+        return is_long() ? rep_.l.size : tag();
+    }
+    size_type length() const noexcept { return size(); }
+    size_type max_size() const noexcept {
+        return (static_cast<size_type>(-1) >> 8) / sizeof(CharT) - 1;
+    }
+    size_type capacity() const noexcept {
+        return is_long() ? decode_cap(rep_.l.cap) : inline_capacity;
+    }
+
+    void reserve(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("n can not larger than max_size() in "
+                                    "basic_string<CharT>::reserve(n)");
+        }
+        if (n > capacity()) {
+            reallocate(n);
+        }
+    }
+
+    // 放弃多余的容量，长度不超过 inline_capacity 时搬回对象内部
+    void shrink_to_fit() {
+        if (is_long() && size() < capacity()) {
+            reallocate(size());
+        }
+    }
+
+    // 访问元素相关操作
+    reference operator[](size_type n) { return data()[n]; }
+    const_reference operator[](size_type n) const { return data()[n]; }
+
+    reference at(size_type n) {
+        check_index(n);
+        return data()[n];
+    }
+    const_reference at(size_type n) const {
+        check_index(n);
+        return data()[n];
+    }
+
+    reference front() { return data()[0]; }
+    const_reference front() const { return data()[0]; }
+    reference back() { return data()[size() - 1]; }
+    const_reference back() const { return data()[size() - 1]; }
+
+    pointer data() noexcept { return is_long() ? rep_.l.ptr : rep_.buf; }
+    const_pointer data() const noexcept {
+        return is_long() ? rep_.l.ptr : rep_.buf;
+    }
+    const_pointer c_str() const noexcept { return data(); }
+
+    operator view_type() const noexcept { return view_type(data(), size()); }
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    // 修改容器相关操作
+
+    // assign
+    basic_string& assign(const CharT* s, size_type n) {
+        if (n <= capacity()) {
+            // s 可能指向自身，使用 move
+            Traits::move(data(), s, n);
+            set_size(n);
+        } else {
+            basic_string tmp(s, n, alloc_);
+            swap(tmp);
+        }
+        return *this;
+    }
+    basic_string& assign(const CharT* s) {
+        return assign(s, Traits::length(s));
+    }
+    basic_string& assign(view_type sv) { return assign(sv.data(), sv.size()); }
+    basic_string& assign(const basic_string& str) { return *this = str; }
+    basic_string& assign(basic_string&& str) {
+        return *this = mystl::move(str);
+    }
+    basic_string& assign(size_type n, CharT c) {
+        clear();
+        Traits::assign(prepare(n), n, c);
+        return *this;
+    }
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    basic_string& assign(Iter first, Iter last) {
+        clear();
+        return append(first, last);
+    }
+
+    // append / operator+= / push_back / pop_back
+    basic_string& append(const CharT* s, size_type n) {
+        const size_type old_size = size();
+        if (n <= capacity() - old_size) {
+            Traits::copy(data() + old_size, s, n);
+            set_size(old_size + n);
+        } else {
+            // 新空间中先放好原有内容再复制 s，s 指向自身时仍然有效
+            const size_type new_cap = next_capacity(n);
+            CharT* p = allocate_for(new_cap);
+            Traits::copy(p, data(), old_size);
+            Traits::copy(p + old_size, s, n);
+            install(p, old_size + n, new_cap);
+        }
+        return *this;
+    }
+    basic_string& append(const CharT* s) {
+        return append(s, Traits::length(s));
+    }
+    basic_string& append(view_type sv) { return append(sv.data(), sv.size()); }
+    basic_string& append(const basic_string& str) {
+        return append(str.data(), str.size());
+    }
+    basic_string& append(size_type n, CharT c) {
+        const size_type old_size = size();
+        if (n > capacity() - old_size) {
+            reallocate(next_capacity(n));
+        }
+        Traits::assign(data() + old_size, n, c);
+        set_size(old_size + n);
+        return *this;
+    }
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    basic_string& append(Iter first, Iter last) {
+        if constexpr (is_contiguous_iterator_v<Iter> &&
+                      std::is_same_v<typename iterator_traits<Iter>::value_type,
+                                     CharT>) {
+            return append(mystl::to_address(first),
+                          static_cast<size_type>(last - first));
+        } else if constexpr (is_forward_iterator<Iter>::value) {
+            const auto n = static_cast<size_type>(mystl::distance(first, last));
+            const size_type old_size = size();
+            if (n > capacity() - old_size) {
+                // 迭代器可能指向自身，先构造出临时字符串
+                basic_string tmp(first, last, alloc_);
+                return append(tmp.data(), tmp.size());
+            }
+            CharT* p = data() + old_size;
+            for (; first != last; ++first, ++p) {
+                *p = *first;
+            }
+            set_size(old_size + n);
+            return *this;
+        } else {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+            return *this;
+        }
+    }
+    basic_string& append(std::initializer_list<CharT> ilist) {
+        return append(ilist.begin(), ilist.size());
+    }
+
+    basic_string& operator+=(const basic_string& str) { return append(str); }
+    basic_string& operator+=(const CharT* s) { return append(s); }
+    basic_string& operator+=(view_type sv) { return append(sv); }
+    basic_string& operator+=(CharT c) {
+        push_back(c);
+        return *this;
+    }
+    basic_string& operator+=(std::initializer_list<CharT> ilist) {
+        return append(ilist);
+    }
+
+    void push_back(CharT c) {
+        const size_type n = size();
+        if (n == capacity()) {
+            reallocate(next_capacity(1));
+        }
+        data()[n] = c;
+        set_size(n + 1);
+    }
+
+    void pop_back() { set_size(size() - 1); }
+
+    // 把长度改为 n，由 op(data(), n) 直接写入字符内容并返回最终长度
+    // 新增的部分不会先被初始化，适合把格式化、解码的结果直接写进字符串
+    // 扩容按几何增长，反复追加时均摊为常数
+    template <typename Operation>
+    void resize_and_overwrite(size_type n, Operation op) {
+        const size_type old_size = size();
+        if (n > capacity()) {
+            reallocate(next_capacity(n - old_size));
+        }
+        const auto new_size =
+            static_cast<size_type>(mystl::move(op)(data(), n));
+        set_size(new_size);
+    }
+
+    // insert
+    basic_string& insert(size_type pos, const CharT* s, size_type n) {
+        return replace(pos, 0, s, n);
+    }
+    basic_string& insert(size_type pos, const CharT* s) {
+        return insert(pos, s, Traits::length(s));
+    }
+    basic_string& insert(size_type pos, view_type sv) {
+        return insert(pos, sv.data(), sv.size());
+    }
+    basic_string& insert(size_type pos, const basic_string& str) {
+        return insert(pos, str.data(), str.size());
+    }
+    basic_string& insert(size_type pos, size_type n, CharT c) {
+        check_position(pos);
+        Traits::assign(make_room(pos, 0, n), n, c);
+        return *this;
+    }
+    iterator insert(const_iterator pos, CharT c) {
+        const auto offset = static_cast<size_type>(pos - begin());
+        insert(offset, 1, c);
+        return begin() + offset;
+    }
+
+    // erase / clear
+    basic_string& erase(size_type pos = 0, size_type n = npos) {
+        check_position(pos);
+        make_room(pos, clamp_count(pos, n), 0);
+        return *this;
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto offset = static_cast<size_type>(first - begin());
+        make_room(offset, static_cast<size_type>(last - first), 0);
+        return begin() + offset;
+    }
+
+    void clear() noexcept { set_size(0); }
+
+    // replace
+    // 把 [pos, pos + n1) 替换为 [s, s + n2)
+    basic_string& replace(size_type pos, size_type n1, const CharT* s,
+                          size_type n2) {
+        check_position(pos);
+        n1 = clamp_count(pos, n1);
+        if (aliases(s)) {
+            const basic_string tmp(s, n2, alloc_);
+            Traits::copy(make_room(pos, n1, n2), tmp.data(), n2);
+        } else {
+            Traits::copy(make_room(pos, n1, n2), s, n2);
+        }
+        return *this;
+    }
+    basic_string& replace(size_type pos, size_type n, view_type sv) {
+        return replace(pos, n, sv.data(), sv.size());
+    }
+    basic_string& replace(size_type pos, size_type n, const CharT* s) {
+        return replace(pos, n, s, Traits::length(s));
+    }
+
+    // resize
+    void resize(size_type n) { resize(n, CharT()); }
+    void resize(size_type n, CharT c) {
+        const size_type old_size = size();
+        if (n > old_size) {
+            append(n - old_size, c);
+        } else {
+            set_size(n);
+        }
+    }
+
+    // swap
+    void swap(basic_string& rhs) noexcept {
+        if (this != &rhs) {
+            mystl::swap(rep_, rhs.rep_);
+            mystl::swap(alloc_, rhs.alloc_);
+        }
+    }
+
+    // 子串、复制
+    basic_string substr(size_type pos = 0, size_type n = npos) const {
+        return basic_string(view_type(*this).substr(pos, n), alloc_);
+    }
+    size_type copy(CharT* dest, size_type n, size_type pos = 0) const {
+        return view_type(*this).copy(dest, n, pos);
+    }
+
+    // 比较与查找，交给 basic_string_view
+    int compare(view_type sv) const noexcept {
+        return view_type(*this).compare(sv);
+    }
+    int compare(size_type pos, size_type n, view_type sv) const {
+        return view_type(*this).compare(pos, n, sv);
+    }
+    int compare(const CharT* s) const { return compare(view_type(s)); }
+
+    bool starts_with(view_type sv) const noexcept {
+        return view_type(*this).starts_with(sv);
+    }
+    bool starts_with(CharT c) const noexcept {
+        return view_type(*this).starts_with(c);
+    }
+    bool ends_with(view_type sv) const noexcept {
+        return view_type(*this).ends_with(sv);
+    }
+    bool ends_with(CharT c) const noexcept {
+        return view_type(*this).ends_with(c);
+    }
+    bool contains(view_type sv) const noexcept {
+        return view_type(*this).contains(sv);
+    }
+    bool contains(CharT c) const noexcept {
+        return view_type(*this).contains(c);
+    }
+
+    size_type find(view_type sv, size_type pos = 0) const noexcept {
+        return view_type(*this).find(sv, pos);
+    }
+    size_type find(const CharT* s, size_type pos = 0) const {
+        return view_type(*this).find(s, pos);
+    }
+    size_type find(CharT c, size_type pos = 0) const noexcept {
+        return view_type(*this).find(c, pos);
+    }
+    size_type rfind(view_type sv, size_type pos = npos) const noexcept {
+        return view_type(*this).rfind(sv, pos);
+    }
+    size_type rfind(CharT c, size_type pos = npos) const noexcept {
+        return view_type(*this).rfind(c, pos);
+    }
+    size_type find_first_of(view_type sv, size_type pos = 0) const noexcept {
+        return view_type(*this).find_first_of(sv, pos);
+    }
+    size_type find_last_of(view_type sv,
+                           size_type pos = npos) const noexcept {
+        return view_type(*this).find_last_of(sv, pos);
+    }
+    size_type find_first_not_of(view_type sv,
+                                size_type pos = 0) const noexcept {
+        return view_type(*this).find_first_not_of(sv, pos);
+    }
+    size_type find_last_not_of(view_type sv,
+                               size_type pos = npos) const noexcept {
+        return view_type(*this).find_last_not_of(sv, pos);
+    }
+
+    // 重载比较操作符
+    // 另一侧可以是 basic_string、basic_string_view 或字符串字面量
+    friend bool operator==(const basic_string& lhs, view_type rhs) noexcept {
+        return view_type(lhs) == rhs;
+    }
+    friend std::strong_ordering operator<=>(const basic_string& lhs,
+                                            view_type rhs) noexcept {
+        return view_type(lhs) <=> rhs;
+    }
+
+private:
+    unsigned char tag() const noexcept { return rep_.bytes[kRepBytes - 1]; }
+    bool is_long() const noexcept { return (tag() & kLongTag) != 0; }
+
+    // 长字符串的容量与标记共用最后一个字节：
+    // 小端机器上最后一个字节是容量的最高字节，大端机器上是最低字节
+    static size_type encode_cap(size_type cap) noexcept {
+        if constexpr (std::endian::native == std::endian::little) {
+            return cap | (static_cast<size_type>(kLongTag)
+                          << (8 * (sizeof(size_type) - 1)));
+        } else {
+            return (cap << 8) | kLongTag;
+        }
+    }
+    static size_type decode_cap(size_type cap) noexcept {
+        if constexpr (std::endian::native == std::endian::little) {
+            return cap & (static_cast<size_type>(-1) >> 8);
+        } else {
+            return cap >> 8;
+        }
+    }
+
+    void init_short() noexcept {
+        rep_.bytes[kRepBytes - 1] = 0;
+        rep_.buf[0] = CharT();
+    }
+
+    // 修改长度并写入结尾的空字符
+    void set_size(size_type n) noexcept {
+        if (is_long()) {
+            rep_.l.size = n;
+            rep_.l.ptr[n] = CharT();
+        } else {
+            rep_.bytes[kRepBytes - 1] = static_cast<unsigned char>(n);
+            rep_.buf[n] = CharT();
+        }
+    }
+
+    void deallocate_storage() noexcept {
+        if (is_long()) {
+            alloc_.deallocate(rep_.l.ptr, decode_cap(rep_.l.cap) + 1);
+        }
+    }
+
+    // 申请能容纳 cap 个字符 (以及结尾的空字符) 的空间
+    CharT* allocate_for(size_type cap) { return alloc_.allocate(cap + 1); }
+
+    // 释放原有空间，改用 allocate_for(cap) 得到的 p，其中已有 n 个字符
+    void install(CharT* p, size_type n, size_type cap) noexcept {
+        deallocate_storage();
+        rep_.l.ptr = p;
+        rep_.l.size = n;
+        rep_.l.cap = encode_cap(cap);
+        p[n] = CharT();
+    }
+
+    // 把存储空间换成能容纳 new_cap 个字符的空间，不超过 inline_capacity 时换回对象内部
+    void reallocate(size_type new_cap) {
+        const size_type n = size();
+        if (new_cap <= inline_capacity) {
+            if (is_long()) {
+                CharT* old = rep_.l.ptr;
+                const size_type old_cap = decode_cap(rep_.l.cap);
+                Traits::copy(rep_.buf, old, n);
+                rep_.bytes[kRepBytes - 1] = static_cast<unsigned char>(n);
+                rep_.buf[n] = CharT();
+                alloc_.deallocate(old, old_cap + 1);
+            }
+            return;
+        }
+        CharT* p = allocate_for(new_cap);
+        Traits::copy(p, data(), n);
+        install(p, n, new_cap);
+    }
+
+    // 扩容策略：至少容纳新增的 add 个字符，否则按两倍增长
+    size_type next_capacity(size_type add) const {
+        const size_type old_size = size();
+        if (add > max_size() - old_size) {
+            throw std::length_error("basic_string<CharT>'s size too big");
+        }
+        const size_type old_cap = capacity();
+        const size_type grown =
+            old_cap > max_size() / 2 ? max_size() : old_cap * 2;
+        return grown > old_size + add ? grown : old_size + add;
+    }
+
+    // 把空字符串的长度设为 n，返回写入字符的位置，用于构造函数
+    CharT* prepare(size_type n) {
+        reserve(n);
+        set_size(n);
+        return data();
+    }
+
+    // 把 [pos, pos + n1) 换成 n2 个未初始化的字符，返回它们的起始位置
+    CharT* make_room(size_type pos, size_type n1, size_type n2) {
+        const size_type old_size = size();
+        const size_type tail = old_size - pos - n1;
+        if (n2 <= n1 || n2 - n1 <= capacity() - old_size) {
+            CharT* p = data();
+            Traits::move(p + pos + n2, p + pos + n1, tail);
+            set_size(old_size - n1 + n2);
+            return p + pos;
+        }
+        const size_type new_cap = next_capacity(n2 - n1);
+        CharT* old = data();
+        CharT* p = allocate_for(new_cap);
+        Traits::copy(p, old, pos);
+        Traits::copy(p + pos + n2, old + pos + n1, tail);
+        install(p, old_size - n1 + n2, new_cap);
+        return p + pos;
+    }
+
+    // s 是否指向自身的字符
+    bool aliases(const CharT* s) const noexcept {
+        const CharT* p = data();
+        return std::greater_equal<const CharT*>()(s, p) &&
+               std::less_equal<const CharT*>()(s, p + size());
+    }
+
+    void check_index(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range(
+                "basic_string<CharT>::at() subscript out of range");
+        }
+    }
+
+    void check_position(size_type pos) const {
+        if (pos > size()) {
+            throw std::out_of_range(
+                "basic_string<CharT> position out of range");
+        }
+    }
+
+    size_type clamp_count(size_type pos, size_type n) const noexcept {
+        const size_type rest = size() - pos;
+        return n < rest ? n : rest;
+    }
+};
+
+// 重载 operator+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    const basic_string<CharT, Traits, Alloc>& lhs,
+    const basic_string<CharT, Traits, Alloc>& rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs.get_allocator());
+    result.reserve(lhs.size() + rhs.size());
+    result.append(lhs).append(rhs);
+    return result;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs.get_allocator());
+    const size_t n = Traits::length(rhs);
+    result.reserve(lhs.size() + n);
+    result.append(lhs).append(rhs, n);
+    return result;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    basic_string<CharT, Traits, Alloc> result(rhs.get_allocator());
+    const size_t n = Traits::length(lhs);
+    result.reserve(n + rhs.size());
+    result.append(lhs, n).append(rhs);
+    return result;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    const basic_string<CharT, Traits, Alloc>& lhs, CharT rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs);
+    result.push_back(rhs);
+    return result;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    CharT lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    basic_string<CharT, Traits, Alloc> result(1, lhs, rhs.get_allocator());
+    result.append(rhs);
+    return result;
+}
+
+// 左侧是右值时直接在它上面追加
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    basic_string<CharT, Traits, Alloc>&& lhs,
+    const basic_string<CharT, Traits, Alloc>& rhs) {
+    return mystl::move(lhs.append(rhs));
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    basic_string<CharT, Traits, Alloc>&& lhs, const CharT* rhs) {
+    return mystl::move(lhs.append(rhs));
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc> operator+(
+    basic_string<CharT, Traits, Alloc>&& lhs, CharT rhs) {
+    lhs.push_back(rhs);
+    return mystl::move(lhs);
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+void swap(basic_string<CharT, Traits, Alloc>& lhs,
+          basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename CharT, typename Traits, typename Alloc, typename OTraits>
+std::basic_ostream<CharT, OTraits>& operator<<(
+    std::basic_ostream<CharT, OTraits>& os,
+    const basic_string<CharT, Traits, Alloc>& str) {
+    return os << basic_string_view<CharT, Traits>(str);
+}
+
+using string = basic_string<char>;
+using wstring = basic_string<wchar_t>;
+using u16string = basic_string<char16_t>;
+using u32string = basic_string<char32_t>;
+
+}  // namespace mystl
+
+template <typename CharT, typename Traits, typename Alloc>
+struct std::hash<mystl::basic_string<CharT, Traits, Alloc>> {
+    size_t operator()(
+        const mystl::basic_string<CharT, Traits, Alloc>& str) const noexcept {
+        return std::hash<mystl::basic_string_view<CharT, Traits>>()(str);
+    }
+};
@@ -0,0 +1,404 @@
+#pragma once
+
+// 这个头文件包含 char_traits 和模板类 basic_string_view
+// char_traits      : 字符的比较、查找、复制，单字节字符使用 memcmp / memchr，
+//                    更宽的字符交给 simd.hpp 中的 SIMD 内核
+// basic_string_view : 只读的字符串视图，只保存指针和长度，不拥有也不复制字符
+// 构造与比较可以在常量求值中使用 (此时逐个字符比较)，便于作为编译期表的键
+// 子串查找先用 SIMD 找到首字符的候选位置，再比较剩下的部分
+
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "iterator.hpp"
+#include "simd.hpp"
+
+namespace mystl {
+
+// 模板类：char_traits
+template <typename CharT>
+struct char_traits {
+    using char_type = CharT;
+
+    static constexpr bool eq(CharT a, CharT b) noexcept { return a == b; }
+    // char 按无符号数比较，与 memcmp 的结果一致
+    static constexpr bool lt(CharT a, CharT b) noexcept {
+        using U = std::make_unsigned_t<CharT>;
+        return static_cast<U>(a) < static_cast<U>(b);
+    }
+
+    static constexpr size_t length(const CharT* s) noexcept {
+        if (std::is_constant_evaluated()) {
+            size_t n = 0;
+            while (s[n] != CharT()) {
+                ++n;
+            }
+            return n;
+        }
+        if constexpr (sizeof(CharT) == 1) {
+            return std::strlen(reinterpret_cast<const char*>(s));
+        } else {
+            size_t n = 0;
+            while (s[n] != CharT()) {
+                ++n;
+            }
+            return n;
+        }
+    }
+
+    static constexpr int compare(const CharT* a, const CharT* b,
+                                 size_t n) noexcept {
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                if (!eq(a[i], b[i])) {
+                    return lt(a[i], b[i]) ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+        if constexpr (sizeof(CharT) == 1) {
+            return n == 0 ? 0 : std::memcmp(a, b, n);
+        } else {
+            const size_t i = simd_detail::mismatch(a, b, n);
+            if (i == n) {
+                return 0;
+            }
+            return lt(a[i], b[i]) ? -1 : 1;
+        }
+    }
+
+    // 返回 [s, s + n) 中第一个等于 c 的位置，找不到时返回 nullptr
+    // 单字节字符使用 libc 的 memchr (本身就是向量化的)，更宽的字符使用 SIMD 内核
+    static const CharT* find(const CharT* s, size_t n, CharT c) noexcept {
+        if constexpr (sizeof(CharT) == 1) {
+            return n == 0 ? nullptr
+                          : static_cast<const CharT*>(std::memchr(s, c, n));
+        } else {
+            const CharT* p = simd_detail::find(s, s + n, c);
+            return p == s + n ? nullptr : p;
+        }
+    }
+
+    static CharT* copy(CharT* dest, const CharT* src, size_t n) noexcept {
+        if (n != 0) {
+            std::memcpy(dest, src, n * sizeof(CharT));
+        }
+        return dest;
+    }
+
+    static CharT* move(CharT* dest, const CharT* src, size_t n) noexcept {
+        if (n != 0) {
+            std::memmove(dest, src, n * sizeof(CharT));
+        }
+        return dest;
+    }
+
+    static CharT* assign(CharT* dest, size_t n, CharT c) noexcept {
+        simd_detail::fill(dest, dest + n, c);
+        return dest;
+    }
+};
+
+// 模板类：basic_string_view
+// 模板参数 CharT 代表字符类型，Traits 代表字符操作
+template <typename CharT, typename Traits = mystl::char_traits<CharT>>
+class basic_string_view {
+public:
+    using traits_type = Traits;
+    using value_type = CharT;
+    using pointer = CharT*;
+    using const_pointer = const CharT*;
+    using reference = CharT&;
+    using const_reference = const CharT&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = const CharT*;
+    using const_iterator = const CharT*;
+    using reverse_iterator = mystl::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    const CharT* data_ = nullptr;
+    size_type size_ = 0;
+
+public:
+    constexpr basic_string_view() noexcept = default;
+    constexpr basic_string_view(const CharT* s, size_type n) noexcept
+        : data_(s), size_(n) {}
+    constexpr basic_string_view(const CharT* s) noexcept
+        : data_(s), size_(Traits::length(s)) {}
+
+    basic_string_view(std::nullptr_t) = delete;
+
+public:
+    // 迭代器相关操作
+    constexpr const_iterator begin() const noexcept { return data_; }
+    constexpr const_iterator end() const noexcept { return data_ + size_; }
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // 容量相关操作
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type length() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr size_type max_size() const noexcept {
+        return static_cast<size_type>(-1) / sizeof(CharT) / 2;
+    }
+
+    // 访问元素相关操作
+    constexpr const_reference operator[](size_type n) const {
+        return data_[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range(
+                "basic_string_view<CharT>::at() subscript out of range");
+        }
+        return data_[n];
+    }
+    constexpr const_reference front() const { return data_[0]; }
+    constexpr const_reference back() const { return data_[size_ - 1]; }
+    constexpr const_pointer data() const noexcept { return data_; }
+
+    // 修改视图
+    constexpr void remove_prefix(size_type n) noexcept {
+        data_ += n;
+        size_ -= n;
+    }
+    constexpr void remove_suffix(size_type n) noexcept { size_ -= n; }
+
+    constexpr void swap(basic_string_view& rhs) noexcept {
+        const basic_string_view tmp = *this;
+        *this = rhs;
+        rhs = tmp;
+    }
+
+    // 把 [pos, pos + n) 复制到 dest，返回复制的字符个数
+    size_type copy(CharT* dest, size_type n, size_type pos = 0) const {
+        const size_type len = clamp_count(pos, n);
+        Traits::copy(dest, data_ + pos, len);
+        return len;
+    }
+
+    basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+        return basic_string_view(data_ + pos, clamp_count(pos, n));
+    }
+
+    // compare
+    constexpr int compare(basic_string_view rhs) const noexcept {
+        const size_type n = size_ < rhs.size_ ? size_ : rhs.size_;
+        const int r = Traits::compare(data_, rhs.data_, n);
+        if (r != 0) {
+            return r;
+        }
+        return size_ < rhs.size_ ? -1 : (size_ > rhs.size_ ? 1 : 0);
+    }
+    int compare(size_type pos, size_type n, basic_string_view rhs) const {
+        return substr(pos, n).compare(rhs);
+    }
+    int compare(const CharT* s) const { return compare(basic_string_view(s)); }
+
+    bool starts_with(basic_string_view s) const noexcept {
+        return size_ >= s.size_ &&
+               Traits::compare(data_, s.data_, s.size_) == 0;
+    }
+    bool starts_with(CharT c) const noexcept {
+        return !empty() && Traits::eq(front(), c);
+    }
+    bool ends_with(basic_string_view s) const noexcept {
+        return size_ >= s.size_ &&
+               Traits::compare(data_ + (size_ - s.size_), s.data_, s.size_) ==
+                   0;
+    }
+    bool ends_with(CharT c) const noexcept {
+        return !empty() && Traits::eq(back(), c);
+    }
+    bool contains(basic_string_view s) const noexcept {
+        return find(s) != npos;
+    }
+    bool contains(CharT c) const noexcept { return find(c) != npos; }
+
+    // find
+    size_type find(CharT c, size_type pos = 0) const noexcept {
+        if (pos >= size_) {
+            return npos;
+        }
+        const CharT* p = Traits::find(data_ + pos, size_ - pos, c);
+        return p == nullptr ? npos : static_cast<size_type>(p - data_);
+    }
+
+    // 先找首字符再比较剩下的部分，首字符的查找由 SIMD 完成
+    size_type find(basic_string_view s, size_type pos = 0) const noexcept {
+        if (s.size_ == 0) {
+            return pos <= size_ ? pos : npos;
+        }
+        if (pos >= size_ || s.size_ > size_ - pos) {
+            return npos;
+        }
+        const CharT first = s.data_[0];
+        const CharT* cur = data_ + pos;
+        const CharT* const last = data_ + (size_ - s.size_) + 1;
+        while (cur < last) {
+            cur = Traits::find(cur, static_cast<size_type>(last - cur), first);
+            if (cur == nullptr) {
+                return npos;
+            }
+            if (Traits::compare(cur + 1, s.data_ + 1, s.size_ - 1) == 0) {
+                return static_cast<size_type>(cur - data_);
+            }
+            ++cur;
+        }
+        return npos;
+    }
+
+    size_type find(const CharT* s, size_type pos = 0) const {
+        return find(basic_string_view(s), pos);
+    }
+
+    // rfind
+    size_type rfind(CharT c, size_type pos = npos) const noexcept {
+        if (size_ == 0) {
+            return npos;
+        }
+        for (size_type i = pos < size_ ? pos + 1 : size_; i-- > 0;) {
+            if (Traits::eq(data_[i], c)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    size_type rfind(basic_string_view s, size_type pos = npos) const noexcept {
+        if (s.size_ > size_) {
+            return npos;
+        }
+        size_type i = size_ - s.size_;
+        if (pos < i) {
+            i = pos;
+        }
+        for (;; --i) {
+            if (Traits::compare(data_ + i, s.data_, s.size_) == 0) {
+                return i;
+            }
+            if (i == 0) {
+                return npos;
+            }
+        }
+    }
+
+    // find_first_of / find_last_of / find_first_not_of / find_last_not_of
+    size_type find_first_of(basic_string_view s,
+                            size_type pos = 0) const noexcept {
+        if (s.size_ == 1) {
+            return find(s.data_[0], pos);
+        }
+        for (size_type i = pos; i < size_; ++i) {
+            if (s.contains(data_[i])) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    size_type find_first_of(CharT c, size_type pos = 0) const noexcept {
+        return find(c, pos);
+    }
+
+    size_type find_last_of(basic_string_view s,
+                           size_type pos = npos) const noexcept {
+        for (size_type i = pos < size_ ? pos + 1 : size_; i-- > 0;) {
+            if (s.contains(data_[i])) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    size_type find_last_of(CharT c, size_type pos = npos) const noexcept {
+        return rfind(c, pos);
+    }
+
+    size_type find_first_not_of(basic_string_view s,
+                                size_type pos = 0) const noexcept {
+        for (size_type i = pos; i < size_; ++i) {
+            if (!s.contains(data_[i])) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    size_type find_first_not_of(CharT c, size_type pos = 0) const noexcept {
+        return find_first_not_of(basic_string_view(&c, 1), pos);
+    }
+
+    size_type find_last_not_of(basic_string_view s,
+                               size_type pos = npos) const noexcept {
+        for (size_type i = pos < size_ ? pos + 1 : size_; i-- > 0;) {
+            if (!s.contains(data_[i])) {
+                return i;
+            }
+        }
+        return npos;
+    }
+    size_type find_last_not_of(CharT c, size_type pos = npos) const noexcept {
+        return find_last_not_of(basic_string_view(&c, 1), pos);
+    }
+
+    // 重载比较操作符
+    // 定义为友元，另一侧可以是能隐式转换为视图的任何类型，!= < > <= >= 由编译器改写
+    friend constexpr bool operator==(basic_string_view lhs,
+                                     basic_string_view rhs) noexcept {
+        return lhs.size_ == rhs.size_ &&
+               Traits::compare(lhs.data_, rhs.data_, lhs.size_) == 0;
+    }
+    friend constexpr std::strong_ordering operator<=>(
+        basic_string_view lhs, basic_string_view rhs) noexcept {
+        return lhs.compare(rhs) <=> 0;
+    }
+
+private:
+    // 检查 pos 并返回从 pos 开始最多 n 个字符时的实际个数
+    size_type clamp_count(size_type pos, size_type n) const {
+        if (pos > size_) {
+            throw std::out_of_range(
+                "basic_string_view<CharT> position out of range");
+        }
+        return n < size_ - pos ? n : size_ - pos;
+    }
+};
+
+template <typename CharT, typename Traits, typename OTraits>
+std::basic_ostream<CharT, OTraits>& operator<<(
+    std::basic_ostream<CharT, OTraits>& os,
+    basic_string_view<CharT, Traits> sv) {
+    return os.write(sv.data(), static_cast<std::streamsize>(sv.size()));
+}
+
+using string_view = basic_string_view<char>;
+using wstring_view = basic_string_view<wchar_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+
+}  // namespace mystl
+
+// 与 std::basic_string_view 的哈希值相同
+template <typename CharT, typename Traits>
+struct std::hash<mystl::basic_string_view<CharT, Traits>> {
+    size_t operator()(
+        mystl::basic_string_view<CharT, Traits> sv) const noexcept {
+        return std::hash<std::basic_string_view<CharT>>()(
+            std::basic_string_view<CharT>(sv.data(), sv.size()));
+    }
+};
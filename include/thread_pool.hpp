@@ -0,0 +1,653 @@
+#pragma once
+
+// 这个头文件包含工作窃取 (work stealing) 线程池
+// thread_pool : 每个工作线程有一个 Chase-Lev 双端队列，自己从底部压入、弹出任务，
+//               空闲时随机选择其他线程从顶部窃取；外部线程提交的任务进入一个共享的注入队列
+// future      : submit 返回的轻量 future，等待时调用线程会帮忙执行其他任务
+// task_group  : fork-join，spawn 派生任务，sync 等待所有派生的任务完成
+// parallel_for: 把下标区间递归二分后交给 task_group 执行
+// global()    : 并行算法共用的线程池，线程数为硬件线程数减一 (调用线程也参与计算)，
+//               可以用环境变量 MYSTL_NUM_THREADS 指定包括调用线程在内的总线程数
+// 任务节点和 future 的共享状态都通过 thread_cache_allocator 分配，不经过全局堆
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "deque.hpp"
+#include "util.hpp"
+#include "vector.hpp"
+
+namespace mystl {
+
+class thread_pool;
+
+namespace pool_detail {
+
+// 任务节点，invoke 执行任务后负责析构并释放节点，discard 不执行直接析构并释放
+struct task_node {
+    void (*invoke)(task_node*) noexcept;
+    void (*discard)(task_node*) noexcept;
+};
+
+struct task_deleter {
+    void operator()(task_node* node) const noexcept { node->discard(node); }
+};
+
+// 入队之前由它持有节点，入队失败时释放节点
+using task_ptr = std::unique_ptr<task_node, task_deleter>;
+
+template <typename F>
+struct task_impl : public task_node {
+    F fn;
+
+    explicit task_impl(F&& f)
+        : task_node{&task_impl::run, &task_impl::drop}, fn(mystl::move(f)) {}
+
+    static void run(task_node* node) noexcept {
+        static_cast<task_impl*>(node)->fn();
+        drop(node);
+    }
+
+    static void drop(task_node* node) noexcept {
+        auto* self = static_cast<task_impl*>(node);
+        mystl::destory(self);
+        thread_cache_allocator<task_impl>::deallocate(self);
+    }
+};
+
+template <typename F>
+task_ptr make_task(F&& f) {
+    using node_type = task_impl<std::decay_t<F>>;
+    node_type* node = thread_cache_allocator<node_type>::allocate();
+    try {
+        mystl::construct(node, std::decay_t<F>(mystl::forward<F>(f)));
+    } catch (...) {
+        thread_cache_allocator<node_type>::deallocate(node);
+        throw;
+    }
+    return task_ptr(node);
+}
+
+// Chase-Lev 双端队列 (采用 Lê 等人给出的 C11 内存序版本)
+// 只有所属的工作线程调用 push / pop，其他线程调用 steal
+// 环形数组满时扩容为两倍，旧数组可能仍被窃取者读取，留到析构时才释放
+class work_stealing_deque {
+    struct ring {
+        int64_t capacity;
+        std::atomic<task_node*>* slots;
+
+        task_node* get(int64_t i) const noexcept {
+            return slots[i & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+        void put(int64_t i, task_node* t) noexcept {
+            slots[i & (capacity - 1)].store(t, std::memory_order_relaxed);
+        }
+    };
+
+    using ring_allocator = allocator<ring>;
+    using slot_allocator = allocator<std::atomic<task_node*>>;
+
+    static constexpr int64_t kInitCapacity = 256;
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<ring*> ring_;
+    vector<ring*> retired_;
+
+public:
+    work_stealing_deque() { ring_.store(new_ring(kInitCapacity)); }
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    ~work_stealing_deque() {
+        free_ring(ring_.load());
+        for (ring* r : retired_) {
+            free_ring(r);
+        }
+    }
+
+    void push(task_node* task) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        ring* r = ring_.load(std::memory_order_relaxed);
+        if (b - t > r->capacity - 1) {
+            r = grow(r, t, b);
+        }
+        r->put(b, task);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    task_node* pop() noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* r = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {  // 队列为空
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        task_node* task = r->get(b);
+        if (t == b) {
+            // 只剩最后一个任务，与窃取者竞争
+            if (!top_.compare_exchange_strong(t, t + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    task_node* steal() noexcept {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+        ring* r = ring_.load(std::memory_order_acquire);
+        task_node* task = r->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+private:
+    static ring* new_ring(int64_t capacity) {
+        ring* r = ring_allocator::allocate();
+        r->capacity = capacity;
+        r->slots = slot_allocator::allocate(static_cast<size_t>(capacity));
+        for (int64_t i = 0; i < capacity; ++i) {
+            ::new (static_cast<void*>(r->slots + i))
+                std::atomic<task_node*>(nullptr);
+        }
+        return r;
+    }
+
+    static void free_ring(ring* r) noexcept {
+        slot_allocator::deallocate(r->slots, static_cast<size_t>(r->capacity));
+        ring_allocator::deallocate(r);
+    }
+
+    ring* grow(ring* old, int64_t t, int64_t b) {
+        ring* r = new_ring(old->capacity * 2);
+        for (int64_t i = t; i != b; ++i) {
+            r->put(i, old->get(i));
+        }
+        retired_.push_back(old);
+        ring_.store(r, std::memory_order_release);
+        return r;
+    }
+};
+
+// 当前线程所属的线程池和工作线程编号，外部线程为 nullptr
+struct worker_context {
+    thread_pool* pool = nullptr;
+    size_t index = 0;
+};
+
+inline worker_context& this_worker() noexcept {
+    thread_local worker_context ctx;
+    return ctx;
+}
+
+// future 的共享状态，由 future 和任务各持有一个引用
+template <typename R>
+struct result_storage {
+    alignas(R) unsigned char buf[sizeof(R)];
+
+    R* ptr() noexcept { return reinterpret_cast<R*>(buf); }
+};
+
+template <>
+struct result_storage<void> {};
+
+template <typename R>
+struct future_state {
+    std::atomic<int> refs{2};
+    std::atomic<bool> ready{false};
+    bool has_value = false;
+    std::exception_ptr error;
+    result_storage<R> result;
+
+    ~future_state() {
+        if constexpr (!std::is_void_v<R>) {
+            if (has_value) {
+                mystl::destory(result.ptr());
+            }
+        }
+    }
+
+    void release() noexcept {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            mystl::destory(this);
+            thread_cache_allocator<future_state>::deallocate(this);
+        }
+    }
+};
+
+}  // namespace pool_detail
+
+// submit 返回的 future，只能移动，get 只能调用一次
+template <typename R>
+class future {
+    friend class thread_pool;
+
+    using state_type = pool_detail::future_state<R>;
+
+    thread_pool* pool_ = nullptr;
+    state_type* state_ = nullptr;
+
+    future(thread_pool* pool, state_type* state) noexcept
+        : pool_(pool), state_(state) {}
+
+public:
+    future() = default;
+
+    future(future&& rhs) noexcept : pool_(rhs.pool_), state_(rhs.state_) {
+        rhs.state_ = nullptr;
+    }
+
+    future& operator=(future&& rhs) noexcept {
+        if (this != &rhs) {
+            if (state_ != nullptr) {
+                state_->release();
+            }
+            pool_ = rhs.pool_;
+            state_ = rhs.state_;
+            rhs.state_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~future() {
+        if (state_ != nullptr) {
+            state_->release();
+        }
+    }
+
+    bool valid() const noexcept { return state_ != nullptr; }
+
+    bool ready() const noexcept {
+        return state_->ready.load(std::memory_order_acquire);
+    }
+
+    // 等待结果，等待期间帮忙执行线程池中的任务
+    void wait() const;
+
+    // 取得结果，任务抛出的异常在这里重新抛出
+    R get() {
+        wait();
+        state_type* st = state_;
+        state_ = nullptr;
+        struct releaser {
+            state_type* st;
+            ~releaser() { st->release(); }
+        } guard{st};
+        if (st->error) {
+            std::rethrow_exception(st->error);
+        }
+        if constexpr (!std::is_void_v<R>) {
+            return mystl::move(*st->result.ptr());
+        }
+    }
+};
+
+// fork-join：spawn 派生任务，sync 等待所有任务完成
+// 派生的任务可以继续在同一个 task_group 上 spawn
+class task_group {
+    thread_pool& pool_;
+    std::atomic<size_t> pending_{0};
+    std::mutex mutex_;
+    std::exception_ptr error_;
+
+public:
+    explicit task_group(thread_pool& pool) noexcept : pool_(pool) {}
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    // 析构前必须 sync
+    ~task_group() = default;
+
+    template <typename F>
+    void spawn(F&& f);
+
+    // 等待所有派生的任务完成，期间帮忙执行任务；重新抛出第一个异常
+    void sync();
+};
+
+class thread_pool {
+    friend class task_group;
+    template <typename R>
+    friend class future;
+
+    struct alignas(64) worker {
+        pool_detail::work_stealing_deque tasks;
+        std::thread thread;
+    };
+
+    vector<worker*> workers_;
+
+    // 外部线程提交的任务
+    std::mutex inject_mutex_;
+    deque<pool_detail::task_node*> injected_;
+    std::atomic<size_t> injected_count_{0};
+
+    // 尚未被取走的任务数，以及睡眠中的工作线程数
+    alignas(64) std::atomic<size_t> queued_{0};
+    std::atomic<size_t> sleeping_{0};
+    // task_group 有任务组完成时加一，供阻塞在 sync 中的外部线程等待
+    std::atomic<uint32_t> group_epoch_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+
+    // 空闲时在睡眠前尝试寻找任务的轮数
+    static constexpr int kSpinRounds = 64;
+
+public:
+    explicit thread_pool(size_t threads) {
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.push_back(new worker);
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // 执行完所有已提交的任务后退出
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (worker* w : workers_) {
+            w->thread.join();
+        }
+        // 没有工作线程时由析构线程执行剩下的任务
+        while (run_one(nullptr)) {
+        }
+        for (worker* w : workers_) {
+            delete w;
+        }
+    }
+
+    size_t size() const noexcept { return workers_.size(); }
+
+    // 提交一个任务，不关心返回值，任务不能抛出异常
+    template <typename F>
+    void post(F&& f) {
+        schedule(pool_detail::make_task(mystl::forward<F>(f)));
+    }
+
+    // 提交一个任务，返回可以取得其结果的 future
+    template <typename F>
+    auto submit(F&& f) -> future<std::invoke_result_t<std::decay_t<F>&>> {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        using state_type = pool_detail::future_state<R>;
+        state_type* st = thread_cache_allocator<state_type>::allocate();
+        mystl::construct(st);
+        try {
+            schedule(pool_detail::make_task(
+                [st, fn = std::decay_t<F>(mystl::forward<F>(f))]() mutable {
+                    try {
+                        if constexpr (std::is_void_v<R>) {
+                            fn();
+                        } else {
+                            mystl::construct(st->result.ptr(), fn());
+                            st->has_value = true;
+                        }
+                    } catch (...) {
+                        st->error = std::current_exception();
+                    }
+                    st->ready.store(true, std::memory_order_release);
+                    st->ready.notify_all();
+                    st->release();
+                }));
+        } catch (...) {
+            mystl::destory(st);
+            thread_cache_allocator<state_type>::deallocate(st);
+            throw;
+        }
+        return future<R>(this, st);
+    }
+
+    // 对 [begin, end) 递归二分，长度不超过 grain 的区间调用 fn(b, e)
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& fn) {
+        if (grain == 0) {
+            grain = 1;
+        }
+        task_group group(*this);
+        split_range(group, begin, end, grain, fn);
+        group.sync();
+    }
+
+    static thread_pool& global() {
+        static thread_pool pool(default_concurrency());
+        return pool;
+    }
+
+    static size_t default_concurrency() noexcept {
+        size_t n = std::thread::hardware_concurrency();
+        if (const char* env = std::getenv("MYSTL_NUM_THREADS")) {
+            const long value = std::strtol(env, nullptr, 10);
+            if (value > 0) {
+                n = static_cast<size_t>(value);
+            }
+        }
+        return n > 1 ? n - 1 : 0;
+    }
+
+private:
+    template <typename F>
+    void split_range(task_group& group, size_t begin, size_t end,
+                     size_t grain, F& fn) {
+        while (end - begin > grain) {
+            const size_t mid = begin + (end - begin) / 2;
+            group.spawn([this, &group, mid, end, grain, &fn] {
+                split_range(group, mid, end, grain, fn);
+            });
+            end = mid;
+        }
+        fn(begin, end);
+    }
+
+    // 本线程池的工作线程压入自己的队列，其他线程放入注入队列
+    // 入队时可能因扩容抛出异常，此时 task 仍持有节点并将其释放
+    void schedule(pool_detail::task_ptr task) {
+        const auto& ctx = pool_detail::this_worker();
+        if (ctx.pool == this) {
+            workers_[ctx.index]->tasks.push(task.get());
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            injected_.push_back(task.get());
+            injected_count_.fetch_add(1, std::memory_order_release);
+        }
+        task.release();
+        queued_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_one();
+        }
+    }
+
+    pool_detail::task_node* take_injected() {
+        if (injected_count_.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (injected_.empty()) {
+            return nullptr;
+        }
+        pool_detail::task_node* task = injected_.front();
+        injected_.pop_front();
+        injected_count_.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    // 依次尝试自己的队列、注入队列，再从随机选择的工作线程窃取
+    // self 为 nullptr 表示外部线程
+    pool_detail::task_node* find_task(worker* self, uint64_t& seed) {
+        pool_detail::task_node* task = nullptr;
+        if (self != nullptr && (task = self->tasks.pop()) != nullptr) {
+            return task;
+        }
+        if ((task = take_injected()) != nullptr) {
+            return task;
+        }
+        const size_t n = workers_.size();
+        for (size_t attempt = 0; attempt < n; ++attempt) {
+            // xorshift 随机数
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            worker* victim = workers_[seed % n];
+            if (victim != self && (task = victim->tasks.steal()) != nullptr) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    // 找到一个任务并执行，没有任务时返回 false
+    bool run_one(worker* self) {
+        thread_local uint64_t seed =
+            0x9E3779B97F4A7C15ull ^
+            reinterpret_cast<uintptr_t>(&pool_detail::this_worker());
+        pool_detail::task_node* task = find_task(self, seed);
+        if (task == nullptr) {
+            return false;
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        task->invoke(task);
+        return true;
+    }
+
+    void notify_group_done() noexcept {
+        group_epoch_.fetch_add(1, std::memory_order_release);
+        group_epoch_.notify_all();
+    }
+
+    // 调用线程在等待时帮忙执行任务
+    bool help_one() {
+        const auto& ctx = pool_detail::this_worker();
+        return run_one(ctx.pool == this ? workers_[ctx.index] : nullptr);
+    }
+
+    void worker_loop(size_t index) {
+        auto& ctx = pool_detail::this_worker();
+        ctx.pool = this;
+        ctx.index = index;
+        worker* self = workers_[index];
+        for (;;) {
+            bool found = false;
+            for (int i = 0; i < kSpinRounds && !found; ++i) {
+                found = run_one(self);
+                if (!found) {
+                    std::this_thread::yield();
+                }
+            }
+            if (found) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            while (queued_.load(std::memory_order_seq_cst) == 0 && !stop_) {
+                sleep_cv_.wait(lock);
+            }
+            sleeping_.fetch_sub(1, std::memory_order_relaxed);
+            if (stop_ && queued_.load(std::memory_order_seq_cst) == 0) {
+                return;
+            }
+        }
+    }
+};
+
+template <typename R>
+void future<R>::wait() const {
+    int idle = 0;
+    while (!state_->ready.load(std::memory_order_acquire)) {
+        if (pool_->help_one()) {
+            idle = 0;
+        } else if (++idle < 64 ||
+                   pool_detail::this_worker().pool == pool_) {
+            // 工作线程不能阻塞，否则它队列中的任务可能无人执行
+            std::this_thread::yield();
+        } else {
+            state_->ready.wait(false, std::memory_order_acquire);
+        }
+    }
+}
+
+template <typename F>
+void task_group::spawn(F&& f) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    try {
+        pool_.schedule(pool_detail::make_task(
+            [this, fn = std::decay_t<F>(mystl::forward<F>(f))]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!error_) {
+                        error_ = std::current_exception();
+                    }
+                }
+                // 计数归零后 sync 可能立即返回并析构 task_group，之后只能访问线程池
+                thread_pool* pool = &pool_;
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    pool->notify_group_done();
+                }
+            }));
+    } catch (...) {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+inline void task_group::sync() {
+    int idle = 0;
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (pool_.help_one()) {
+            idle = 0;
+        } else if (++idle < 64 ||
+                   pool_detail::this_worker().pool == &pool_) {
+            std::this_thread::yield();
+        } else {
+            const uint32_t epoch =
+                pool_.group_epoch_.load(std::memory_order_acquire);
+            if (pending_.load(std::memory_order_acquire) != 0) {
+                pool_.group_epoch_.wait(epoch, std::memory_order_acquire);
+            }
+        }
+    }
+    if (error_) {
+        std::exception_ptr e = mystl::move(error_);
+        error_ = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+}  // namespace mystl
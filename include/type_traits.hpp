@@ -26,4 +26,38 @@ struct is_pair : mystl::m_false_type {};
 template <typename T1, typename T2>
 struct is_pair<mystl::pair<T1, T2>> : mystl::m_true_type {};
 
+// 可平凡重定位：对象可以直接 memcpy 到新地址，并且旧地址上的对象不需要析构
+// trivially copyable 的类型天然满足，其余类型可由用户特化为 m_true_type 开启
+template <typename T>
+struct is_trivially_relocatable
+    : mystl::m_bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T1, typename T2>
+struct is_trivially_relocatable<mystl::pair<T1, T2>>
+    : mystl::m_bool_constant<is_trivially_relocatable<T1>::value &&
+                             is_trivially_relocatable<T2>::value> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// 可逐字节比较相等：两个值相等当且仅当对象表示逐字节相等，可以交给 memcmp
+// 浮点数 (+0.0 与 -0.0、NaN) 和可能含有填充字节的类类型不满足
+template <typename T>
+struct is_bitwise_comparable
+    : mystl::m_bool_constant<std::is_integral_v<T> || std::is_enum_v<T> ||
+                             std::is_pointer_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v = is_bitwise_comparable<T>::value;
+
+// 可逐字节比较大小：单字节的无符号整数，大小关系与 memcmp 的结果一致
+template <typename T>
+struct is_bitwise_orderable
+    : mystl::m_bool_constant<std::is_integral_v<T> && std::is_unsigned_v<T> &&
+                             sizeof(T) == 1> {};
+
+template <typename T>
+inline constexpr bool is_bitwise_orderable_v = is_bitwise_orderable<T>::value;
+
 }  // namespace mystl
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+
+// 这个头文件用于对未初始化的空间构造元素
+// uninitialized_copy / uninitialized_copy_n : 复制一段区间
+// uninitialized_move                        : 移动一段区间
+// uninitialized_fill / uninitialized_fill_n : 以同一个值填充
+// uninitialized_default_construct           : 默认初始化
+// uninitialized_value_construct             : 值初始化
+// 对于连续迭代器上的 trivially copyable 类型，退化为一次 memmove / memset；
+// 其余情况逐个构造，构造过程抛出异常时析构已构造的元素后重新抛出
+// 常量求值中不使用 memmove / memset，总是逐个构造
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 判断从 InputIter 到 ForwardIter 的复制能否直接使用 memmove：
+// 两者都是连续迭代器，元素是同一种 trivially copyable 类型
+template <typename InputIter, typename ForwardIter,
+          bool = is_contiguous_iterator<InputIter>::value &&
+                 is_contiguous_iterator<ForwardIter>::value>
+struct is_memmove_copyable : public m_false_type {};
+
+template <typename InputIter, typename ForwardIter>
+struct is_memmove_copyable<InputIter, ForwardIter, true>
+    : public m_bool_constant<
+          std::is_same_v<typename iterator_traits<InputIter>::value_type,
+                         typename iterator_traits<ForwardIter>::value_type> &&
+          std::is_trivially_copyable_v<
+              typename iterator_traits<InputIter>::value_type>> {};
+
+template <typename InputIter, typename ForwardIter>
+inline constexpr bool is_memmove_copyable_v =
+    is_memmove_copyable<InputIter, ForwardIter>::value;
+
+/*****************************************************************************************/
+// uninitialized_copy
+// 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
+/*****************************************************************************************/
+
+template <typename InputIter, typename ForwardIter>
+constexpr ForwardIter uninitialized_copy(InputIter first, InputIter last,
+                                         ForwardIter result) {
+    if constexpr (is_memmove_copyable_v<InputIter, ForwardIter>) {
+        if (!std::is_constant_evaluated()) {
+            const auto n = static_cast<size_t>(last - first);
+            if (n != 0) {
+                std::memmove(mystl::to_address(result),
+                             mystl::to_address(first), n * sizeof(*first));
+            }
+            return result + n;
+        }
+    }
+    auto cur = result;
+    try {
+        for (; first != last; ++first, (void)++cur) {
+            mystl::construct(&*cur, *first);
+        }
+    } catch (...) {
+        mystl::destory(result, cur);
+        throw;
+    }
+    return cur;
+}
+
+/*****************************************************************************************/
+// uninitialized_copy_n
+// 把 [first, first + n) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
+/*****************************************************************************************/
+
+template <typename InputIter, typename Size, typename ForwardIter>
+constexpr ForwardIter uninitialized_copy_n(InputIter first, Size n,
+                                           ForwardIter result) {
+    if constexpr (is_memmove_copyable_v<InputIter, ForwardIter>) {
+        return mystl::uninitialized_copy(first, first + n, result);
+    } else {
+        auto cur = result;
+        try {
+            for (; n > 0; --n, ++first, (void)++cur) {
+                mystl::construct(&*cur, *first);
+            }
+        } catch (...) {
+            mystl::destory(result, cur);
+            throw;
+        }
+        return cur;
+    }
+}
+
+/*****************************************************************************************/
+// uninitialized_move
+// 把 [first, last) 上的内容移动到以 result 为起始处的空间，返回移动结束的位置
+/*****************************************************************************************/
+
+template <typename InputIter, typename ForwardIter>
+constexpr ForwardIter uninitialized_move(InputIter first, InputIter last,
+                                         ForwardIter result) {
+    if constexpr (is_memmove_copyable_v<InputIter, ForwardIter>) {
+        return mystl::uninitialized_copy(first, last, result);
+    } else {
+        auto cur = result;
+        try {
+            for (; first != last; ++first, (void)++cur) {
+                mystl::construct(&*cur, mystl::move(*first));
+            }
+        } catch (...) {
+            mystl::destory(result, cur);
+            throw;
+        }
+        return cur;
+    }
+}
+
+/*****************************************************************************************/
+// uninitialized_fill_n
+// 从 first 位置开始，填充 n 个元素值，返回填充结束的位置
+/*****************************************************************************************/
+
+template <typename ForwardIter, typename Size, typename T>
+constexpr ForwardIter uninitialized_fill_n(ForwardIter first, Size n,
+                                           const T& value) {
+    using value_type = typename iterator_traits<ForwardIter>::value_type;
+    if constexpr (is_contiguous_iterator_v<ForwardIter> &&
+                  std::is_trivially_copyable_v<value_type>) {
+        // 先转换成元素类型，填充的字节才是合法的对象表示
+        const value_type tmp(value);
+        if (std::is_constant_evaluated()) {
+            for (; n > 0; --n, ++first) {
+                mystl::construct(&*first, tmp);
+            }
+            return first;
+        }
+        if (n <= 0) {
+            return first;
+        }
+        value_type* p = mystl::to_address(first);
+        if constexpr (sizeof(value_type) == 1 &&
+                      (std::is_integral_v<value_type> ||
+                       std::is_same_v<value_type, std::byte>)) {
+            unsigned char byte;
+            std::memcpy(&byte, &tmp, 1);
+            std::memset(p, byte, n);
+        } else {
+            // 在未初始化的空间上逐个构造而不是赋值，赋值运算符可能被删除；
+            // 平凡的复制构造同样会被编译器向量化
+            for (Size i = 0; i < n; ++i) {
+                mystl::construct(p + i, tmp);
+            }
+        }
+        return first + n;
+    } else {
+        auto cur = first;
+        try {
+            for (; n > 0; --n, ++cur) {
+                mystl::construct(&*cur, value);
+            }
+        } catch (...) {
+            mystl::destory(first, cur);
+            throw;
+        }
+        return cur;
+    }
+}
+
+/*****************************************************************************************/
+// uninitialized_fill
+// 在 [first, last) 区间内填充元素值
+/*****************************************************************************************/
+
+template <typename ForwardIter, typename T>
+constexpr void uninitialized_fill(ForwardIter first, ForwardIter last,
+                                  const T& value) {
+    if constexpr (is_contiguous_iterator_v<ForwardIter>) {
+        mystl::uninitialized_fill_n(first, last - first, value);
+    } else {
+        auto cur = first;
+        try {
+            for (; cur != last; ++cur) {
+                mystl::construct(&*cur, value);
+            }
+        } catch (...) {
+            mystl::destory(first, cur);
+            throw;
+        }
+    }
+}
+
+/*****************************************************************************************/
+// uninitialized_value_construct
+// 在 [first, last) 区间内值初始化元素，算术类型和指针退化为一次 memset
+/*****************************************************************************************/
+
+template <typename ForwardIter>
+constexpr void uninitialized_value_construct(ForwardIter first,
+                                             ForwardIter last) {
+    using value_type = typename iterator_traits<ForwardIter>::value_type;
+    if constexpr (is_contiguous_iterator_v<ForwardIter> &&
+                  (std::is_arithmetic_v<value_type> ||
+                   std::is_pointer_v<value_type>)) {
+        if (!std::is_constant_evaluated()) {
+            if (first != last) {
+                std::memset(mystl::to_address(first), 0,
+                            (last - first) * sizeof(value_type));
+            }
+            return;
+        }
+    }
+    auto cur = first;
+    try {
+        for (; cur != last; ++cur) {
+            mystl::construct(&*cur);
+        }
+    } catch (...) {
+        mystl::destory(first, cur);
+        throw;
+    }
+}
+
+/*****************************************************************************************/
+// uninitialized_default_construct
+// 在 [first, last) 区间内默认初始化元素，平凡类型什么也不做
+/*****************************************************************************************/
+
+// 常量求值中不允许读取未初始化的值，改为值初始化
+template <typename ForwardIter>
+constexpr void uninitialized_default_construct(ForwardIter first,
+                                               ForwardIter last) {
+    using value_type = typename iterator_traits<ForwardIter>::value_type;
+    if (std::is_constant_evaluated()) {
+        mystl::uninitialized_value_construct(first, last);
+        return;
+    }
+    if constexpr (!std::is_trivially_default_constructible_v<value_type>) {
+        auto cur = first;
+        try {
+            for (; cur != last; ++cur) {
+                ::new (static_cast<void*>(&*cur)) value_type;
+            }
+        } catch (...) {
+            mystl::destory(first, cur);
+            throw;
+        }
+    }
+}
+
+}  // namespace mystl
@@ -5,8 +5,10 @@
 
 #include <compare>
 #include <cstddef>
+#include <cstring>
 #include <type_traits>
 
+#include "iterator.hpp"
 #include "type_traits.hpp"
 
 namespace mystl {
@@ -14,19 +16,19 @@ namespace mystl {
 // move
 
 template <typename T>
-std::remove_reference_t<T>&& move(T&& arg) noexcept {
+constexpr std::remove_reference_t<T>&& move(T&& arg) noexcept {
     return static_cast<std::remove_reference_t<T>&&>(arg);
 }
 
 // forward
 
 template <typename T>
-T&& forward(std::remove_reference_t<T>& arg) noexcept {
+constexpr T&& forward(std::remove_reference_t<T>& arg) noexcept {
     return static_cast<T&&>(arg);
 }
 
 template <typename T>
-T&& forward(std::remove_reference_t<T>&& arg) noexcept {
+constexpr T&& forward(std::remove_reference_t<T>&& arg) noexcept {
     static_assert(!std::is_lvalue_reference_v<T>, "bad forward");
     return static_cast<T&&>(arg);
 }
@@ -34,15 +36,53 @@ T&& forward(std::remove_reference_t<T>&& arg) noexcept {
 // swap
 
 template <typename Tp>
-void swap(Tp& lhs, Tp& rhs) {
+constexpr void swap(Tp& lhs, Tp& rhs) {
     auto tmp{mystl::move(lhs)};
     lhs = mystl::move(rhs);
     rhs = mystl::move(tmp);
 }
 
+namespace util_detail {
+
+// 两段不重叠的内存按块交换，每块经过栈上的缓冲区复制三次
+inline void swap_bytes(unsigned char* a, unsigned char* b, size_t n) {
+    constexpr size_t kBlock = 64;
+    unsigned char tmp[kBlock];
+    for (; n >= kBlock; n -= kBlock, a += kBlock, b += kBlock) {
+        std::memcpy(tmp, a, kBlock);
+        std::memcpy(a, b, kBlock);
+        std::memcpy(b, tmp, kBlock);
+    }
+    std::memcpy(tmp, a, n);
+    std::memcpy(a, b, n);
+    std::memcpy(b, tmp, n);
+}
+
+}  // namespace util_detail
+
+// 交换 [first1, last1) 与以 first2 开始的区间，两段区间不能重叠
+// 两侧都是连续迭代器、元素可平凡复制且移动构造与赋值都是平凡的时按字节块交换，
+// 否则逐个调用 swap，不会绕过被删除或者自定义的赋值运算符
 template <typename ForwardIter1, typename ForwardIter2>
-ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter2 last1,
-                        ForwardIter2 first2) {
+constexpr ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1,
+                                  ForwardIter2 first2) {
+    using T1 = typename iterator_traits<ForwardIter1>::value_type;
+    using T2 = typename iterator_traits<ForwardIter2>::value_type;
+    if constexpr (is_contiguous_iterator_v<ForwardIter1> &&
+                  is_contiguous_iterator_v<ForwardIter2> &&
+                  std::is_same_v<T1, T2> && std::is_trivially_copyable_v<T1> &&
+                  std::is_trivially_move_constructible_v<T1> &&
+                  std::is_trivially_move_assignable_v<T1> &&
+                  std::is_trivially_copy_assignable_v<T1>) {
+        if (!std::is_constant_evaluated()) {
+            const auto n = last1 - first1;
+            util_detail::swap_bytes(
+                reinterpret_cast<unsigned char*>(mystl::to_address(first1)),
+                reinterpret_cast<unsigned char*>(mystl::to_address(first2)),
+                static_cast<size_t>(n) * sizeof(T1));
+            return first2 + n;
+        }
+    }
     for (; first1 != last1; ++first1, (void)++first2) {
         mystl::swap(*first1, *first2);
     }
@@ -50,7 +90,7 @@ ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter2 last1,
 }
 
 template <typename Tp, size_t N>
-void swap(Tp (&a)[N], Tp (&b)[N]) {
+constexpr void swap(Tp (&a)[N], Tp (&b)[N]) {
     mystl::swap_range(a, a + N, b);
 }
 
@@ -134,8 +174,8 @@ struct pair {
         std::is_constructible_v<Ty2, Other2> &&
         std::is_convertible_v<Other1, Ty1> && std::is_convertible_v<Other2, Ty2>
     constexpr pair(pair<Other1, Other2>&& other)
-        : first(mystl::forward(other.first)),
-          second(mystl::forward(other.second)) {}
+        : first(mystl::forward<Other1>(other.first)),
+          second(mystl::forward<Other2>(other.second)) {}
 
     // explicit constructiable for other pair
     template <typename Other1, typename Other2>
@@ -144,11 +184,11 @@ struct pair {
         (!std::is_convertible_v<Other1, Ty1> ||
          !std::is_convertible_v<
              Other2, Ty2>)explicit constexpr pair(pair<Other1, Other2>&& other)
-        : first(mystl::forward(other.first)),
-          second(mystl::forward(other.second)) {}
+        : first(mystl::forward<Other1>(other.first)),
+          second(mystl::forward<Other2>(other.second)) {}
 
     // copy assign for this pair
-    pair& operator=(const pair& rhs) {
+    constexpr pair& operator=(const pair& rhs) {
         if (this != &rhs) {
             first = rhs.first;
             second = rhs.second;
@@ -157,7 +197,7 @@ struct pair {
     }
 
     // move assign for this pair
-    pair& operator=(pair&& rhs) {
+    constexpr pair& operator=(pair&& rhs) {
         if (this != &rhs) {
             first = mystl::move(rhs.first);
             second = mystl::move(rhs.second);
@@ -167,7 +207,7 @@ struct pair {
 
     // copy assign for other pair
     template <class Other1, class Other2>
-    pair& operator=(const pair<Other1, Other2>& other) {
+    constexpr pair& operator=(const pair<Other1, Other2>& other) {
         first = other.first;
         second = other.second;
         return *this;
@@ -175,7 +215,7 @@ struct pair {
 
     // move assign for other pair
     template <class Other1, class Other2>
-    pair& operator=(pair<Other1, Other2>&& other) {
+    constexpr pair& operator=(pair<Other1, Other2>&& other) {
         first = mystl::forward<Other1>(other.first);
         second = mystl::forward<Other2>(other.second);
         return *this;
@@ -183,7 +223,7 @@ struct pair {
 
     ~pair() = default;
 
-    void swap(pair& other) {
+    constexpr void swap(pair& other) {
         if (this != &other) {
             mystl::swap(first, other.first);
             mystl::swap(second, other.second);
@@ -193,43 +233,49 @@ struct pair {
 
 // 重载比较操作符
 template <class Ty1, class Ty2>
-bool operator==(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) {
+constexpr bool operator==(const pair<Ty1, Ty2>& lhs,
+                          const pair<Ty1, Ty2>& rhs) {
     return lhs.first == rhs.first && lhs.second == rhs.second;
 }
 
 template <class Ty1, class Ty2>
-bool operator<(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) {
+constexpr bool operator<(const pair<Ty1, Ty2>& lhs,
+                         const pair<Ty1, Ty2>& rhs) {
     return lhs.first < rhs.first ||
            (lhs.first == rhs.first && lhs.second < rhs.second);
 }
 
 template <class Ty1, class Ty2>
-bool operator!=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) {
+constexpr bool operator!=(const pair<Ty1, Ty2>& lhs,
+                          const pair<Ty1, Ty2>& rhs) {
     return !(lhs == rhs);
 }
 
 template <class Ty1, class Ty2>
-bool operator>(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) {
+constexpr bool operator>(const pair<Ty1, Ty2>& lhs,
+                         const pair<Ty1, Ty2>& rhs) {
     return rhs < lhs;
 }
 
 template <class Ty1, class Ty2>
-bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) {
+constexpr bool operator<=(const pair<Ty1, Ty2>& lhs,
+                          const pair<Ty1, Ty2>& rhs) {
     return !(rhs < lhs);
 }
 
 template <class Ty1, class Ty2>
-bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) {
+constexpr bool operator>=(const pair<Ty1, Ty2>& lhs,
+                          const pair<Ty1, Ty2>& rhs) {
     return !(lhs < rhs);
 }
 
 template <typename Ty1, typename Ty2>
-void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs) {
+constexpr void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs) {
     lhs.swap(rhs);
 }
 
 template <class Ty1, class Ty2>
-pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second) {
+constexpr pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second) {
     return pair<Ty1, Ty2>(mystl::forward<Ty1>(first),
                           mystl::forward<Ty2>(second));
 }
@@ -0,0 +1,723 @@
+#pragma once
+
+// 这个头文件包含模板类 vector 以及它的小缓冲区版本 small_vector
+// vector       : 连续存储的动态数组，迭代器为原生指针
+// small_vector : 前 N 个元素存放在对象内部的缓冲区中，超出后才向 allocator
+//                申请内存，元素较少时完全不分配堆内存
+// 两者共用 basic_vector 的实现，扩容时使用 relocate 搬运元素，
+// 可平凡重定位的类型只需要一次 memcpy
+// vector 可以在常量求值中使用 (内存必须在求值结束前释放)，用于在编译期
+// 生成查找表后复制到 array 中
+
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "uninitialized.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 对象内部的缓冲区，N 为 0 时不占空间
+template <typename T, size_t N>
+struct inline_buffer {
+    alignas(T) unsigned char data[N * sizeof(T)];
+
+    constexpr T* get() { return reinterpret_cast<T*>(data); }
+    constexpr const T* get() const { return reinterpret_cast<const T*>(data); }
+};
+
+template <typename T>
+struct inline_buffer<T, 0> {
+    constexpr T* get() { return nullptr; }
+    constexpr const T* get() const { return nullptr; }
+};
+
+// 模板类：basic_vector
+// 模板参数 T 代表元素类型，Alloc 代表空间配置器，N 代表内部缓冲区能容纳的元素个数
+template <typename T, typename Alloc, size_t N>
+class basic_vector {
+public:
+    using allocator_type = Alloc;
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity = N;
+
+private:
+    pointer begin_;  // 表示目前使用空间的头部
+    pointer end_;    // 表示目前使用空间的尾部
+    pointer cap_;    // 表示目前储存空间的尾部
+    [[no_unique_address]] Alloc alloc_;
+    [[no_unique_address]] inline_buffer<T, N> buffer_;
+
+    // 搬运元素时能否保证不抛出异常
+    static constexpr bool kNothrowRelocate =
+        is_trivially_relocatable_v<T> ||
+        std::is_nothrow_move_constructible_v<T> ||
+        !std::is_copy_constructible_v<T>;
+
+public:
+    // 构造、复制、移动、析构函数
+    constexpr basic_vector() : alloc_() { init_empty(); }
+
+    constexpr explicit basic_vector(const Alloc& alloc) : alloc_(alloc) {
+        init_empty();
+    }
+
+    constexpr explicit basic_vector(size_type n, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_empty();
+        reserve(n);
+        mystl::uninitialized_value_construct(begin_, begin_ + n);
+        end_ = begin_ + n;
+    }
+
+    constexpr basic_vector(size_type n, const value_type& value,
+                           const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_empty();
+        reserve(n);
+        end_ = mystl::uninitialized_fill_n(begin_, n, value);
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    constexpr basic_vector(Iter first, Iter last, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_empty();
+        assign(first, last);
+    }
+
+    constexpr basic_vector(std::initializer_list<value_type> ilist,
+                           const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        init_empty();
+        assign(ilist.begin(), ilist.end());
+    }
+
+    constexpr basic_vector(const basic_vector& rhs) : alloc_(rhs.alloc_) {
+        init_empty();
+        assign(rhs.begin_, rhs.end_);
+    }
+
+    constexpr basic_vector(basic_vector&& rhs) noexcept(kNothrowRelocate)
+        : alloc_(mystl::move(rhs.alloc_)) {
+        init_empty();
+        take(rhs);
+    }
+
+    constexpr basic_vector& operator=(const basic_vector& rhs) {
+        if (this != &rhs) {
+            assign(rhs.begin_, rhs.end_);
+        }
+        return *this;
+    }
+
+    constexpr basic_vector& operator=(basic_vector&& rhs) {
+        if (this != &rhs) {
+            clear();
+            if (!rhs.is_inline() && alloc_ == rhs.alloc_) {
+                deallocate_storage();
+                init_empty();
+            }
+            take(rhs);
+        }
+        return *this;
+    }
+
+    constexpr basic_vector& operator=(
+        std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    constexpr ~basic_vector() {
+        mystl::destory(begin_, end_);
+        deallocate_storage();
+    }
+
+public:
+    // 迭代器相关操作
+    constexpr iterator begin() noexcept { return begin_; }
+    constexpr const_iterator begin() const noexcept { return begin_; }
+    constexpr iterator end() noexcept { return end_; }
+    constexpr const_iterator end() const noexcept { return end_; }
+
+    constexpr reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    constexpr reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+    constexpr const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    constexpr bool empty() const noexcept { return begin_ == end_; }
+    constexpr size_type size() const noexcept {
+        return static_cast<size_type>(end_ - begin_);
+    }
+    constexpr size_type max_size() const noexcept {
+        return static_cast<size_type>(-1) / sizeof(T);
+    }
+    constexpr size_type capacity() const noexcept {
+        return static_cast<size_type>(cap_ - begin_);
+    }
+
+    constexpr void reserve(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("n can not larger than max_size() in "
+                                    "vector<T>::reserve(n)");
+        }
+        if (n > capacity()) {
+            reallocate(n);
+        }
+    }
+
+    // 放弃多余的容量，small_vector 的元素能放进内部缓冲区时搬回缓冲区
+    constexpr void shrink_to_fit() {
+        if (is_inline() || end_ == cap_) {
+            return;
+        }
+        reallocate(size());
+    }
+
+    // 访问元素相关操作
+    constexpr reference operator[](size_type n) { return begin_[n]; }
+    constexpr const_reference operator[](size_type n) const {
+        return begin_[n];
+    }
+
+    constexpr reference at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("vector<T>::at() subscript out of range");
+        }
+        return begin_[n];
+    }
+    constexpr const_reference at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("vector<T>::at() subscript out of range");
+        }
+        return begin_[n];
+    }
+
+    constexpr reference front() { return *begin_; }
+    constexpr const_reference front() const { return *begin_; }
+    constexpr reference back() { return *(end_ - 1); }
+    constexpr const_reference back() const { return *(end_ - 1); }
+
+    constexpr pointer data() noexcept { return begin_; }
+    constexpr const_pointer data() const noexcept { return begin_; }
+
+    constexpr allocator_type get_allocator() const { return alloc_; }
+
+    // 修改容器相关操作
+
+    // assign
+    constexpr void assign(size_type n, const value_type& value) {
+        value_type tmp(value);
+        clear();
+        reserve(n);
+        end_ = mystl::uninitialized_fill_n(begin_, n, tmp);
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    constexpr void assign(Iter first, Iter last) {
+        clear();
+        if constexpr (is_forward_iterator<Iter>::value) {
+            reserve(static_cast<size_type>(mystl::distance(first, last)));
+            end_ = mystl::uninitialized_copy(first, last, begin_);
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    constexpr void assign(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    // emplace / emplace_back
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args) {
+        iterator p = begin_ + (pos - begin_);
+        if (end_ == cap_) {
+            return reallocate_insert(p, 1, [&](pointer dest) {
+                alloc_.construct(dest, mystl::forward<Args>(args)...);
+            });
+        }
+        if (p == end_) {
+            alloc_.construct(end_, mystl::forward<Args>(args)...);
+            ++end_;
+            return p;
+        }
+        // 参数可能引用容器内的元素，先构造出临时对象再腾出位置
+        value_type tmp(mystl::forward<Args>(args)...);
+        return insert_in_place(p, 1, [&](pointer dest) {
+            alloc_.construct(dest, mystl::move(tmp));
+        });
+    }
+
+    template <typename... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        if (end_ != cap_) {
+            alloc_.construct(end_, mystl::forward<Args>(args)...);
+            ++end_;
+        } else {
+            reallocate_insert(end_, 1, [&](pointer dest) {
+                alloc_.construct(dest, mystl::forward<Args>(args)...);
+            });
+        }
+        return back();
+    }
+
+    // push_back / pop_back
+    constexpr void push_back(const value_type& value) { emplace_back(value); }
+    constexpr void push_back(value_type&& value) {
+        emplace_back(mystl::move(value));
+    }
+
+    constexpr void pop_back() {
+        --end_;
+        alloc_.destory(end_);
+    }
+
+    // insert
+    constexpr iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+    constexpr iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    constexpr iterator insert(const_iterator pos, size_type n,
+                              const value_type& value) {
+        value_type tmp(value);
+        return insert_n(begin_ + (pos - begin_), n, [&](pointer dest) {
+            mystl::uninitialized_fill_n(dest, n, tmp);
+        });
+    }
+
+    template <typename Iter>
+    requires is_input_iterator<Iter>::value
+    constexpr iterator insert(const_iterator pos, Iter first, Iter last) {
+        const difference_type offset = pos - begin_;
+        if constexpr (is_forward_iterator<Iter>::value) {
+            const auto n = static_cast<size_type>(mystl::distance(first, last));
+            return insert_n(begin_ + offset, n, [&](pointer dest) {
+                mystl::uninitialized_copy(first, last, dest);
+            });
+        } else {
+            for (difference_type i = offset; first != last; ++first, ++i) {
+                emplace(begin_ + i, *first);
+            }
+            return begin_ + offset;
+        }
+    }
+
+    constexpr iterator insert(const_iterator pos,
+                              std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    // erase / clear
+    constexpr iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    constexpr iterator erase(const_iterator first, const_iterator last) {
+        iterator f = begin_ + (first - begin_);
+        iterator l = begin_ + (last - begin_);
+        if (f == l) {
+            return f;
+        }
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                mystl::destory(f, l);
+                std::memmove(static_cast<void*>(f),
+                             static_cast<const void*>(l),
+                             (end_ - l) * sizeof(T));
+                end_ -= l - f;
+                return f;
+            }
+        }
+        iterator new_end = f;
+        for (iterator cur = l; cur != end_; ++cur, ++new_end) {
+            *new_end = mystl::move(*cur);
+        }
+        mystl::destory(new_end, end_);
+        end_ = new_end;
+        return f;
+    }
+
+    constexpr void clear() noexcept {
+        mystl::destory(begin_, end_);
+        end_ = begin_;
+    }
+
+    // resize
+    constexpr void resize(size_type new_size) {
+        if (new_size < size()) {
+            erase(begin_ + new_size, end_);
+            return;
+        }
+        if (new_size > capacity()) {
+            reallocate(next_capacity(new_size - size()));
+        }
+        mystl::uninitialized_value_construct(end_, begin_ + new_size);
+        end_ = begin_ + new_size;
+    }
+
+    constexpr void resize(size_type new_size, const value_type& value) {
+        if (new_size < size()) {
+            erase(begin_ + new_size, end_);
+            return;
+        }
+        insert(end_, new_size - size(), value);
+    }
+
+    // swap
+    constexpr void swap(basic_vector& rhs) {
+        if (this == &rhs) {
+            return;
+        }
+        if (is_inline() || rhs.is_inline()) {
+            basic_vector tmp(mystl::move(*this));
+            *this = mystl::move(rhs);
+            rhs = mystl::move(tmp);
+            return;
+        }
+        mystl::swap(begin_, rhs.begin_);
+        mystl::swap(end_, rhs.end_);
+        mystl::swap(cap_, rhs.cap_);
+        mystl::swap(alloc_, rhs.alloc_);
+    }
+
+private:
+    constexpr void init_empty() {
+        begin_ = end_ = buffer_.get();
+        cap_ = begin_ + N;
+    }
+
+    constexpr bool is_inline() const {
+        if constexpr (N == 0) {
+            return false;
+        } else {
+            return begin_ == buffer_.get();
+        }
+    }
+
+    constexpr void deallocate_storage() {
+        if (!is_inline() && begin_ != nullptr) {
+            alloc_.deallocate(begin_, capacity());
+        }
+    }
+
+    // 扩容策略：至少容纳新增的 add 个元素，否则按两倍增长
+    constexpr size_type next_capacity(size_type add) const {
+        const size_type old_size = size();
+        if (add > max_size() - old_size) {
+            throw std::length_error("vector<T>'s size too big");
+        }
+        const size_type old_cap = capacity();
+        const size_type grown =
+            old_cap > max_size() / 2 ? max_size() : old_cap * 2;
+        return grown > old_size + add ? grown : old_size + add;
+    }
+
+    // 把 [first, last) 搬到 dest，可能抛出异常时退化为复制，保证强异常安全
+    static constexpr pointer relocate_elements(pointer first, pointer last,
+                                               pointer dest) {
+        if constexpr (kNothrowRelocate) {
+            return mystl::relocate(first, last, dest);
+        } else {
+            pointer result = mystl::uninitialized_copy(first, last, dest);
+            mystl::destory(first, last);
+            return result;
+        }
+    }
+
+    // 把存储空间换成能容纳 new_cap 个元素的空间
+    // small_vector 的 new_cap 不超过 N 时换回内部缓冲区
+    constexpr void reallocate(size_type new_cap) {
+        pointer new_begin = nullptr;
+        if (N != 0 && new_cap <= N) {
+            new_begin = buffer_.get();
+            new_cap = N;
+        } else if (new_cap != 0) {
+            new_begin = alloc_.allocate(new_cap);
+        }
+        pointer new_end = new_begin;
+        try {
+            new_end = relocate_elements(begin_, end_, new_begin);
+        } catch (...) {
+            if (new_begin != buffer_.get()) {
+                alloc_.deallocate(new_begin, new_cap);
+            }
+            throw;
+        }
+        deallocate_storage();
+        begin_ = new_begin;
+        end_ = new_end;
+        cap_ = new_begin + new_cap;
+    }
+
+    // 空间不足时插入 n 个元素：先在新空间构造新元素，再搬运原有元素
+    // construct_new 负责在给定位置构造 n 个元素，失败时自行析构已构造的部分
+    template <typename Fn>
+    constexpr iterator reallocate_insert(iterator pos, size_type n,
+                                         Fn&& construct_new) {
+        const size_type new_cap = next_capacity(n);
+        const size_type new_size = size() + n;
+        pointer new_begin = alloc_.allocate(new_cap);
+        pointer new_pos = new_begin + (pos - begin_);
+        try {
+            construct_new(new_pos);
+        } catch (...) {
+            alloc_.deallocate(new_begin, new_cap);
+            throw;
+        }
+
+        if constexpr (kNothrowRelocate) {
+            // 不可复制且移动可能抛出异常的类型也走这里
+            // relocate 失败时析构它已构造的目标对象，源对象保持存活
+            pointer moved = new_begin;
+            try {
+                mystl::relocate(begin_, pos, new_begin);
+                moved = new_pos;
+                mystl::relocate(pos, end_, new_pos + n);
+            } catch (...) {
+                mystl::destory(new_begin, moved);
+                mystl::destory(new_pos, new_pos + n);
+                alloc_.deallocate(new_begin, new_cap);
+                if (moved != new_begin) {
+                    // pos 之前的元素已经搬走并析构，只能放弃剩余元素
+                    mystl::destory(pos, end_);
+                    end_ = begin_;
+                }
+                throw;
+            }
+        } else {
+            pointer cur = new_begin;
+            try {
+                cur = mystl::uninitialized_copy(begin_, pos, new_begin);
+                mystl::uninitialized_copy(pos, end_, new_pos + n);
+            } catch (...) {
+                mystl::destory(new_begin, cur);
+                mystl::destory(new_pos, new_pos + n);
+                alloc_.deallocate(new_begin, new_cap);
+                throw;
+            }
+            mystl::destory(begin_, end_);
+        }
+
+        deallocate_storage();
+        begin_ = new_begin;
+        end_ = new_begin + new_size;
+        cap_ = new_begin + new_cap;
+        return new_pos;
+    }
+
+    // 在 pos 处插入 n 个元素，根据剩余容量选择原地插入或重新分配
+    template <typename Fn>
+    constexpr iterator insert_n(iterator pos, size_type n, Fn&& construct_new) {
+        if (n == 0) {
+            return pos;
+        }
+        if (static_cast<size_type>(cap_ - end_) < n) {
+            return reallocate_insert(pos, n, construct_new);
+        }
+        return insert_in_place(pos, n, construct_new);
+    }
+
+    // 剩余容量足够时在 pos 处插入 n 个元素
+    // 可平凡重定位的类型用 memmove 腾出位置，其余类型先构造在尾部再旋转到 pos
+    template <typename Fn>
+    constexpr iterator insert_in_place(iterator pos, size_type n,
+                                       Fn&& construct_new) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type tail = static_cast<size_type>(end_ - pos);
+                std::memmove(static_cast<void*>(pos + n),
+                             static_cast<const void*>(pos), tail * sizeof(T));
+                try {
+                    construct_new(pos);
+                } catch (...) {
+                    std::memmove(static_cast<void*>(pos),
+                                 static_cast<const void*>(pos + n),
+                                 tail * sizeof(T));
+                    throw;
+                }
+                end_ += n;
+                return pos;
+            }
+        }
+        pointer old_end = end_;
+        construct_new(end_);
+        end_ += n;
+        rotate(pos, old_end, end_);
+        return pos;
+    }
+
+    // 把 [middle, last) 旋转到 first 处，三次翻转实现
+    static constexpr void reverse(pointer first, pointer last) {
+        for (; first != last && first != --last; ++first) {
+            mystl::swap(*first, *last);
+        }
+    }
+
+    static constexpr void rotate(pointer first, pointer middle, pointer last) {
+        reverse(first, middle);
+        reverse(middle, last);
+        reverse(first, last);
+    }
+
+    // 从 rhs 接管元素，rhs 使用堆内存并且 allocator 相等时直接接管指针
+    // 调用前 *this 必须为空
+    constexpr void take(basic_vector& rhs) {
+        if (!rhs.is_inline() && alloc_ == rhs.alloc_) {
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            cap_ = rhs.cap_;
+            rhs.init_empty();
+            return;
+        }
+        reserve(rhs.size());
+        if constexpr (kNothrowRelocate) {
+            end_ = mystl::relocate(rhs.begin_, rhs.end_, begin_);
+            rhs.end_ = rhs.begin_;
+        } else {
+            end_ = mystl::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+            rhs.clear();
+        }
+    }
+};
+
+// 重载比较操作符
+template <typename T, typename Alloc, size_t N>
+constexpr bool operator==(const basic_vector<T, Alloc, N>& lhs,
+                          const basic_vector<T, Alloc, N>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    if constexpr (is_bitwise_comparable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            return lhs.empty() || std::memcmp(lhs.data(), rhs.data(),
+                                              lhs.size() * sizeof(T)) == 0;
+        }
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename Alloc, size_t N>
+constexpr bool operator<(const basic_vector<T, Alloc, N>& lhs,
+                         const basic_vector<T, Alloc, N>& rhs) {
+    const size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+    if constexpr (is_bitwise_orderable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            const int r = n == 0 ? 0 : std::memcmp(lhs.data(), rhs.data(), n);
+            return r != 0 ? r < 0 : lhs.size() < rhs.size();
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.size() < rhs.size();
+}
+
+template <typename T, typename Alloc, size_t N>
+constexpr bool operator!=(const basic_vector<T, Alloc, N>& lhs,
+                          const basic_vector<T, Alloc, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc, size_t N>
+constexpr bool operator>(const basic_vector<T, Alloc, N>& lhs,
+                         const basic_vector<T, Alloc, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename Alloc, size_t N>
+constexpr bool operator<=(const basic_vector<T, Alloc, N>& lhs,
+                          const basic_vector<T, Alloc, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Alloc, size_t N>
+constexpr bool operator>=(const basic_vector<T, Alloc, N>& lhs,
+                          const basic_vector<T, Alloc, N>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, typename Alloc, size_t N>
+constexpr void swap(basic_vector<T, Alloc, N>& lhs,
+                    basic_vector<T, Alloc, N>& rhs) {
+    lhs.swap(rhs);
+}
+
+// 模板类：vector
+template <typename T, typename Alloc = mystl::allocator<T>>
+class vector : public basic_vector<T, Alloc, 0> {
+    using base = basic_vector<T, Alloc, 0>;
+
+public:
+    using base::base;
+    using base::operator=;
+
+    constexpr vector() = default;
+};
+
+// 模板类：small_vector
+// 前 N 个元素存放在对象内部，size 不超过 N 时不分配堆内存
+template <typename T, size_t N, typename Alloc = mystl::allocator<T>>
+class small_vector : public basic_vector<T, Alloc, N> {
+    static_assert(N > 0, "small_vector needs a non-empty inline buffer");
+    using base = basic_vector<T, Alloc, N>;
+
+public:
+    using base::base;
+    using base::operator=;
+
+    constexpr small_vector() = default;
+};
+
+}  // namespace mystl
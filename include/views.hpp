@@ -0,0 +1,958 @@
+#pragma once
+
+// 这个头文件包含惰性求值的视图 (views)
+// 视图只保存底层区间与函数对象，既不复制元素也不分配内存；元素在迭代器解引用时
+// 才计算，多个视图串联后由编译器内联成一个循环
+// views::all       : 左值区间包装为引用，右值容器移入视图中保存
+// views::transform : 对每个元素调用函数对象
+// views::filter    : 只保留满足谓词的元素
+// views::take      : 前 n 个元素
+// views::drop      : 跳过前 n 个元素
+// views::zip       : 两个区间按位置组成 pair，长度取较短者
+// views::enumerate : 下标与元素组成 pair
+// views::chunk     : 每 n 个元素为一块，每块是底层迭代器的 subrange
+// 视图可以用 | 串联：v | views::filter(pred) | views::transform(fn)
+// 迭代器类别取底层迭代器与视图所能支持的类别中较弱的一个：
+// transform / zip / enumerate / chunk 最多随机访问，filter 最多双向；
+// take / drop 在随机访问时直接返回底层迭代器，连续区间仍然可以交给 SIMD 内核，
+// 随机访问的视图可以直接交给 execution.hpp 中的并行算法
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "iterator.hpp"
+#include "util.hpp"
+
+namespace mystl {
+
+// 区间：可以取得首尾迭代器的类型，包括内置数组
+template <typename R>
+concept Range = std::is_array_v<std::remove_reference_t<R>> ||
+                requires(std::remove_reference_t<R>& r) {
+                    r.begin();
+                    r.end();
+                };
+
+namespace views_detail {
+
+// 取区间的首尾迭代器，内置数组退化为指针
+template <typename R>
+constexpr auto begin(R& r) {
+    if constexpr (std::is_array_v<R>) {
+        return r + 0;
+    } else {
+        return r.begin();
+    }
+}
+
+template <typename R>
+constexpr auto end(R& r) {
+    if constexpr (std::is_array_v<R>) {
+        return r + std::extent_v<R>;
+    } else {
+        return r.end();
+    }
+}
+
+template <typename R>
+using iterator_t = decltype(views_detail::begin(std::declval<R&>()));
+
+// 两种迭代器类别中较弱的一个
+template <typename A, typename B>
+using weaker_t = std::conditional_t<std::is_convertible_v<A, B>, B, A>;
+
+// 底层迭代器的类别，不超过 Max
+template <typename Iter, typename Max>
+using category_t =
+    weaker_t<typename iterator_traits<Iter>::iterator_category, Max>;
+
+template <typename Iter>
+inline constexpr bool is_random_v = is_random_access_iterator<Iter>::value;
+
+// 迭代器外观：派生类提供 read / next / prev / advance / equal / distance_to，
+// 这里生成完整的运算符；只有用到的运算符才会实例化
+template <typename D, typename Reference>
+class iterator_facade {
+private:
+    constexpr D& self() { return static_cast<D&>(*this); }
+    constexpr const D& self() const { return static_cast<const D&>(*this); }
+
+    // 友元运算符不能访问派生类的私有成员，经由外观转发
+    static constexpr bool equal(const D& lhs, const D& rhs) {
+        return lhs.equal(rhs);
+    }
+    static constexpr ptrdiff_t distance(const D& from, const D& to) {
+        return from.distance_to(to);
+    }
+
+public:
+    constexpr Reference operator*() const { return self().read(); }
+
+    constexpr D& operator++() {
+        self().next();
+        return self();
+    }
+
+    constexpr D operator++(int) {
+        D tmp = self();
+        self().next();
+        return tmp;
+    }
+
+    constexpr D& operator--() {
+        self().prev();
+        return self();
+    }
+
+    constexpr D operator--(int) {
+        D tmp = self();
+        self().prev();
+        return tmp;
+    }
+
+    constexpr D& operator+=(ptrdiff_t n) {
+        self().advance(n);
+        return self();
+    }
+
+    constexpr D& operator-=(ptrdiff_t n) {
+        self().advance(-n);
+        return self();
+    }
+
+    constexpr Reference operator[](ptrdiff_t n) const {
+        return *(self() + n);
+    }
+
+    friend constexpr D operator+(D it, ptrdiff_t n) { return it += n; }
+    friend constexpr D operator+(ptrdiff_t n, D it) { return it += n; }
+    friend constexpr D operator-(D it, ptrdiff_t n) { return it -= n; }
+
+    friend constexpr ptrdiff_t operator-(const D& lhs, const D& rhs) {
+        return distance(rhs, lhs);
+    }
+
+    // != 由编译器改写为 !(lhs == rhs)
+    friend constexpr bool operator==(const D& lhs, const D& rhs) {
+        return equal(lhs, rhs);
+    }
+
+    friend constexpr bool operator<(const D& lhs, const D& rhs) {
+        return distance(lhs, rhs) > 0;
+    }
+
+    friend constexpr bool operator>(const D& lhs, const D& rhs) {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const D& lhs, const D& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const D& lhs, const D& rhs) {
+        return !(lhs < rhs);
+    }
+};
+
+template <typename Iter, typename F>
+using transform_reference_t =
+    std::invoke_result_t<const F&, typename iterator_traits<Iter>::reference>;
+
+}  // namespace views_detail
+
+/*****************************************************************************************/
+// 视图的公共部分
+/*****************************************************************************************/
+
+// 所有视图的基类，用于区分视图与容器
+struct view_base {};
+
+template <typename T>
+inline constexpr bool is_view_v =
+    std::is_base_of_v<view_base, std::remove_cvref_t<T>>;
+
+// 由派生类的 begin / end 生成 empty / size / front / operator[]
+template <typename D>
+class view_interface : public view_base {
+private:
+    constexpr const D& self() const { return static_cast<const D&>(*this); }
+
+public:
+    constexpr bool empty() const { return self().begin() == self().end(); }
+
+    // 要求随机访问迭代器
+    constexpr size_t size() const {
+        return static_cast<size_t>(self().end() - self().begin());
+    }
+
+    constexpr decltype(auto) front() const { return *self().begin(); }
+
+    constexpr decltype(auto) operator[](ptrdiff_t n) const {
+        return self().begin()[n];
+    }
+};
+
+// 模板类：subrange
+// 一对迭代器表示的区间
+template <typename Iter>
+class subrange : public view_interface<subrange<Iter>> {
+private:
+    Iter first_{};
+    Iter last_{};
+
+public:
+    constexpr subrange() = default;
+    constexpr subrange(Iter first, Iter last) : first_(first), last_(last) {}
+
+    constexpr Iter begin() const { return first_; }
+    constexpr Iter end() const { return last_; }
+};
+
+// 模板类：ref_view
+// 引用一个左值区间，复制视图时不复制区间
+template <typename R>
+class ref_view : public view_interface<ref_view<R>> {
+private:
+    R* r_;
+
+public:
+    constexpr explicit ref_view(R& r) : r_(&r) {}
+
+    constexpr auto begin() const { return views_detail::begin(*r_); }
+    constexpr auto end() const { return views_detail::end(*r_); }
+    constexpr R& base() const { return *r_; }
+};
+
+// 模板类：owning_view
+// 保存一个移入的右值容器，使 make_vector() | views::filter(pred) 不会悬空
+template <typename R>
+class owning_view : public view_interface<owning_view<R>> {
+private:
+    R r_;
+
+public:
+    constexpr explicit owning_view(R&& r) : r_(mystl::move(r)) {}
+
+    constexpr auto begin() { return views_detail::begin(r_); }
+    constexpr auto end() { return views_detail::end(r_); }
+    constexpr auto begin() const { return views_detail::begin(r_); }
+    constexpr auto end() const { return views_detail::end(r_); }
+};
+
+namespace views_detail {
+
+// 部分应用的适配器：保存除区间以外的参数，由 operator| 传入区间
+template <typename Fn>
+struct closure {
+    Fn fn;
+
+    template <Range R>
+    friend constexpr auto operator|(R&& r, const closure& c) {
+        return c.fn(mystl::forward<R>(r));
+    }
+};
+
+struct all_fn {
+    template <Range R>
+    constexpr auto operator()(R&& r) const {
+        if constexpr (is_view_v<R>) {
+            return std::remove_cvref_t<R>(mystl::forward<R>(r));
+        } else if constexpr (std::is_lvalue_reference_v<R>) {
+            return ref_view<std::remove_reference_t<R>>(r);
+        } else {
+            return owning_view<std::remove_cvref_t<R>>(mystl::move(r));
+        }
+    }
+
+    template <Range R>
+    friend constexpr auto operator|(R&& r, const all_fn& fn) {
+        return fn(mystl::forward<R>(r));
+    }
+};
+
+}  // namespace views_detail
+
+namespace views {
+
+inline constexpr views_detail::all_fn all{};
+
+template <typename R>
+using all_t = decltype(views::all(std::declval<R>()));
+
+}  // namespace views
+
+/*****************************************************************************************/
+// transform
+/*****************************************************************************************/
+
+template <typename Iter, typename F>
+class transform_iterator
+    : public views_detail::iterator_facade<
+          transform_iterator<Iter, F>,
+          views_detail::transform_reference_t<Iter, F>> {
+public:
+    using iterator_category =
+        views_detail::category_t<Iter, random_access_iterator_tag>;
+    using reference = views_detail::transform_reference_t<Iter, F>;
+    using value_type = std::remove_cvref_t<reference>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+
+private:
+    friend views_detail::iterator_facade<transform_iterator, reference>;
+
+    Iter cur_{};
+    const F* fn_ = nullptr;
+
+    constexpr reference read() const { return std::invoke(*fn_, *cur_); }
+    constexpr void next() { ++cur_; }
+    constexpr void prev() { --cur_; }
+    constexpr void advance(ptrdiff_t n) { cur_ += n; }
+    constexpr bool equal(const transform_iterator& rhs) const {
+        return cur_ == rhs.cur_;
+    }
+    constexpr ptrdiff_t distance_to(const transform_iterator& rhs) const {
+        return rhs.cur_ - cur_;
+    }
+
+public:
+    constexpr transform_iterator() = default;
+    constexpr transform_iterator(Iter cur, const F* fn) : cur_(cur), fn_(fn) {}
+
+    constexpr Iter base() const { return cur_; }
+};
+
+template <typename V, typename F>
+class transform_view : public view_interface<transform_view<V, F>> {
+private:
+    V base_;
+    F fn_;
+
+public:
+    using iterator = transform_iterator<views_detail::iterator_t<const V>, F>;
+
+    constexpr transform_view(V base, F fn)
+        : base_(mystl::move(base)), fn_(mystl::move(fn)) {}
+
+    constexpr iterator begin() const {
+        return iterator(views_detail::begin(base_), &fn_);
+    }
+    constexpr iterator end() const {
+        return iterator(views_detail::end(base_), &fn_);
+    }
+    constexpr const V& base() const { return base_; }
+};
+
+/*****************************************************************************************/
+// filter
+/*****************************************************************************************/
+
+template <typename Iter, typename Pred>
+class filter_iterator
+    : public views_detail::iterator_facade<
+          filter_iterator<Iter, Pred>,
+          typename iterator_traits<Iter>::reference> {
+public:
+    using iterator_category =
+        views_detail::category_t<Iter, bidirectional_iterator_tag>;
+    using reference = typename iterator_traits<Iter>::reference;
+    using value_type = typename iterator_traits<Iter>::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = typename iterator_traits<Iter>::pointer;
+
+private:
+    friend views_detail::iterator_facade<filter_iterator, reference>;
+
+    Iter cur_{};
+    Iter last_{};
+    const Pred* pred_ = nullptr;
+
+    constexpr reference read() const { return *cur_; }
+    constexpr void next() {
+        ++cur_;
+        skip();
+    }
+    constexpr void prev() {
+        do {
+            --cur_;
+        } while (!std::invoke(*pred_, *cur_));
+    }
+    constexpr bool equal(const filter_iterator& rhs) const {
+        return cur_ == rhs.cur_;
+    }
+    constexpr void skip() {
+        while (cur_ != last_ && !std::invoke(*pred_, *cur_)) {
+            ++cur_;
+        }
+    }
+
+public:
+    constexpr filter_iterator() = default;
+    // cur 移动到第一个满足谓词的位置
+    constexpr filter_iterator(Iter cur, Iter last, const Pred* pred)
+        : cur_(cur), last_(last), pred_(pred) {
+        skip();
+    }
+
+    constexpr Iter base() const { return cur_; }
+};
+
+// begin 每次调用都要从头找到第一个满足谓词的元素
+template <typename V, typename Pred>
+class filter_view : public view_interface<filter_view<V, Pred>> {
+private:
+    V base_;
+    Pred pred_;
+
+public:
+    using iterator = filter_iterator<views_detail::iterator_t<const V>, Pred>;
+
+    constexpr filter_view(V base, Pred pred)
+        : base_(mystl::move(base)), pred_(mystl::move(pred)) {}
+
+    constexpr iterator begin() const {
+        return iterator(views_detail::begin(base_), views_detail::end(base_),
+                        &pred_);
+    }
+    constexpr iterator end() const {
+        return iterator(views_detail::end(base_), views_detail::end(base_),
+                        &pred_);
+    }
+    constexpr const V& base() const { return base_; }
+};
+
+/*****************************************************************************************/
+// take / drop
+/*****************************************************************************************/
+
+// 非随机访问区间的 take：同时记录剩余个数，个数用完或底层区间结束都视为尾后
+template <typename Iter>
+class take_iterator
+    : public views_detail::iterator_facade<
+          take_iterator<Iter>, typename iterator_traits<Iter>::reference> {
+public:
+    using iterator_category =
+        views_detail::category_t<Iter, forward_iterator_tag>;
+    using reference = typename iterator_traits<Iter>::reference;
+    using value_type = typename iterator_traits<Iter>::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = typename iterator_traits<Iter>::pointer;
+
+private:
+    friend views_detail::iterator_facade<take_iterator, reference>;
+
+    Iter cur_{};
+    Iter last_{};
+    ptrdiff_t count_ = 0;
+
+    constexpr bool done() const { return count_ == 0 || cur_ == last_; }
+    constexpr reference read() const { return *cur_; }
+    constexpr void next() {
+        ++cur_;
+        --count_;
+    }
+    constexpr bool equal(const take_iterator& rhs) const {
+        return done() ? rhs.done() : !rhs.done() && cur_ == rhs.cur_;
+    }
+
+public:
+    constexpr take_iterator() = default;
+    constexpr take_iterator(Iter cur, Iter last, ptrdiff_t count)
+        : cur_(cur), last_(last), count_(count) {}
+
+    constexpr Iter base() const { return cur_; }
+};
+
+template <typename V>
+class take_view : public view_interface<take_view<V>> {
+private:
+    using base_iterator = views_detail::iterator_t<const V>;
+    static constexpr bool kRandom = views_detail::is_random_v<base_iterator>;
+
+    V base_;
+    ptrdiff_t count_;
+
+public:
+    // 随机访问时直接使用底层迭代器
+    using iterator = std::conditional_t<kRandom, base_iterator,
+                                        take_iterator<base_iterator>>;
+
+    constexpr take_view(V base, ptrdiff_t count)
+        : base_(mystl::move(base)), count_(count < 0 ? 0 : count) {}
+
+    constexpr iterator begin() const {
+        if constexpr (kRandom) {
+            return views_detail::begin(base_);
+        } else {
+            return iterator(views_detail::begin(base_),
+                            views_detail::end(base_), count_);
+        }
+    }
+    constexpr iterator end() const {
+        if constexpr (kRandom) {
+            const base_iterator first = views_detail::begin(base_);
+            const ptrdiff_t n = views_detail::end(base_) - first;
+            return first + (count_ < n ? count_ : n);
+        } else {
+            return iterator(views_detail::end(base_), views_detail::end(base_),
+                            0);
+        }
+    }
+    constexpr const V& base() const { return base_; }
+};
+
+// 迭代器就是底层迭代器，begin 在非随机访问时逐个前进
+template <typename V>
+class drop_view : public view_interface<drop_view<V>> {
+private:
+    using base_iterator = views_detail::iterator_t<const V>;
+
+    V base_;
+    ptrdiff_t count_;
+
+public:
+    using iterator = base_iterator;
+
+    constexpr drop_view(V base, ptrdiff_t count)
+        : base_(mystl::move(base)), count_(count < 0 ? 0 : count) {}
+
+    constexpr iterator begin() const {
+        iterator first = views_detail::begin(base_);
+        const iterator last = views_detail::end(base_);
+        if constexpr (views_detail::is_random_v<base_iterator>) {
+            const ptrdiff_t n = last - first;
+            return first + (count_ < n ? count_ : n);
+        } else {
+            for (ptrdiff_t i = 0; i < count_ && first != last; ++i) {
+                ++first;
+            }
+            return first;
+        }
+    }
+    constexpr iterator end() const { return views_detail::end(base_); }
+    constexpr const V& base() const { return base_; }
+};
+
+/*****************************************************************************************/
+// zip / enumerate
+/*****************************************************************************************/
+
+template <typename Iter1, typename Iter2>
+class zip_iterator
+    : public views_detail::iterator_facade<
+          zip_iterator<Iter1, Iter2>,
+          pair<typename iterator_traits<Iter1>::reference,
+               typename iterator_traits<Iter2>::reference>> {
+    static constexpr bool kRandom = views_detail::is_random_v<Iter1> &&
+                                    views_detail::is_random_v<Iter2>;
+
+public:
+    // 两侧长度不同时尾后迭代器只有在随机访问时才能对齐，
+    // 否则从尾后迭代器后退会得到错位的一对，因此最多是前向迭代器
+    using iterator_category = std::conditional_t<
+        kRandom, random_access_iterator_tag,
+        views_detail::weaker_t<
+            views_detail::category_t<Iter1, forward_iterator_tag>,
+            views_detail::category_t<Iter2, forward_iterator_tag>>>;
+    using reference = pair<typename iterator_traits<Iter1>::reference,
+                           typename iterator_traits<Iter2>::reference>;
+    using value_type = pair<typename iterator_traits<Iter1>::value_type,
+                            typename iterator_traits<Iter2>::value_type>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+
+private:
+    friend views_detail::iterator_facade<zip_iterator, reference>;
+
+    Iter1 it1_{};
+    Iter2 it2_{};
+
+    constexpr reference read() const { return reference(*it1_, *it2_); }
+    constexpr void next() {
+        ++it1_;
+        ++it2_;
+    }
+    constexpr void prev() {
+        --it1_;
+        --it2_;
+    }
+    constexpr void advance(ptrdiff_t n) {
+        it1_ += n;
+        it2_ += n;
+    }
+    // 随机访问时尾后迭代器已经对齐到较短的一侧；否则任意一侧到达尾后即结束
+    constexpr bool equal(const zip_iterator& rhs) const {
+        if constexpr (kRandom) {
+            return it1_ == rhs.it1_;
+        } else {
+            return it1_ == rhs.it1_ || it2_ == rhs.it2_;
+        }
+    }
+    constexpr ptrdiff_t distance_to(const zip_iterator& rhs) const {
+        return rhs.it1_ - it1_;
+    }
+
+public:
+    constexpr zip_iterator() = default;
+    constexpr zip_iterator(Iter1 it1, Iter2 it2) : it1_(it1), it2_(it2) {}
+};
+
+template <typename V1, typename V2>
+class zip_view : public view_interface<zip_view<V1, V2>> {
+private:
+    using iterator1 = views_detail::iterator_t<const V1>;
+    using iterator2 = views_detail::iterator_t<const V2>;
+
+    V1 base1_;
+    V2 base2_;
+
+public:
+    using iterator = zip_iterator<iterator1, iterator2>;
+
+    constexpr zip_view(V1 base1, V2 base2)
+        : base1_(mystl::move(base1)), base2_(mystl::move(base2)) {}
+
+    constexpr iterator begin() const {
+        return iterator(views_detail::begin(base1_),
+                        views_detail::begin(base2_));
+    }
+    constexpr iterator end() const {
+        if constexpr (views_detail::is_random_v<iterator1> &&
+                      views_detail::is_random_v<iterator2>) {
+            const ptrdiff_t n1 = views_detail::end(base1_) -
+                                 views_detail::begin(base1_);
+            const ptrdiff_t n2 = views_detail::end(base2_) -
+                                 views_detail::begin(base2_);
+            return begin() + (n1 < n2 ? n1 : n2);
+        } else {
+            return iterator(views_detail::end(base1_),
+                            views_detail::end(base2_));
+        }
+    }
+};
+
+template <typename Iter>
+class enumerate_iterator
+    : public views_detail::iterator_facade<
+          enumerate_iterator<Iter>,
+          pair<size_t, typename iterator_traits<Iter>::reference>> {
+public:
+    using iterator_category =
+        views_detail::category_t<Iter, random_access_iterator_tag>;
+    using reference = pair<size_t, typename iterator_traits<Iter>::reference>;
+    using value_type =
+        pair<size_t, typename iterator_traits<Iter>::value_type>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+
+private:
+    friend views_detail::iterator_facade<enumerate_iterator, reference>;
+
+    size_t index_ = 0;
+    Iter cur_{};
+
+    constexpr reference read() const { return reference(index_, *cur_); }
+    constexpr void next() {
+        ++index_;
+        ++cur_;
+    }
+    constexpr void prev() {
+        --index_;
+        --cur_;
+    }
+    constexpr void advance(ptrdiff_t n) {
+        index_ += static_cast<size_t>(n);
+        cur_ += n;
+    }
+    constexpr bool equal(const enumerate_iterator& rhs) const {
+        return cur_ == rhs.cur_;
+    }
+    constexpr ptrdiff_t distance_to(const enumerate_iterator& rhs) const {
+        return rhs.cur_ - cur_;
+    }
+
+public:
+    constexpr enumerate_iterator() = default;
+    constexpr enumerate_iterator(size_t index, Iter cur)
+        : index_(index), cur_(cur) {}
+
+    constexpr Iter base() const { return cur_; }
+};
+
+template <typename V>
+class enumerate_view : public view_interface<enumerate_view<V>> {
+private:
+    using base_iterator = views_detail::iterator_t<const V>;
+
+    V base_;
+
+public:
+    using iterator = enumerate_iterator<base_iterator>;
+
+    constexpr explicit enumerate_view(V base) : base_(mystl::move(base)) {}
+
+    constexpr iterator begin() const {
+        return iterator(0, views_detail::begin(base_));
+    }
+    // 尾后迭代器只比较底层迭代器，非随机访问时不需要知道下标
+    constexpr iterator end() const {
+        if constexpr (views_detail::is_random_v<base_iterator>) {
+            const auto n =
+                views_detail::end(base_) - views_detail::begin(base_);
+            return iterator(static_cast<size_t>(n), views_detail::end(base_));
+        } else {
+            return iterator(0, views_detail::end(base_));
+        }
+    }
+};
+
+/*****************************************************************************************/
+// chunk
+/*****************************************************************************************/
+
+// 随机访问区间的块迭代器：按块的序号定位，可以随机访问
+template <typename Iter>
+class chunk_iterator
+    : public views_detail::iterator_facade<chunk_iterator<Iter>,
+                                           subrange<Iter>> {
+public:
+    using iterator_category = random_access_iterator_tag;
+    using reference = subrange<Iter>;
+    using value_type = subrange<Iter>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+
+private:
+    friend views_detail::iterator_facade<chunk_iterator, reference>;
+
+    Iter first_{};
+    ptrdiff_t size_ = 0;
+    ptrdiff_t width_ = 1;
+    ptrdiff_t index_ = 0;
+
+    constexpr reference read() const {
+        const ptrdiff_t lo = index_ * width_;
+        const ptrdiff_t hi = size_ - lo > width_ ? lo + width_ : size_;
+        return reference(first_ + lo, first_ + hi);
+    }
+    constexpr void next() { ++index_; }
+    constexpr void prev() { --index_; }
+    constexpr void advance(ptrdiff_t n) { index_ += n; }
+    constexpr bool equal(const chunk_iterator& rhs) const {
+        return index_ == rhs.index_;
+    }
+    constexpr ptrdiff_t distance_to(const chunk_iterator& rhs) const {
+        return rhs.index_ - index_;
+    }
+
+public:
+    constexpr chunk_iterator() = default;
+    constexpr chunk_iterator(Iter first, ptrdiff_t size, ptrdiff_t width,
+                             ptrdiff_t index)
+        : first_(first), size_(size), width_(width), index_(index) {}
+};
+
+// 非随机访问区间的块迭代器：同时记录当前块的尾后位置
+template <typename Iter>
+class forward_chunk_iterator
+    : public views_detail::iterator_facade<forward_chunk_iterator<Iter>,
+                                           subrange<Iter>> {
+public:
+    using iterator_category = forward_iterator_tag;
+    using reference = subrange<Iter>;
+    using value_type = subrange<Iter>;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+
+private:
+    friend views_detail::iterator_facade<forward_chunk_iterator, reference>;
+
+    Iter cur_{};
+    Iter next_{};
+    Iter last_{};
+    ptrdiff_t width_ = 1;
+
+    constexpr reference read() const { return reference(cur_, next_); }
+    constexpr void next() {
+        cur_ = next_;
+        find_next();
+    }
+    constexpr bool equal(const forward_chunk_iterator& rhs) const {
+        return cur_ == rhs.cur_;
+    }
+    constexpr void find_next() {
+        next_ = cur_;
+        for (ptrdiff_t i = 0; i < width_ && next_ != last_; ++i) {
+            ++next_;
+        }
+    }
+
+public:
+    constexpr forward_chunk_iterator() = default;
+    constexpr forward_chunk_iterator(Iter cur, Iter last, ptrdiff_t width)
+        : cur_(cur), last_(last), width_(width) {
+        find_next();
+    }
+};
+
+// 每块是底层迭代器的 subrange：连续区间的块仍然是连续区间，块内可以使用
+// SIMD 内核；随机访问区间的块视图本身也可以随机访问，可以交给并行算法
+template <typename V>
+class chunk_view : public view_interface<chunk_view<V>> {
+private:
+    using base_iterator = views_detail::iterator_t<const V>;
+    static constexpr bool kRandom = views_detail::is_random_v<base_iterator>;
+
+    V base_;
+    ptrdiff_t width_;
+
+public:
+    using iterator = std::conditional_t<kRandom, chunk_iterator<base_iterator>,
+                                        forward_chunk_iterator<base_iterator>>;
+
+    // width 必须大于 0
+    constexpr chunk_view(V base, ptrdiff_t width)
+        : base_(mystl::move(base)), width_(width) {}
+
+    constexpr iterator begin() const {
+        if constexpr (kRandom) {
+            return iterator(views_detail::begin(base_), base_size(), width_,
+                            0);
+        } else {
+            return iterator(views_detail::begin(base_),
+                            views_detail::end(base_), width_);
+        }
+    }
+    constexpr iterator end() const {
+        if constexpr (kRandom) {
+            const ptrdiff_t n = base_size();
+            return iterator(views_detail::begin(base_), n, width_,
+                            (n + width_ - 1) / width_);
+        } else {
+            return iterator(views_detail::end(base_), views_detail::end(base_),
+                            width_);
+        }
+    }
+
+private:
+    constexpr ptrdiff_t base_size() const {
+        return views_detail::end(base_) - views_detail::begin(base_);
+    }
+};
+
+/*****************************************************************************************/
+// 适配器对象
+// views::xxx(r, args...) 直接构造视图，views::xxx(args...) 返回可以用 | 串联的适配器
+/*****************************************************************************************/
+
+namespace views_detail {
+
+struct transform_fn {
+    template <Range R, typename F>
+    constexpr auto operator()(R&& r, F fn) const {
+        return transform_view<views::all_t<R>, F>(
+            views::all(mystl::forward<R>(r)), mystl::move(fn));
+    }
+
+    template <typename F>
+    constexpr auto operator()(F fn) const {
+        return closure{[fn](auto&& r) {
+            return transform_fn{}(mystl::forward<decltype(r)>(r), fn);
+        }};
+    }
+};
+
+struct filter_fn {
+    template <Range R, typename Pred>
+    constexpr auto operator()(R&& r, Pred pred) const {
+        return filter_view<views::all_t<R>, Pred>(
+            views::all(mystl::forward<R>(r)), mystl::move(pred));
+    }
+
+    template <typename Pred>
+    constexpr auto operator()(Pred pred) const {
+        return closure{[pred](auto&& r) {
+            return filter_fn{}(mystl::forward<decltype(r)>(r), pred);
+        }};
+    }
+};
+
+struct take_fn {
+    template <Range R>
+    constexpr auto operator()(R&& r, ptrdiff_t n) const {
+        return take_view<views::all_t<R>>(views::all(mystl::forward<R>(r)), n);
+    }
+
+    constexpr auto operator()(ptrdiff_t n) const {
+        return closure{[n](auto&& r) {
+            return take_fn{}(mystl::forward<decltype(r)>(r), n);
+        }};
+    }
+};
+
+struct drop_fn {
+    template <Range R>
+    constexpr auto operator()(R&& r, ptrdiff_t n) const {
+        return drop_view<views::all_t<R>>(views::all(mystl::forward<R>(r)), n);
+    }
+
+    constexpr auto operator()(ptrdiff_t n) const {
+        return closure{[n](auto&& r) {
+            return drop_fn{}(mystl::forward<decltype(r)>(r), n);
+        }};
+    }
+};
+
+struct chunk_fn {
+    template <Range R>
+    constexpr auto operator()(R&& r, ptrdiff_t n) const {
+        return chunk_view<views::all_t<R>>(views::all(mystl::forward<R>(r)),
+                                           n);
+    }
+
+    constexpr auto operator()(ptrdiff_t n) const {
+        return closure{[n](auto&& r) {
+            return chunk_fn{}(mystl::forward<decltype(r)>(r), n);
+        }};
+    }
+};
+
+struct zip_fn {
+    template <Range R1, Range R2>
+    constexpr auto operator()(R1&& r1, R2&& r2) const {
+        return zip_view<views::all_t<R1>, views::all_t<R2>>(
+            views::all(mystl::forward<R1>(r1)),
+            views::all(mystl::forward<R2>(r2)));
+    }
+};
+
+struct enumerate_fn {
+    template <Range R>
+    constexpr auto operator()(R&& r) const {
+        return enumerate_view<views::all_t<R>>(
+            views::all(mystl::forward<R>(r)));
+    }
+
+    template <Range R>
+    friend constexpr auto operator|(R&& r, const enumerate_fn& fn) {
+        return fn(mystl::forward<R>(r));
+    }
+};
+
+}  // namespace views_detail
+
+namespace views {
+
+inline constexpr views_detail::transform_fn transform{};
+inline constexpr views_detail::filter_fn filter{};
+inline constexpr views_detail::take_fn take{};
+inline constexpr views_detail::drop_fn drop{};
+inline constexpr views_detail::chunk_fn chunk{};
+inline constexpr views_detail::zip_fn zip{};
+inline constexpr views_detail::enumerate_fn enumerate{};
+
+}  // namespace views
+
+}  // namespace mystl
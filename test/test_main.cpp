@@ -1,5 +1,47 @@
+// 测试中打开分配统计，见 alloc_stats.hpp
+#define MYSTL_ALLOC_STATS 1
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <system_error>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "algorithm.hpp"
+#include "array.hpp"
+#include "alloc_stats.hpp"
+#include "allocator.hpp"
+#include "btree.hpp"
+#include "concurrent_hash_map.hpp"
+#include "deque.hpp"
+#include "execution.hpp"
+#include "flat_hash_map.hpp"
+#include "mmap.hpp"
+#include "mpmc_queue.hpp"
+#include "numeric.hpp"
+#include "serialize.hpp"
+#include "soa_vector.hpp"
+#include "sort.hpp"
+#include "static_map.hpp"
+#include "string.hpp"
+#include "thread_pool.hpp"
+#include "uninitialized.hpp"
+#include "vector.hpp"
+#include "views.hpp"
 #include "util.hpp"
 #include "iterator.hpp"
 
@@ -37,6 +79,2267 @@ TEST(iterator_has_iterator_cat, has_iterator_cat) {
     EXPECT_TRUE(mystl::has_iterator_cat<X>::value);
 }
 
+TEST(pool_allocator_test, reuse_freed_block) {
+    using alloc = mystl::pool_allocator<double>;
+    double* p = alloc::allocate(3);
+    alloc::construct(p, 1.5);
+    EXPECT_EQ(*p, 1.5);
+    alloc::destory(p);
+    alloc::deallocate(p, 3);
+    // 同一大小级别的下一次分配应取回刚释放的区块
+    double* q = alloc::allocate(3);
+    EXPECT_EQ(p, q);
+    alloc::deallocate(q, 3);
+}
+
+TEST(pool_allocator_test, large_block_bypass_pool) {
+    using alloc = mystl::pool_allocator<char>;
+    char* p = alloc::allocate(mystl::pool_alloc::kMaxBytes + 1);
+    ASSERT_NE(p, nullptr);
+    p[mystl::pool_alloc::kMaxBytes] = 'x';
+    alloc::deallocate(p, mystl::pool_alloc::kMaxBytes + 1);
+    EXPECT_EQ(alloc::allocate(0), nullptr);
+}
+
+TEST(arena_allocator_test, bump_and_release) {
+    mystl::arena resource(256);
+    mystl::arena_allocator<int> alloc(resource);
+    int* a = alloc.allocate(4);
+    int* b = alloc.allocate(4);
+    // 同一大块内的分配是连续的
+    EXPECT_EQ(a + 4, b);
+    for (int i = 0; i < 4; ++i) {
+        alloc.construct(a + i, i);
+    }
+    EXPECT_EQ(a[3], 3);
+
+    // 超过大块大小的请求单独申请一个大块
+    mystl::arena_allocator<double> other(alloc);
+    EXPECT_TRUE(other == alloc);
+    double* big = other.allocate(1000);
+    big[999] = 1.0;
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % alignof(double), 0u);
+    resource.release();
+    EXPECT_NE(alloc.allocate(1), nullptr);
+}
+TEST(thread_cache_allocator_test, multi_thread_alloc_free) {
+    using alloc = mystl::thread_cache_allocator<long>;
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([t] {
+            std::vector<long*> blocks;
+            for (int i = 0; i < kRounds; ++i) {
+                long* p = alloc::allocate(1 + i % 8);
+                *p = t * kRounds + i;
+                blocks.push_back(p);
+            }
+            for (int i = 0; i < kRounds; ++i) {
+                EXPECT_EQ(*blocks[i], t * kRounds + i);
+                alloc::deallocate(blocks[i], 1 + i % 8);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+TEST(thread_cache_allocator_test, cross_thread_free) {
+    using alloc = mystl::thread_cache_allocator<int>;
+    std::vector<int*> blocks;
+    std::thread producer([&blocks] {
+        for (int i = 0; i < 1000; ++i) {
+            blocks.push_back(alloc::allocate(4));
+        }
+    });
+    producer.join();
+    // 由另一个线程分配的区块可以在本线程释放并再次分配
+    for (int* p : blocks) {
+        alloc::deallocate(p, 4);
+    }
+    int* p = alloc::allocate(4);
+    EXPECT_EQ(p, blocks.back());
+    alloc::deallocate(p, 4);
+}
+// 第 kThrowAt 次复制构造时抛出异常，用于检查已构造元素是否被析构
+struct throwing_copy {
+    static inline int live = 0;
+    static inline int copies = 0;
+    static constexpr int kThrowAt = 3;
+    int value = 0;
+
+    throwing_copy(int v) : value(v) { ++live; }
+    throwing_copy(const throwing_copy& rhs) : value(rhs.value) {
+        if (++copies == kThrowAt) {
+            throw 1;
+        }
+        ++live;
+    }
+    ~throwing_copy() { --live; }
+};
+
+TEST(uninitialized_test, trivial_copy_and_fill) {
+    int src[5] = {1, 2, 3, 4, 5};
+    int dst[5] = {};
+    int* end = mystl::uninitialized_copy(src, src + 5, dst);
+    EXPECT_EQ(end, dst + 5);
+    EXPECT_EQ(dst[4], 5);
+
+    mystl::uninitialized_fill_n(dst, 3, 7);
+    EXPECT_EQ(dst[2], 7);
+    EXPECT_EQ(dst[3], 4);
+
+    char buf[4];
+    mystl::uninitialized_fill(buf, buf + 4, 'x');
+    EXPECT_EQ(buf[3], 'x');
+
+    // 按元素类型转换后再填充，bool 中只会出现 0 或 1
+    bool flags[4];
+    mystl::uninitialized_fill_n(flags, 4, 2);
+    unsigned char flag_byte;
+    std::memcpy(&flag_byte, &flags[3], 1);
+    EXPECT_EQ(flag_byte, 1);
+
+    // 单字节的类类型逐个复制
+    struct tag {
+        char c;
+    };
+    tag tags[3];
+    mystl::uninitialized_fill_n(tags, 3, tag{'t'});
+    EXPECT_EQ(tags[2].c, 't');
+
+    // 可平凡复制但不能赋值的类型
+    struct fixed {
+        const int x;
+    };
+    mystl::vector<fixed> fixeds(4, fixed{1});
+    EXPECT_EQ(fixeds[3].x, 1);
+
+    mystl::uninitialized_value_construct(dst, dst + 5);
+    EXPECT_EQ(dst[0], 0);
+    EXPECT_EQ(dst[4], 0);
+}
+
+TEST(uninitialized_test, rollback_on_exception) {
+    throwing_copy src[4] = {1, 2, 3, 4};
+    alignas(throwing_copy) unsigned char raw[sizeof(throwing_copy) * 4];
+    auto* dst = reinterpret_cast<throwing_copy*>(raw);
+    throwing_copy::copies = 0;
+    EXPECT_THROW(mystl::uninitialized_copy(src, src + 4, dst), int);
+    // 只剩下 src 中的 4 个对象
+    EXPECT_EQ(throwing_copy::live, 4);
+}
+// 不是 trivially copyable，但可以安全地 memcpy
+struct relocatable_handle {
+    static inline int moves = 0;
+    static inline int destroys = 0;
+    int* ptr;
+
+    explicit relocatable_handle(int* p) : ptr(p) {}
+    relocatable_handle(relocatable_handle&& rhs) : ptr(rhs.ptr) {
+        rhs.ptr = nullptr;
+        ++moves;
+    }
+    ~relocatable_handle() { ++destroys; }
+};
+
+template <>
+struct mystl::is_trivially_relocatable<relocatable_handle>
+    : mystl::m_true_type {};
+
+TEST(relocate_test, trivially_relocatable_uses_memcpy) {
+    static_assert(mystl::is_trivially_relocatable_v<int>);
+    static_assert(mystl::is_trivially_relocatable_v<
+                  mystl::pair<int, relocatable_handle>>);
+    static_assert(!mystl::is_trivially_relocatable_v<throwing_copy>);
+
+    int values[3] = {1, 2, 3};
+    alignas(relocatable_handle) unsigned char
+        src_raw[sizeof(relocatable_handle) * 3];
+    alignas(relocatable_handle) unsigned char
+        dst_raw[sizeof(relocatable_handle) * 3];
+    auto* src = reinterpret_cast<relocatable_handle*>(src_raw);
+    auto* dst = reinterpret_cast<relocatable_handle*>(dst_raw);
+    for (int i = 0; i < 3; ++i) {
+        mystl::construct(src + i, values + i);
+    }
+    auto* end = mystl::relocate(src, src + 3, dst);
+    EXPECT_EQ(end, dst + 3);
+    EXPECT_EQ(*dst[2].ptr, 3);
+    EXPECT_EQ(relocatable_handle::moves, 0);
+    EXPECT_EQ(relocatable_handle::destroys, 0);
+    mystl::destory(dst, dst + 3);
+}
+
+TEST(relocate_test, fallback_moves_then_destroys) {
+    throwing_copy::live = 0;
+    alignas(throwing_copy) unsigned char src_raw[sizeof(throwing_copy) * 2];
+    alignas(throwing_copy) unsigned char dst_raw[sizeof(throwing_copy) * 2];
+    auto* src = reinterpret_cast<throwing_copy*>(src_raw);
+    auto* dst = reinterpret_cast<throwing_copy*>(dst_raw);
+    mystl::construct(src, 1);
+    mystl::construct(src + 1, 2);
+    throwing_copy::copies = -10;
+    mystl::relocate(src, src + 2, dst);
+    EXPECT_EQ(dst[1].value, 2);
+    EXPECT_EQ(throwing_copy::live, 2);
+    mystl::destory(dst, dst + 2);
+}
+TEST(vector_test, growth_and_access) {
+    mystl::vector<int> v;
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(v.emplace_back(i), i);
+    }
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_GE(v.capacity(), 100u);
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 99);
+    EXPECT_EQ(*v.rbegin(), 99);
+    EXPECT_THROW(v.at(100), std::out_of_range);
+
+    v.reserve(1000);
+    EXPECT_EQ(v.capacity(), 1000u);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 100u);
+    EXPECT_EQ(v[50], 50);
+
+    v.resize(3);
+    v.resize(5, 7);
+    EXPECT_EQ(v, (mystl::vector<int>{0, 1, 2, 7, 7}));
+}
+
+TEST(vector_test, insert_and_erase) {
+    mystl::vector<int> v{1, 2, 3};
+    v.insert(v.begin() + 1, 10);
+    v.insert(v.end(), 2, 20);
+    int extra[] = {5, 6};
+    v.insert(v.begin(), extra, extra + 2);
+    EXPECT_EQ(v, (mystl::vector<int>{5, 6, 1, 10, 2, 3, 20, 20}));
+
+    // 插入的值引用自身元素
+    v.insert(v.begin(), v.back());
+    EXPECT_EQ(v.front(), 20);
+
+    v.erase(v.begin(), v.begin() + 3);
+    v.erase(v.end() - 1);
+    EXPECT_EQ(v, (mystl::vector<int>{1, 10, 2, 3, 20}));
+}
+
+TEST(vector_test, non_trivial_elements) {
+    mystl::vector<std::vector<int>> v;
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(std::vector<int>(i, i));
+    }
+    v.insert(v.begin() + 2, std::vector<int>{42});
+    v.erase(v.begin());
+    EXPECT_EQ(v.size(), 20u);
+    EXPECT_EQ(v[1], std::vector<int>{42});
+    EXPECT_EQ(v[19].size(), 19u);
+
+    mystl::vector<std::vector<int>> copy(v);
+    mystl::vector<std::vector<int>> moved(mystl::move(v));
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(copy, moved);
+}
+
+// 不可复制，第 throw_at 次移动构造时抛出异常
+struct throwing_move {
+    static inline int live = 0;
+    static inline int moves = 0;
+    static inline int throw_at = 0;
+    int value = 0;
+
+    explicit throwing_move(int v) : value(v) { ++live; }
+    throwing_move(throwing_move&& rhs) : value(rhs.value) {
+        if (++moves == throw_at) {
+            throw 1;
+        }
+        ++live;
+    }
+    throwing_move(const throwing_move&) = delete;
+    throwing_move& operator=(throwing_move&&) = default;
+    ~throwing_move() { --live; }
+};
+
+// 新空间的释放由 ASan 构建中的泄漏检查覆盖
+TEST(vector_test, throwing_move_during_reallocation) {
+    mystl::vector<throwing_move> v;
+    v.reserve(4);
+    for (int i = 0; i < 4; ++i) {
+        v.emplace_back(i);
+    }
+
+    // 搬运插入点之前的元素时失败，原有元素不受影响
+    throwing_move::moves = 0;
+    throwing_move::throw_at = 2;
+    EXPECT_THROW(v.emplace(v.begin() + 2, 9), int);
+    ASSERT_EQ(v.size(), 4u);
+    EXPECT_EQ(v[1].value, 1);
+    EXPECT_EQ(throwing_move::live, 4);
+
+    // 前半部分已经搬走后失败，容器变为空且不泄漏元素
+    throwing_move::moves = 0;
+    throwing_move::throw_at = 3;
+    EXPECT_THROW(v.emplace(v.begin() + 2, 9), int);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(throwing_move::live, 0);
+    throwing_move::throw_at = 0;
+}
+
+TEST(vector_test, arena_allocator) {
+    mystl::arena resource;
+    mystl::arena_allocator<int> alloc(resource);
+    mystl::vector<int, mystl::arena_allocator<int>> v(alloc);
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v[999], 999);
+}
+
+TEST(small_vector_test, inline_then_heap) {
+    mystl::small_vector<int, 4> v{1, 2, 3};
+    const int* inline_data = v.data();
+    v.push_back(4);
+    EXPECT_EQ(v.data(), inline_data);
+    v.push_back(5);
+    EXPECT_NE(v.data(), inline_data);
+    EXPECT_EQ(v.capacity(), 8u);
+
+    mystl::small_vector<int, 4> moved(mystl::move(v));
+    EXPECT_EQ(moved.size(), 5u);
+    moved.resize(2);
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.capacity(), 4u);
+
+    mystl::small_vector<std::string, 2> a{"a"};
+    mystl::small_vector<std::string, 2> b{"b", "c", "d"};
+    a.swap(b);
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(b[0], "a");
+}
+TEST(flat_hash_map_test, insert_find_erase) {
+    mystl::flat_hash_map<int, int> m;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(m.try_emplace(i, i * 2).second);
+    }
+    EXPECT_FALSE(m.insert(mystl::pair<const int, int>(5, 0)).second);
+    EXPECT_EQ(m.size(), 1000u);
+    EXPECT_LE(m.load_factor(), m.max_load_factor());
+    EXPECT_EQ(m.at(500), 1000);
+    EXPECT_THROW(m.at(1000), std::out_of_range);
+    EXPECT_THROW(m.reserve(m.max_size() + 1), std::length_error);
+
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_EQ(m.erase(i), 1u);
+    }
+    EXPECT_EQ(m.erase(0), 0u);
+    EXPECT_EQ(m.size(), 500u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(m.contains(i), i % 2 == 1);
+    }
+
+    size_t visited = 0;
+    for (const auto& kv : m) {
+        EXPECT_EQ(kv.second, kv.first * 2);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 500u);
+
+    EXPECT_EQ(m.erase_if([](const auto& kv) { return kv.first < 500; }),
+              250u);
+    EXPECT_EQ(m.size(), 250u);
+    EXPECT_FALSE(m.contains(499));
+    EXPECT_TRUE(m.contains(501));
+}
+
+TEST(flat_hash_map_test, rehash_rolls_back_on_throwing_copy) {
+    throwing_copy::live = 0;
+    {
+        mystl::flat_hash_map<int, throwing_copy> m;
+        m.reserve(20);
+        const size_t cap = m.capacity();
+        int n = 0;
+        throwing_copy::copies = -1000;
+        // 填到下一次插入就会触发 rehash
+        while (m.size() < cap - cap / 8) {
+            m.try_emplace(n, n);
+            ++n;
+        }
+        EXPECT_EQ(m.capacity(), cap);
+
+        // rehash 复制第二个元素时抛出异常，原表不受影响
+        throwing_copy::copies = throwing_copy::kThrowAt - 2;
+        EXPECT_THROW(m.try_emplace(n, n), int);
+        EXPECT_EQ(m.capacity(), cap);
+        EXPECT_EQ(m.size(), static_cast<size_t>(n));
+        EXPECT_EQ(throwing_copy::live, n);
+        for (int i = 0; i < n; ++i) {
+            EXPECT_EQ(m.at(i).value, i);
+        }
+
+        EXPECT_TRUE(m.try_emplace(n, n).second);
+        EXPECT_GT(m.capacity(), cap);
+        EXPECT_EQ(m.at(n / 2).value, n / 2);
+    }
+    EXPECT_EQ(throwing_copy::live, 0);
+
+    // 不可复制的类型只能搬运，失败后表仍然完整，只是丢掉了未搬运的元素
+    throwing_move::live = 0;
+    {
+        mystl::flat_hash_map<int, throwing_move> m;
+        m.reserve(20);
+        const size_t cap = m.capacity();
+        int n = 0;
+        throwing_move::throw_at = 0;
+        while (m.size() < cap - cap / 8) {
+            m.try_emplace(n, n);
+            ++n;
+        }
+        throwing_move::moves = 0;
+        throwing_move::throw_at = 4;
+        EXPECT_THROW(m.try_emplace(n, n), int);
+        throwing_move::throw_at = 0;
+        EXPECT_EQ(throwing_move::live, static_cast<int>(m.size()));
+        size_t visited = 0;
+        for (const auto& kv : m) {
+            EXPECT_EQ(kv.second.value, kv.first);
+            EXPECT_TRUE(m.contains(kv.first));
+            ++visited;
+        }
+        EXPECT_EQ(visited, m.size());
+    }
+    EXPECT_EQ(throwing_move::live, 0);
+}
+
+// 第 throw_at 次调用时抛出异常的哈希函数
+struct throwing_hash {
+    static inline int calls = 0;
+    static inline int throw_at = 0;
+
+    size_t operator()(int key) const {
+        if (++calls == throw_at) {
+            throw 2;
+        }
+        return std::hash<int>()(key);
+    }
+};
+
+TEST(flat_hash_map_test, throwing_hash_leaves_table_intact) {
+    mystl::flat_hash_map<int, mystl::string, throwing_hash> m;
+    m.reserve(100);
+    const size_t cap = m.capacity();
+    int n = 0;
+    while (m.size() < cap - cap / 8) {
+        m.try_emplace(n, mystl::string(40, 'a' + n % 26));
+        ++n;
+    }
+
+    // rehash 途中抛出异常，所有元素仍在原表中
+    throwing_hash::calls = 0;
+    throwing_hash::throw_at = 6;
+    EXPECT_THROW(m.try_emplace(n, "new"), int);
+    throwing_hash::throw_at = 0;
+    EXPECT_EQ(m.capacity(), cap);
+    ASSERT_EQ(m.size(), static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(m.at(i)[0], 'a' + i % 26);
+    }
+
+    // 删除时计算后续元素的哈希值失败，被删元素也保持不变
+    int failed = 0;
+    for (int i = 0; i < n; ++i) {
+        throwing_hash::calls = 0;
+        throwing_hash::throw_at = 2;
+        try {
+            m.erase(i);
+        } catch (int) {
+            ++failed;
+            throwing_hash::throw_at = 0;
+            EXPECT_TRUE(m.contains(i));
+        }
+    }
+    throwing_hash::throw_at = 0;
+    EXPECT_GT(failed, 0);
+    EXPECT_EQ(m.size(), static_cast<size_t>(failed));
+    size_t visited = 0;
+    for (const auto& kv : m) {
+        EXPECT_TRUE(m.contains(kv.first));
+        ++visited;
+    }
+    EXPECT_EQ(visited, m.size());
+}
+
+TEST(flat_hash_map_test, string_keys_and_copy) {
+    mystl::flat_hash_map<std::string, std::string> m;
+    m["alpha"] = "a";
+    m["beta"] = "b";
+    m.insert_or_assign("alpha", std::string("A"));
+    EXPECT_EQ(m["alpha"], "A");
+
+    auto copy = m;
+    EXPECT_EQ(copy, m);
+    copy.erase(copy.find("beta"));
+    EXPECT_NE(copy, m);
+    EXPECT_FALSE(copy.contains("beta"));
+
+    m.reserve(1000);
+    EXPECT_GE(m.capacity() * m.max_load_factor(), 1000.0f);
+    EXPECT_EQ(m.at("beta"), "b");
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+}
+TEST(btree_test, random_against_std_set) {
+    mystl::btree_set<int> s;
+    std::set<int> expect;
+    std::mt19937 gen(42);
+    for (int i = 0; i < 200000; ++i) {
+        const int key = static_cast<int>(gen() % 50000);
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(s.erase(key), expect.erase(key));
+        } else {
+            EXPECT_EQ(s.insert(key).second, expect.insert(key).second);
+        }
+    }
+    ASSERT_EQ(s.size(), expect.size());
+    EXPECT_GE(s.height(), 2u);
+    EXPECT_TRUE(std::equal(s.begin(), s.end(), expect.begin()));
+    EXPECT_TRUE(std::equal(s.rbegin(), s.rend(), expect.rbegin()));
+
+    for (int key = -1; key < 50001; key += 7) {
+        auto lb = s.lower_bound(key);
+        auto expect_lb = expect.lower_bound(key);
+        if (expect_lb == expect.end()) {
+            EXPECT_EQ(lb, s.end());
+        } else {
+            EXPECT_EQ(*lb, *expect_lb);
+        }
+        auto ub = s.upper_bound(key);
+        auto expect_ub = expect.upper_bound(key);
+        if (expect_ub == expect.end()) {
+            EXPECT_EQ(ub, s.end());
+        } else {
+            EXPECT_EQ(*ub, *expect_ub);
+        }
+    }
+
+    while (!s.empty()) {
+        s.erase(s.begin());
+    }
+    EXPECT_EQ(s.height(), 0u);
+}
+
+TEST(btree_test, map_with_string_values) {
+    mystl::btree_map<int, std::string> m;
+    for (int i = 0; i < 5000; ++i) {
+        m[i] = std::to_string(i);
+    }
+    EXPECT_EQ(m.at(1234), "1234");
+    EXPECT_FALSE(m.try_emplace(10, "x").second);
+    m.insert_or_assign(10, std::string("ten"));
+    EXPECT_EQ(m.find(10)->second, "ten");
+
+    using iter = mystl::btree_map<int, std::string>::iterator;
+    static_assert(
+        std::is_same_v<mystl::iterator_traits<iter>::iterator_category,
+                       mystl::bidirectional_iterator_tag>);
+    auto last = m.end();
+    --last;
+    EXPECT_EQ(last->first, 4999);
+
+    auto copy = m;
+    EXPECT_EQ(copy, m);
+    auto it = copy.erase(copy.find(100), copy.find(200));
+    EXPECT_EQ(it->first, 200);
+    EXPECT_EQ(copy.size(), 4900u);
+    for (int i = 0; i < 5000; i += 2) {
+        copy.erase(i);
+    }
+    int expect = 1;
+    for (const auto& kv : copy) {
+        if (expect == 101) {
+            expect = 201;
+        }
+        EXPECT_EQ(kv.first, expect);
+        EXPECT_EQ(kv.second, std::to_string(expect));
+        expect += 2;
+    }
+    EXPECT_NE(copy, m);
+}
+TEST(deque_test, random_against_std_deque) {
+    mystl::deque<int> d;
+    std::deque<int> ref;
+    std::mt19937 rng(9);
+    for (int i = 0; i < 20000; ++i) {
+        const int op = static_cast<int>(rng() % 8);
+        const int v = static_cast<int>(rng() % 1000);
+        if (op < 2) {
+            d.push_back(v);
+            ref.push_back(v);
+        } else if (op < 4) {
+            d.push_front(v);
+            ref.push_front(v);
+        } else if (op == 4 && !ref.empty()) {
+            d.pop_back();
+            ref.pop_back();
+        } else if (op == 5 && !ref.empty()) {
+            d.pop_front();
+            ref.pop_front();
+        } else if (op == 6) {
+            const size_t pos = rng() % (ref.size() + 1);
+            d.insert(d.begin() + pos, 3, v);
+            ref.insert(ref.begin() + pos, 3, v);
+        } else if (!ref.empty()) {
+            const size_t pos = rng() % ref.size();
+            const size_t n = rng() % (ref.size() - pos + 1);
+            d.erase(d.begin() + pos, d.begin() + pos + n);
+            ref.erase(ref.begin() + pos, ref.begin() + pos + n);
+        }
+        ASSERT_EQ(d.size(), ref.size());
+    }
+    ASSERT_EQ(d.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_EQ(d[i], ref[i]);
+    }
+
+    const int src[] = {1, 2, 3};
+    d.insert(d.begin() + 1, src, src + 3);
+    ref.insert(ref.begin() + 1, src, src + 3);
+    d.insert(d.end() - 1, {7, 8});
+    ref.insert(ref.end() - 1, {7, 8});
+    ASSERT_EQ(d.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_EQ(d[i], ref[i]);
+    }
+}
+
+// 统计分配次数的内存分配策略
+struct counting_alloc {
+    inline static size_t allocations = 0;
+
+    static void* allocate(size_t bytes) {
+        ++allocations;
+        return ::operator new(bytes);
+    }
+    static void deallocate(void* ptr, size_t /*bytes*/) {
+        ::operator delete(ptr);
+    }
+};
+
+TEST(deque_test, fifo_steady_state_does_not_allocate) {
+    mystl::deque<int, mystl::allocator<int, counting_alloc>> q;
+    for (int i = 0; i < 5000; ++i) {
+        q.push_back(i);
+    }
+    for (int i = 0; i < 100000; ++i) {
+        q.push_back(i);
+        q.pop_front();
+    }
+    const size_t before = counting_alloc::allocations;
+    for (int i = 0; i < 1000000; ++i) {
+        q.push_back(i);
+        q.pop_front();
+    }
+    EXPECT_EQ(counting_alloc::allocations, before);
+    EXPECT_EQ(q.size(), 5000u);
+    EXPECT_EQ(q.back(), 999999);
+}
+
+TEST(deque_test, stable_references_and_iterators) {
+    mystl::deque<std::string> d;
+    d.push_back("middle");
+    std::string* p = &d.front();
+    for (int i = 0; i < 3000; ++i) {
+        d.push_back(std::to_string(i));
+        d.emplace_front(std::to_string(-i));
+    }
+    EXPECT_EQ(p, &d[3000]);
+    EXPECT_EQ(*p, "middle");
+
+    auto it = d.begin();
+    mystl::advance(it, 3000);
+    EXPECT_EQ(*it, "middle");
+    EXPECT_EQ(mystl::distance(d.begin(), d.end()), 6001);
+    EXPECT_EQ(d.end() - it, 3001);
+    EXPECT_EQ(*(it - 3000), "-2999");
+    EXPECT_EQ(d.rbegin()[0], "2999");
+
+    mystl::deque<std::string> copy(d);
+    EXPECT_EQ(copy, d);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    copy.push_front("x");
+    EXPECT_EQ(copy.at(0), "x");
+    EXPECT_THROW(copy.at(1), std::out_of_range);
+    EXPECT_GT(copy, d);
+}
+TEST(mpmc_queue_test, single_thread_fifo_and_batch) {
+    mystl::mpmc_queue<std::string> q(5);
+    EXPECT_EQ(q.capacity(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(q.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(q.try_emplace("full"));
+    std::string s;
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(q.try_pop(s));
+        EXPECT_EQ(s, std::to_string(i));
+    }
+    EXPECT_FALSE(q.try_pop(s));
+
+    // 批量操作跨过环形缓冲区的末尾
+    const int src[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    mystl::spsc_queue<int> iq(8);
+    int out[11] = {};
+    EXPECT_EQ(iq.push_n(src, 5), 5u);
+    EXPECT_EQ(iq.pop_n(out, 3), 3u);
+    EXPECT_EQ(iq.push_n(src + 5, 5), 5u);
+    EXPECT_EQ(iq.size_approx(), 7u);
+    EXPECT_EQ(iq.push_n(src, 5), 1u);
+    EXPECT_EQ(iq.pop_n(out + 3, 10), 8u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(out[i], src[i]);
+    }
+    EXPECT_EQ(out[10], 1);
+    EXPECT_EQ(iq.pop_n(out, 1), 0u);
+
+    // 析构时剩余的元素也要析构
+    mystl::mpsc_queue<std::string> left(4);
+    left.try_push(std::string(100, 'x'));
+}
+
+template <typename Queue>
+void run_queue_threads(int producers, int consumers) {
+    constexpr int kPerProducer = 5000;
+    Queue q(64);
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+    const int total = producers * kPerProducer;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            int batch[4];
+            for (int i = 0; i < kPerProducer;) {
+                if (i % 3 == 0 && i + 4 <= kPerProducer) {
+                    for (int j = 0; j < 4; ++j) {
+                        batch[j] = p * kPerProducer + i + j + 1;
+                    }
+                    i += static_cast<int>(q.push_n(batch, 4));
+                } else if (q.try_push(p * kPerProducer + i + 1)) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            int buf[8];
+            int last = 0;
+            while (consumed.load() < total) {
+                const auto n = q.pop_n(buf, 8);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (size_t j = 0; j < n; ++j) {
+                    sum += buf[j];
+                    // 只有一个生产者和消费者时顺序不变
+                    if (producers == 1 && consumers == 1) {
+                        EXPECT_EQ(buf[j], last + 1);
+                        last = buf[j];
+                    }
+                }
+                consumed += static_cast<int>(n);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(sum.load(), 1LL * total * (total + 1) / 2);
+}
+
+TEST(mpmc_queue_test, concurrent_producers_and_consumers) {
+    run_queue_threads<mystl::mpmc_queue<int>>(4, 4);
+    run_queue_threads<mystl::mpsc_queue<int>>(4, 1);
+    run_queue_threads<mystl::spsc_queue<int>>(1, 1);
+}
+// 在不同长度和位置上与标准库的结果比较，覆盖 SIMD 循环的尾部
+template <typename T>
+void check_simd_algorithms() {
+    std::mt19937 rng(11);
+    for (size_t n : {0, 1, 7, 16, 33, 64, 100, 1000}) {
+        std::vector<T> v(n);
+        for (auto& x : v) {
+            x = static_cast<T>(rng() % 50);
+        }
+        const T* first = v.data();
+        const T* last = v.data() + n;
+        for (int target : {0, 7, 49, 99}) {
+            const T value = static_cast<T>(target);
+            EXPECT_EQ(mystl::find(first, last, value),
+                      std::find(first, last, value));
+            EXPECT_EQ(mystl::count(first, last, value),
+                      std::count(first, last, value));
+        }
+        EXPECT_EQ(mystl::min_element(first, last),
+                  std::min_element(first, last));
+        EXPECT_EQ(mystl::max_element(first, last),
+                  std::max_element(first, last));
+        if constexpr (std::is_integral_v<T>) {
+            EXPECT_EQ(mystl::accumulate(first, last, T(3)),
+                      std::accumulate(first, last, T(3)));
+        }
+
+        std::vector<T> w(v);
+        EXPECT_TRUE(mystl::equal(first, last, w.data()));
+        for (size_t i = 0; i < n; i += 13) {
+            w[i] = static_cast<T>(w[i] + 1);
+            EXPECT_EQ(mystl::mismatch(first, last, w.data()).first,
+                      first + i);
+            EXPECT_FALSE(mystl::equal(first, last, w.data()));
+            w[i] = v[i];
+        }
+
+        mystl::fill(w.data(), w.data() + n, T(5));
+        EXPECT_EQ(std::count(w.begin(), w.end(), T(5)),
+                  static_cast<ptrdiff_t>(n));
+    }
+}
+
+TEST(algorithm_test, simd_matches_scalar) {
+    check_simd_algorithms<char>();
+    check_simd_algorithms<unsigned char>();
+    check_simd_algorithms<short>();
+    check_simd_algorithms<uint16_t>();
+    check_simd_algorithms<int>();
+    check_simd_algorithms<unsigned>();
+    check_simd_algorithms<long long>();
+    check_simd_algorithms<float>();
+    check_simd_algorithms<double>();
+}
+
+// 可平凡复制，但复制赋值被删除，非 const 左值的赋值走自定义的模板
+struct forwarding_assign {
+    int v;
+    forwarding_assign& operator=(const forwarding_assign&) = delete;
+    template <typename U>
+    forwarding_assign& operator=(U&& rhs) {
+        v = rhs.v + 100;
+        return *this;
+    }
+};
+
+TEST(algorithm_test, copy_respects_assignment) {
+    static_assert(std::is_trivially_copyable_v<forwarding_assign>);
+    static_assert(!mystl::is_memmove_assignable_v<forwarding_assign*,
+                                                  forwarding_assign*>);
+    static_assert(mystl::is_memmove_assignable_v<const int*, int*>);
+
+    forwarding_assign src[3] = {{1}, {2}, {3}};
+    forwarding_assign dst[3] = {{0}, {0}, {0}};
+    EXPECT_EQ(mystl::copy(src, src + 3, dst), dst + 3);
+    EXPECT_EQ(dst[0].v, 101);
+    EXPECT_EQ(dst[2].v, 103);
+}
+
+TEST(algorithm_test, special_values_and_iterators) {
+    // 值超出元素类型范围时按普通比较处理
+    std::vector<unsigned> u{1, 2, 0xFFFFFFFFu, 3};
+    EXPECT_EQ(mystl::find(u.data(), u.data() + 4, ~0u), u.data() + 2);
+    EXPECT_EQ(mystl::count(u.data(), u.data() + 4, 2L), 1);
+    std::vector<signed char> sc(40, 1);
+    EXPECT_EQ(mystl::find(sc.data(), sc.data() + 40, 257), sc.data() + 40);
+
+    // NaN 和正负零
+    std::vector<double> d(64, 1.0);
+    d[10] = -0.0;
+    d[20] = 0.0;
+    EXPECT_EQ(mystl::min_element(d.data(), d.data() + 64), d.data() + 10);
+    d[30] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(mystl::min_element(d.data(), d.data() + 64),
+              std::min_element(d.data(), d.data() + 64));
+    EXPECT_EQ(mystl::max_element(d.data(), d.data() + 64),
+              std::max_element(d.data(), d.data() + 64));
+    std::vector<double> e(d);
+    EXPECT_FALSE(mystl::equal(d.data(), d.data() + 64, e.data()));
+    EXPECT_EQ(mystl::mismatch(d.data(), d.data() + 64, e.data()).first,
+              d.data() + 30);
+
+    // 非连续迭代器走普通版本
+    mystl::deque<int> dq;
+    for (int i = 0; i < 100; ++i) {
+        dq.push_back(i % 10);
+    }
+    EXPECT_EQ(*mystl::find(dq.begin(), dq.end(), 7), 7);
+    EXPECT_EQ(mystl::count(dq.begin(), dq.end(), 3), 10);
+    EXPECT_EQ(*mystl::max_element(dq.begin(), dq.end()), 9);
+    EXPECT_EQ(mystl::accumulate(dq.begin(), dq.end(), 0LL), 450);
+    mystl::fill(dq.begin(), dq.end(), 2);
+    EXPECT_EQ(mystl::accumulate(dq.begin(), dq.end(), 0), 200);
+    EXPECT_TRUE(mystl::equal(dq.begin(), dq.end(), dq.begin()));
+}
+class execution_test : public ::testing::Test {
+protected:
+    // 单核机器上也用多个线程运行，覆盖并行路径
+    static void SetUpTestSuite() { setenv("MYSTL_NUM_THREADS", "4", 0); }
+};
+
+TEST_F(execution_test, elementwise_algorithms) {
+    const size_t n = 300000;
+    mystl::vector<int> v(n);
+    mystl::fill(mystl::execution::par, v.begin(), v.end(), 3);
+    EXPECT_EQ(std::count(v.begin(), v.end(), 3), static_cast<ptrdiff_t>(n));
+
+    mystl::for_each(mystl::execution::par, v.begin(), v.end(),
+                    [](int& x) { x *= 2; });
+    mystl::vector<long long> w(n);
+    mystl::transform(mystl::execution::par_unseq, v.begin(), v.end(),
+                     w.begin(), [](int x) { return x + 1LL; });
+    EXPECT_EQ(w[0], 7);
+    EXPECT_EQ(w[n - 1], 7);
+    mystl::transform(mystl::execution::par, v.begin(), v.end(), w.begin(),
+                     w.begin(), [](int x, long long y) { return x * y; });
+    EXPECT_EQ(w[n / 2], 42);
+
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<int>(i % 1000);
+    }
+    mystl::vector<int> copy(n);
+    mystl::copy(mystl::execution::par, v.begin(), v.end(), copy.begin());
+    EXPECT_EQ(copy, v);
+    EXPECT_EQ(mystl::reduce(mystl::execution::par, v.begin(), v.end()),
+              mystl::reduce(mystl::execution::seq, v.begin(), v.end()));
+    EXPECT_EQ(mystl::reduce(mystl::execution::par, v.begin(), v.end(), 0LL,
+                            [](long long a, long long b) { return a + b; }),
+              1LL * (n / 1000) * 999 * 1000 / 2);
+
+    v[250000] = -1;
+    v[270000] = -1;
+    EXPECT_EQ(mystl::find(mystl::execution::par, v.begin(), v.end(), -1),
+              v.begin() + 250000);
+    EXPECT_EQ(mystl::find(mystl::execution::par, v.begin(), v.end(), -2),
+              v.end());
+
+    // 非随机访问的区间按顺序执行
+    mystl::btree_set<int> s{1, 2, 3};
+    EXPECT_EQ(*mystl::find(mystl::execution::par, s.begin(), s.end(), 2), 2);
+}
+
+TEST_F(execution_test, parallel_sort) {
+    std::mt19937 rng(12);
+    for (size_t n : {100, 20000, 300001}) {
+        mystl::vector<unsigned> v(n);
+        for (auto& x : v) {
+            x = rng() % 5000;
+        }
+        std::vector<unsigned> ref(v.begin(), v.end());
+        std::sort(ref.begin(), ref.end());
+        mystl::sort(mystl::execution::par, v.begin(), v.end());
+        EXPECT_TRUE(std::equal(ref.begin(), ref.end(), v.begin()));
+    }
+
+    mystl::vector<std::string> strs;
+    for (int i = 0; i < 50000; ++i) {
+        strs.push_back(std::to_string(rng()));
+    }
+    std::vector<std::string> ref(strs.begin(), strs.end());
+    std::sort(ref.begin(), ref.end(), std::greater<>());
+    mystl::sort(mystl::execution::par, strs.begin(), strs.end(),
+                std::greater<>());
+    EXPECT_TRUE(std::equal(ref.begin(), ref.end(), strs.begin()));
+
+    // 并行执行时抛出的异常在调用线程重新抛出
+    mystl::vector<int> v(100000, 1);
+    EXPECT_THROW(mystl::for_each(mystl::execution::par, v.begin(), v.end(),
+                                 [](int) { throw std::runtime_error("x"); }),
+                 std::runtime_error);
+}
+long long pool_fib(mystl::thread_pool& pool, int n) {
+    if (n < 12) {
+        return n < 2 ? n : pool_fib(pool, n - 1) + pool_fib(pool, n - 2);
+    }
+    long long a = 0;
+    long long b = 0;
+    mystl::task_group group(pool);
+    group.spawn([&] { a = pool_fib(pool, n - 1); });
+    b = pool_fib(pool, n - 2);
+    group.sync();
+    return a + b;
+}
+
+TEST(thread_pool_test, submit_and_future) {
+    mystl::thread_pool pool(3);
+    std::vector<mystl::future<int>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        futures.push_back(pool.submit([i] { return i * i; }));
+    }
+    long long sum = 0;
+    for (auto& f : futures) {
+        sum += f.get();
+        EXPECT_FALSE(f.valid());
+    }
+    EXPECT_EQ(sum, 332833500LL);
+
+    auto s = pool.submit([] { return std::string(64, 'a'); });
+    EXPECT_EQ(s.get().size(), 64u);
+    std::atomic<int> hits{0};
+    auto v = pool.submit([&] { ++hits; });
+    v.wait();
+    EXPECT_TRUE(v.ready());
+    v.get();
+    EXPECT_EQ(hits.load(), 1);
+    auto e = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(e.get(), std::runtime_error);
+
+    // 未取结果的 future 析构时也要释放共享状态
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&] { ++hits; });
+    }
+}
+
+TEST(thread_pool_test, fork_join_and_parallel_for) {
+    mystl::thread_pool pool(3);
+    EXPECT_EQ(pool_fib(pool, 27), 196418);
+
+    // 工作线程内部提交任务并等待
+    auto nested = pool.submit([&] { return pool_fib(pool, 20); });
+    EXPECT_EQ(nested.get(), 6765);
+
+    std::vector<int> data(100000, 1);
+    std::atomic<long long> total{0};
+    std::atomic<int> calls{0};
+    pool.parallel_for(0, data.size(), 1000, [&](size_t b, size_t e) {
+        long long local = 0;
+        for (size_t i = b; i < e; ++i) {
+            local += data[i];
+        }
+        total += local;
+        ++calls;
+    });
+    EXPECT_EQ(total.load(), 100000);
+    EXPECT_GE(calls.load(), 100);
+
+    mystl::task_group group(pool);
+    group.spawn([] { throw std::logic_error("in task"); });
+    EXPECT_THROW(group.sync(), std::logic_error);
+
+    // 没有工作线程时由调用线程执行
+    mystl::thread_pool single(0);
+    EXPECT_EQ(pool_fib(single, 15), 610);
+    EXPECT_EQ(single.submit([] { return 5; }).get(), 5);
+}
+TEST(sort_test, matches_std_on_patterns) {
+    std::mt19937 gen(14);
+    auto check = [](std::vector<int> v, auto comp) {
+        std::vector<int> expect = v;
+        std::sort(expect.begin(), expect.end(), comp);
+        std::vector<int> got = v;
+        mystl::sort(got.data(), got.data() + got.size(), comp);
+        EXPECT_EQ(got, expect);
+        // 比较器不是 std::less / std::greater 时走 pdqsort 而不是基数排序
+        mystl::vector<int> mv(v.data(), v.data() + v.size());
+        mystl::sort(mv.begin(), mv.end(), [&](int a, int b) {
+            return comp(a, b);
+        });
+        for (size_t i = 0; i < v.size(); ++i) {
+            EXPECT_EQ(mv[i], expect[i]);
+        }
+    };
+    for (int n : {0, 1, 2, 23, 24, 100, 129, 1000, 5000, 50000}) {
+        std::vector<int> v(n);
+        for (auto& x : v) {
+            x = static_cast<int>(gen());
+        }
+        check(v, std::less<>());
+        check(v, std::greater<int>());
+        for (auto& x : v) {
+            x = static_cast<int>(gen() % 4) - 2;
+        }
+        check(v, std::less<int>());
+        std::vector<int> sorted(n), organ(n);
+        for (int i = 0; i < n; ++i) {
+            sorted[i] = i;
+            organ[i] = i < n / 2 ? i : n - i;
+        }
+        check(sorted, std::less<>());
+        check(sorted, std::greater<>());
+        check(organ, std::less<>());
+        if (n > 2) {
+            std::swap(sorted[0], sorted[n - 1]);
+            check(sorted, std::less<>());
+        }
+    }
+
+    // 各种宽度的整数走基数排序
+    std::vector<int64_t> wide(3000);
+    for (auto& x : wide) {
+        x = static_cast<int64_t>(gen()) << 20 | gen();
+        x = gen() % 2 ? x : -x;
+    }
+    std::vector<int64_t> wide_expect = wide;
+    std::sort(wide_expect.begin(), wide_expect.end());
+    mystl::sort(wide.data(), wide.data() + wide.size());
+    EXPECT_EQ(wide, wide_expect);
+    std::vector<uint8_t> bytes(2000);
+    for (auto& x : bytes) {
+        x = static_cast<uint8_t>(gen());
+    }
+    std::vector<uint8_t> bytes_expect = bytes;
+    std::sort(bytes_expect.begin(), bytes_expect.end(), std::greater<>());
+    mystl::sort(bytes.data(), bytes.data() + bytes.size(), std::greater<>());
+    EXPECT_EQ(bytes, bytes_expect);
+
+    // 非算术类型走带分支的分割
+    std::vector<std::string> words(3000);
+    for (auto& w : words) {
+        w = std::to_string(gen() % 500);
+    }
+    std::vector<std::string> words_expect = words;
+    std::sort(words_expect.begin(), words_expect.end());
+    mystl::sort(words.data(), words.data() + words.size());
+    EXPECT_EQ(words, words_expect);
+}
+
+TEST(sort_test, stable_partial_nth) {
+    std::mt19937 gen(41);
+    std::vector<std::pair<int, int>> v(5000);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = {static_cast<int>(gen() % 50), static_cast<int>(i)};
+    }
+    auto by_key = [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    };
+    auto expect = v;
+    std::stable_sort(expect.begin(), expect.end(), by_key);
+    auto got = v;
+    mystl::stable_sort(got.data(), got.data() + got.size(), by_key);
+    EXPECT_EQ(got, expect);
+
+    // 比较时抛出异常，缓冲区中的元素被正确析构 (由 ASan 检查泄漏)
+    std::vector<std::string> words(200);
+    for (auto& w : words) {
+        w = std::string(32, 'a') + std::to_string(gen() % 1000);
+    }
+    // 先数出总的比较次数，让异常发生在最后一次归并中
+    int budget = 0;
+    auto copy = words;
+    mystl::stable_sort(copy.data(), copy.data() + 200,
+                       [&](const std::string& a, const std::string& b) {
+                           ++budget;
+                           return a < b;
+                       });
+    budget -= 50;
+    auto throwing = [&](const std::string& a, const std::string& b) {
+        if (--budget == 0) {
+            throw std::runtime_error("compare");
+        }
+        return a < b;
+    };
+    EXPECT_THROW(mystl::stable_sort(words.data(), words.data() + 200,
+                                    throwing),
+                 std::runtime_error);
+
+    std::vector<int> data(10000);
+    for (auto& x : data) {
+        x = static_cast<int>(gen() % 1000);
+    }
+    auto sorted_data = data;
+    std::sort(sorted_data.begin(), sorted_data.end());
+    for (size_t k : {size_t(0), size_t(1), size_t(100), size_t(10000)}) {
+        auto part = data;
+        mystl::partial_sort(part.data(), part.data() + k,
+                            part.data() + part.size());
+        for (size_t i = 0; i < k; ++i) {
+            EXPECT_EQ(part[i], sorted_data[i]);
+        }
+    }
+    for (size_t k : {size_t(0), size_t(17), size_t(5000), size_t(9999)}) {
+        auto nth = data;
+        mystl::nth_element(nth.data(), nth.data() + k,
+                           nth.data() + nth.size());
+        ASSERT_EQ(nth[k], sorted_data[k]);
+        for (size_t i = 0; i < nth.size(); ++i) {
+            EXPECT_TRUE(i < k ? nth[i] <= nth[k] : nth[i] >= nth[k]);
+        }
+    }
+    // 全部相等时依靠深度限制改用堆选择
+    std::vector<int> same(20000, 7);
+    mystl::nth_element(same.data(), same.data() + 10000,
+                       same.data() + same.size());
+    EXPECT_EQ(same[10000], 7);
+}
+TEST(string_test, sso_does_not_allocate) {
+    using counted_string =
+        mystl::basic_string<char, mystl::char_traits<char>,
+                            mystl::allocator<char, counting_alloc>>;
+    static_assert(sizeof(counted_string) == 3 * sizeof(void*));
+    static_assert(counted_string::inline_capacity >= 22);
+    static_assert(std::is_nothrow_move_assignable_v<counted_string>);
+
+    const size_t before = counting_alloc::allocations;
+    {
+        counted_string key("user:1234567890");
+        key += ':';
+        key.append("abcdef");
+        EXPECT_EQ(key.size(), 22u);
+        EXPECT_EQ(key, "user:1234567890:abcdef");
+        counted_string copy = key;
+        counted_string moved = mystl::move(copy);
+        moved.erase(0, 5);
+        moved.insert(0, "user:");
+        EXPECT_EQ(moved, key);
+        EXPECT_EQ(std::strlen(moved.c_str()), 22u);
+    }
+    EXPECT_EQ(counting_alloc::allocations, before);
+
+    counted_string s(22, 'a');
+    s.push_back('b');
+    EXPECT_EQ(counting_alloc::allocations, before + 1);
+    EXPECT_EQ(s.size(), 23u);
+    EXPECT_EQ(s.back(), 'b');
+    s.resize(5);
+    s.shrink_to_fit();
+    EXPECT_EQ(s.capacity(), counted_string::inline_capacity);
+    EXPECT_EQ(s, "aaaaa");
+}
+
+TEST(string_test, matches_std_string) {
+    std::mt19937 gen(15);
+    mystl::string s;
+    std::string expect;
+    for (int i = 0; i < 3000; ++i) {
+        const size_t pos = expect.empty() ? 0 : gen() % (expect.size() + 1);
+        const std::string piece(gen() % 40, static_cast<char>('a' + i % 26));
+        switch (gen() % 7) {
+            case 0:
+                s.append(piece.data(), piece.size());
+                expect.append(piece);
+                break;
+            case 1:
+                s.insert(pos, piece.data(), piece.size());
+                expect.insert(pos, piece);
+                break;
+            case 2:
+                s.erase(pos, piece.size());
+                expect.erase(pos, piece.size());
+                break;
+            case 3:
+                s.replace(pos, 3, piece.data(), piece.size());
+                expect.replace(pos, 3, piece);
+                break;
+            case 4: {
+                // 用自身的一部分作为参数
+                const size_t n = (expect.size() - pos) / 2;
+                s.replace(pos, 1, s.data() + pos, n);
+                expect.replace(pos, 1, expect.substr(pos, n));
+                break;
+            }
+            case 5:
+                s.append(s.data(), s.size() / 3);
+                expect.append(expect.substr(0, expect.size() / 3));
+                break;
+            default:
+                if (expect.size() > 2000) {
+                    s = s.substr(100, 1000);
+                    expect = expect.substr(100, 1000);
+                }
+                break;
+        }
+        ASSERT_EQ(std::string(s.data(), s.size()), expect);
+        ASSERT_EQ(s.c_str()[s.size()], '\0');
+    }
+
+    // 查找与比较和 std::string 一致
+    for (const char* needle : {"a", "ab", "zz", "qqqqqq", "", "aaaaaaaab"}) {
+        for (size_t pos : {size_t(0), size_t(7), size_t(500)}) {
+            EXPECT_EQ(s.find(needle, pos), expect.find(needle, pos));
+            EXPECT_EQ(s.rfind(needle, pos), expect.rfind(needle, pos));
+        }
+    }
+    EXPECT_EQ(s.find('q'), expect.find('q'));
+    EXPECT_EQ(s.find_first_of("xyz"), expect.find_first_of("xyz"));
+    EXPECT_EQ(s.find_last_not_of("abc"), expect.find_last_not_of("abc"));
+    mystl::string a("apple"), b("apricot"), c("apple pie");
+    EXPECT_TRUE(a < b && a < c && b > c);
+    EXPECT_TRUE(a == "apple" && "apple" == a && a != b);
+    EXPECT_EQ(a + ' ' + "pie", c);
+    EXPECT_EQ(std::hash<mystl::string>()(c),
+              std::hash<std::string_view>()("apple pie"));
+
+    // resize_and_overwrite 直接写入，反复追加时容量按几何增长
+    mystl::string out;
+    size_t reallocations = 0;
+    for (int i = 0; i < 10000; ++i) {
+        const auto old_cap = out.capacity();
+        out.resize_and_overwrite(out.size() + 16, [&](char* p, size_t n) {
+            const int len = std::snprintf(p + n - 16, 16, "%d,", i);
+            return n - 16 + static_cast<size_t>(len);
+        });
+        reallocations += out.capacity() != old_cap;
+    }
+    EXPECT_LT(reallocations, 20u);
+    EXPECT_TRUE(out.starts_with("0,1,2,"));
+    EXPECT_TRUE(out.ends_with("9998,9999,"));
+}
+
+TEST(string_test, string_view_parsing) {
+    const char* line = "GET /index.html HTTP/1.1";
+    mystl::string_view sv(line);
+    const auto space = sv.find(' ');
+    EXPECT_EQ(sv.substr(0, space), "GET");
+    sv.remove_prefix(space + 1);
+    EXPECT_EQ(sv.data(), line + 4);
+    EXPECT_EQ(sv.substr(0, sv.find(' ')), "/index.html");
+    EXPECT_TRUE(sv.ends_with("1.1"));
+    EXPECT_TRUE(sv.contains(".html"));
+    EXPECT_EQ(sv.rfind('/'), 16u);
+    EXPECT_THROW(sv.substr(100), std::out_of_range);
+    mystl::string owned(sv);
+    EXPECT_EQ(owned, sv);
+    EXPECT_TRUE(mystl::string_view("abc") < mystl::string_view("abd"));
+
+    // 多字节字符类型走 SIMD 的 mismatch 和 find
+    mystl::u32string wide(100, U'x');
+    wide[70] = U'y';
+    EXPECT_EQ(wide.find(U'y'), 70u);
+    EXPECT_EQ(wide.find(mystl::u32string_view(U"xy")), 69u);
+    mystl::u32string other = wide;
+    other[70] = U'z';
+    EXPECT_LT(wide.compare(other), 0);
+}
+TEST(mmap_test, maps_records_without_copying) {
+    struct record {
+        int32_t id;
+        float score;
+        int64_t key;
+    };
+    const std::string path = ::testing::TempDir() + "mystl_mmap_records.bin";
+    {
+        auto out = mystl::mmap_span<record>::create(path.c_str(), 10000);
+        ASSERT_EQ(out.size(), 10000u);
+        for (size_t i = 0; i < out.size(); ++i) {
+            out[i] = record{static_cast<int32_t>(i), i * 0.5f,
+                            static_cast<int64_t>((i * 7919) % 10000)};
+        }
+        mystl::sort(out.begin(), out.end(),
+                    [](const record& a, const record& b) {
+                        return a.key < b.key;
+                    });
+        out.flush();
+    }
+
+    mystl::mmap_vector<record> in(path);
+    ASSERT_EQ(in.size(), 10000u);
+    EXPECT_TRUE(in.advise(mystl::mmap_advice::sequential));
+    EXPECT_TRUE(in.advise(mystl::mmap_advice::willneed, 100, 5000));
+    in.advise(mystl::mmap_advice::hugepage);
+    for (size_t i = 0; i < in.size(); ++i) {
+        ASSERT_EQ(in[i].key, static_cast<int64_t>(i));
+    }
+    static_assert(std::is_same_v<
+                  mystl::iterator_traits<decltype(in.begin())>::value_type,
+                  record>);
+    static_assert(!std::is_assignable_v<decltype(*in.begin()), record>);
+    EXPECT_EQ(mystl::distance(in.begin(), in.end()), 10000);
+    EXPECT_THROW(in.at(10000), std::out_of_range);
+
+    // 两个可写映射共享同一份页面
+    mystl::mmap_span<record> a(path), b(path);
+    a[42].score = -1.0f;
+    EXPECT_EQ(b[42].score, -1.0f);
+    EXPECT_EQ(in[42].score, -1.0f);
+
+    // 跳过文件头，大小不匹配时抛出异常
+    mystl::mmap_vector<int64_t> tail(path, sizeof(record) * 9999);
+    EXPECT_EQ(tail.size(), 2u);
+    EXPECT_THROW(mystl::mmap_vector<record>(path, 4), std::runtime_error);
+    EXPECT_THROW(mystl::mmap_vector<record>("/nonexistent/file"),
+                 std::system_error);
+
+    mystl::mmap_vector<record> moved(mystl::move(in));
+    EXPECT_FALSE(in.is_open());
+    EXPECT_EQ(moved.size(), 10000u);
+
+    auto empty = mystl::mmap_span<int>::create(path.c_str(), 0);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+    std::remove(path.c_str());
+}
+struct sensor_reading {
+    mystl::string name;
+    double value;
+};
+
+template <>
+struct mystl::serializer<sensor_reading> {
+    template <typename Writer>
+    static void write(Writer& w, const sensor_reading& r) {
+        mystl::serialize(w, r.name);
+        mystl::serialize(w, r.value);
+    }
+    template <typename Reader>
+    static void read(Reader& r, sensor_reading& out) {
+        mystl::deserialize(r, out.name);
+        mystl::deserialize(r, out.value);
+    }
+};
+
+// 只针对内存读写器的非模板 serializer
+using memory_writer = mystl::binary_writer<mystl::memory_sink>;
+using memory_reader = mystl::binary_reader<mystl::memory_source>;
+
+// 可平凡复制，但线上格式只有一个字节
+struct compact_level {
+    uint32_t level;
+};
+
+template <>
+struct mystl::serializer<compact_level> {
+    static void write(memory_writer& w, const compact_level& c) {
+        mystl::serialize(w, static_cast<uint8_t>(c.level));
+    }
+    static void read(memory_reader& r, compact_level& out) {
+        out.level = mystl::deserialize<uint8_t>(r);
+    }
+};
+
+struct labelled_value {
+    mystl::string label;
+    int value;
+};
+
+template <>
+struct mystl::serializer<labelled_value> {
+    static void write(memory_writer& w, const labelled_value& v) {
+        mystl::serialize(w, v.label);
+        mystl::serialize(w, v.value);
+    }
+    static void read(memory_reader& r, labelled_value& out) {
+        mystl::deserialize(r, out.label);
+        mystl::deserialize(r, out.value);
+    }
+};
+
+// 记录 write 的调用次数，用于确认整块写出
+struct counting_sink {
+    mystl::vector<char>* out;
+    size_t* calls;
+
+    void write(const void* data, size_t n) {
+        ++*calls;
+        const char* p = static_cast<const char*>(data);
+        out->insert(out->end(), p, p + n);
+    }
+};
+
+TEST(serialize_test, round_trips_nested_containers) {
+    mystl::vector<char> bytes;
+    size_t calls = 0;
+
+    mystl::vector<int> numbers(1 << 20);
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        numbers[i] = static_cast<int>(i * 31);
+    }
+    {
+        mystl::binary_writer<counting_sink> w(counting_sink{&bytes, &calls});
+        mystl::serialize(w, numbers);
+        w.flush();
+        // 元素个数进入缓冲区，4MB 的数据绕过缓冲区一次写出
+        EXPECT_EQ(calls, 2u);
+    }
+
+    mystl::vector<mystl::pair<int, mystl::string>> tagged;
+    tagged.push_back(mystl::pair<int, mystl::string>(1, "one"));
+    tagged.push_back(mystl::pair<int, mystl::string>(
+        2, "a string long enough to leave the inline buffer"));
+    mystl::btree_map<int, mystl::vector<double>> series;
+    series.emplace(3, mystl::vector<double>{1.5, 2.5});
+    series.emplace(-7, mystl::vector<double>{});
+    mystl::flat_hash_map<mystl::string, int> counts;
+    counts.emplace(mystl::string("alpha"), 1);
+    counts.emplace(mystl::string("beta"), 2);
+    mystl::deque<sensor_reading> readings;
+    readings.push_back(sensor_reading{"t0", 21.5});
+    readings.push_back(sensor_reading{"t1", -3.25});
+    {
+        mystl::binary_writer<mystl::memory_sink> w{mystl::memory_sink(bytes)};
+        mystl::serialize(w, tagged);
+        mystl::serialize(w, series);
+        mystl::serialize(w, counts);
+        mystl::serialize(w, readings);
+    }
+
+    // 用很小的缓冲区读取，覆盖跨缓冲区的情况
+    mystl::binary_reader<mystl::memory_source> r(
+        mystl::memory_source(bytes.data(), bytes.size()), 64);
+    const auto numbers2 = mystl::deserialize<mystl::vector<int>>(r);
+    ASSERT_EQ(numbers2.size(), numbers.size());
+    EXPECT_EQ(std::memcmp(numbers2.data(), numbers.data(),
+                          numbers.size() * sizeof(int)),
+              0);
+    const auto tagged2 =
+        mystl::deserialize<mystl::vector<mystl::pair<int, mystl::string>>>(r);
+    EXPECT_TRUE(tagged2 == tagged);
+    const auto series2 =
+        mystl::deserialize<mystl::btree_map<int, mystl::vector<double>>>(r);
+    ASSERT_EQ(series2.size(), 2u);
+    EXPECT_EQ(series2.at(3)[1], 2.5);
+    EXPECT_TRUE(series2.at(-7).empty());
+    const auto counts2 =
+        mystl::deserialize<mystl::flat_hash_map<mystl::string, int>>(r);
+    EXPECT_EQ(counts2.size(), 2u);
+    EXPECT_EQ(counts2.at(mystl::string("beta")), 2);
+    const auto readings2 = mystl::deserialize<mystl::deque<sensor_reading>>(r);
+    ASSERT_EQ(readings2.size(), 2u);
+    EXPECT_EQ(readings2[1].name, "t1");
+    EXPECT_EQ(readings2[1].value, -3.25);
+    EXPECT_TRUE(r.at_end());
+
+    // 数据不完整时抛出异常
+    mystl::binary_reader<mystl::memory_source> truncated(
+        mystl::memory_source(bytes.data(), 1000));
+    EXPECT_THROW(mystl::deserialize<mystl::vector<int>>(truncated),
+                 std::runtime_error);
+
+    // 伪造的元素个数：超出剩余输入或者字节数溢出时不分配内存直接报错
+    for (const uint64_t forged : {uint64_t{1} << 40, UINT64_MAX / 2}) {
+        mystl::vector<char> header;
+        {
+            mystl::binary_writer<mystl::memory_sink> w{
+                mystl::memory_sink(header)};
+            mystl::serialize(w, forged);
+            mystl::serialize(w, 1);
+        }
+        mystl::binary_reader<mystl::memory_source> bulk(
+            mystl::memory_source(header.data(), header.size()));
+        EXPECT_THROW(mystl::deserialize<mystl::vector<int>>(bulk),
+                     std::runtime_error);
+        mystl::binary_reader<mystl::memory_source> nested(
+            mystl::memory_source(header.data(), header.size()));
+        EXPECT_THROW(
+            mystl::deserialize<mystl::vector<mystl::vector<int>>>(nested),
+            std::runtime_error);
+    }
+}
+
+TEST(serialize_test, non_template_serializers) {
+    mystl::vector<char> bytes;
+    {
+        memory_writer w{mystl::memory_sink(bytes)};
+        mystl::serialize(w, compact_level{200});
+        mystl::serialize(w, labelled_value{"answer", 42});
+    }
+    // 使用自定义格式而不是整块写出 4 个字节
+    ASSERT_EQ(bytes[0], static_cast<char>(200));
+    memory_reader r(mystl::memory_source(bytes.data(), bytes.size()));
+    EXPECT_EQ(mystl::deserialize<compact_level>(r).level, 200u);
+    const auto v = mystl::deserialize<labelled_value>(r);
+    EXPECT_EQ(v.label, "answer");
+    EXPECT_EQ(v.value, 42);
+    EXPECT_TRUE(r.at_end());
+}
+
+TEST(serialize_test, streams_chunks_through_files) {
+    const std::string path = ::testing::TempDir() + "mystl_chunks.bin";
+    int64_t expected_sum = 0;
+    {
+        mystl::binary_writer<mystl::file_sink> w(mystl::file_sink(path),
+                                                 4096);
+        mystl::vector<int64_t> chunk(1000);
+        for (int c = 0; c < 50; ++c) {
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                chunk[i] = c * 1000 + static_cast<int64_t>(i);
+                expected_sum += chunk[i];
+            }
+            mystl::serialize_chunk(w, chunk.data(), chunk.data() + 1000);
+        }
+        mystl::serialize_end(w);
+        w.flush();
+    }
+
+    mystl::binary_reader<mystl::file_source> r(mystl::file_source(path),
+                                               4096);
+    int64_t sum = 0;
+    size_t max_chunk = 0;
+    const auto total = mystl::deserialize_chunks<int64_t>(
+        r, [&](const int64_t* data, size_t n) {
+            max_chunk = n > max_chunk ? n : max_chunk;
+            for (size_t i = 0; i < n; ++i) {
+                sum += data[i];
+            }
+        });
+    EXPECT_EQ(total, 50000u);
+    EXPECT_EQ(max_chunk, 1000u);
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_TRUE(r.at_end());
+    std::remove(path.c_str());
+}
+struct stats_probe {
+    char payload[40];
+};
+
+TEST(alloc_stats_test, counts_by_type_size_and_site) {
+    using probe_alloc = mystl::instrumented_allocator<stats_probe>;
+    ASSERT_TRUE(mystl::alloc_stats::enabled);
+    mystl::alloc_stats::reset();
+    {
+        mystl::vector<stats_probe, probe_alloc> v;
+        v.reserve(10);
+        stats_probe* p = probe_alloc::allocate(100);
+        const auto during = mystl::alloc_stats::of_type<stats_probe>();
+        EXPECT_EQ(during.allocations, 2u);
+        EXPECT_EQ(during.live_bytes, 4400u);
+        probe_alloc::deallocate(p, 100);
+    }
+    const auto probe = mystl::alloc_stats::of_type<stats_probe>();
+    EXPECT_EQ(probe.allocations, 2u);
+    EXPECT_EQ(probe.deallocations, 2u);
+    EXPECT_EQ(probe.bytes_allocated, 4400u);
+    EXPECT_EQ(probe.live_bytes, 0u);
+    EXPECT_EQ(probe.peak_bytes, 4400u);
+
+    // 400 字节落在 (256, 512]，4000 字节落在 (2048, 4096]
+    const auto buckets = mystl::alloc_stats::by_size();
+    ASSERT_EQ(buckets.size(), 2u);
+    EXPECT_EQ(buckets[0].max_bytes, 512u);
+    EXPECT_EQ(buckets[1].max_bytes, 4096u);
+    EXPECT_EQ(buckets[1].counters.bytes_allocated, 4000u);
+
+    // 多线程分配，包装内存池策略
+    using int_alloc = mystl::instrumented_allocator<int, mystl::pool_alloc>;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                int_alloc::deallocate(int_alloc::allocate(4), 4);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const auto ints = mystl::alloc_stats::of_type<int>();
+    EXPECT_EQ(ints.allocations, 4000u);
+    EXPECT_EQ(ints.live_bytes, 0u);
+    EXPECT_EQ(mystl::alloc_stats::total().allocations, 4002u);
+
+    const auto types = mystl::alloc_stats::by_type();
+    ASSERT_EQ(types.size(), 2u);
+    EXPECT_NE(types[0].type.find("int"), std::string::npos);
+    EXPECT_NE(types[1].type.find("stats_probe"), std::string::npos);
+
+    // 每次分配都采样，记在 alloc_scope 声明的位置
+    mystl::alloc_stats::set_sample_rate(1);
+    uint32_t scope_line = 0;
+    {
+        mystl::alloc_scope scope;
+        scope_line = __LINE__ - 1;
+        probe_alloc::deallocate(probe_alloc::allocate(3), 3);
+        probe_alloc::deallocate(probe_alloc::allocate(), 1);
+    }
+    mystl::alloc_stats::set_sample_rate(0);
+    const auto sites = mystl::alloc_stats::sites();
+    ASSERT_EQ(sites.size(), 1u);
+    EXPECT_EQ(sites[0].line, scope_line);
+    EXPECT_EQ(sites[0].samples, 2u);
+    EXPECT_EQ(sites[0].bytes, 160u);
+
+    std::ostringstream json;
+    mystl::alloc_stats::dump_json(json);
+    EXPECT_NE(json.str().find("\"enabled\": true"), std::string::npos);
+    EXPECT_NE(json.str().find("stats_probe"), std::string::npos);
+    EXPECT_NE(json.str().find("\"samples\": 2"), std::string::npos);
+}
+// 在常量求值中生成查找表：vector 收集、sort 排序、再复制到 array
+constexpr mystl::array<int, 8> sorted_squares() {
+    mystl::vector<int> v;
+    for (int i = -4; i < 4; ++i) {
+        v.push_back(i * i * (i < 0 ? -1 : 1));
+    }
+    mystl::sort(v.begin(), v.end(), std::greater<int>());
+    v.insert(v.begin(), 100);
+    v.erase(v.begin());
+    return mystl::to_array<int, 8>(v.begin());
+}
+
+constexpr bool constexpr_utilities() {
+    mystl::array<int, 5> a{5, 1, 4, 2, 3};
+    mystl::stable_sort(a.begin(), a.end());
+    mystl::pair<int, int> p(1, 2), q(3, 4);
+    mystl::swap(p, q);
+    auto it = a.begin();
+    mystl::advance(it, 3);
+    return mystl::distance(a.begin(), it) == 3 && *it == 4 &&
+           *a.rbegin() == 5 && p.first == 3 && q.second == 2;
+}
+
+// McIlroy 的对抗比较器：尚未定值的元素 (gas) 在比较时才被赋予具体的值，
+// 使每次选出的枢轴都接近区间的最小值
+struct antiqsort_compare {
+    static constexpr int gas = std::numeric_limits<int>::max();
+    int* val;
+    int* solid;
+    int* candidate;
+
+    constexpr bool operator()(int x, int y) const {
+        if (val[x] == gas && val[y] == gas) {
+            val[x == *candidate ? x : y] = (*solid)++;
+        }
+        if (val[x] == gas) {
+            *candidate = x;
+        } else if (val[y] == gas) {
+            *candidate = y;
+        }
+        return val[x] < val[y];
+    }
+};
+
+// 用对抗比较器驱动一次 algo，记录下的取值就是让它分割持续不均匀的输入
+template <size_t N, typename Algo>
+constexpr mystl::array<int, N> adversarial_input(Algo algo) {
+    mystl::array<int, N> val{};
+    mystl::array<int, N> idx{};
+    for (size_t i = 0; i < N; ++i) {
+        val[i] = antiqsort_compare::gas;
+        idx[i] = static_cast<int>(i);
+    }
+    // 开头不单调，避免 sort 的有序检测直接返回
+    val[0] = 1;
+    val[1] = 0;
+    val[2] = 2;
+    int solid = 3;
+    int candidate = 0;
+    algo(idx.begin(), idx.end(),
+         antiqsort_compare{val.data(), &solid, &candidate});
+    for (auto& v : val) {
+        if (v == antiqsort_compare::gas) {
+            v = solid++;
+        }
+    }
+    return val;
+}
+
+// sort 与 nth_element 在常量求值中也能退化到堆算法
+constexpr bool heap_fallbacks() {
+    constexpr size_t n = 256;
+    auto sorted = adversarial_input<n>([](auto first, auto last, auto comp) {
+        mystl::sort(first, last, comp);
+    });
+    mystl::sort(sorted.begin(), sorted.end());
+    bool ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        ok = ok && sorted[i] == static_cast<int>(i);
+    }
+
+    auto nth = adversarial_input<n>([](auto first, auto last, auto comp) {
+        mystl::nth_element(first, first + n / 2, last, comp);
+    });
+    mystl::nth_element(nth.begin(), nth.begin() + n / 2, nth.end());
+    ok = ok && nth[n / 2] == static_cast<int>(n / 2);
+    for (size_t i = 0; i < n; ++i) {
+        ok = ok && (nth[i] < nth[n / 2]) == (i < n / 2);
+    }
+
+    mystl::array<int, 8> part{7, 3, 5, 1, 8, 2, 6, 4};
+    mystl::partial_sort(part.begin(), part.begin() + 3, part.end());
+    return ok && part[0] == 1 && part[1] == 2 && part[2] == 3;
+}
+
+TEST(constexpr_test, builds_tables_at_compile_time) {
+    constexpr auto table = sorted_squares();
+    static_assert(table == mystl::array<int, 8>{9, 4, 1, 0, -1, -4, -9, -16});
+    static_assert(table.size() == 8 && table.front() == 9);
+    static_assert(constexpr_utilities());
+    static_assert(heap_fallbacks());
+
+    // 运行期使用同一套实现得到相同的结果
+    EXPECT_EQ(sorted_squares(), table);
+    mystl::array<int, 3> a{3, 1, 2};
+    mystl::array<int, 3> b{};
+    b.fill(7);
+    a.swap(b);
+    EXPECT_EQ(a[0], 7);
+    EXPECT_EQ(b.back(), 2);
+    EXPECT_THROW(a.at(3), std::out_of_range);
+    EXPECT_LT(b, a);
+    EXPECT_TRUE((mystl::array<int, 0>{}.empty()));
+}
+enum class opcode { load, store, add, jump };
+
+TEST(static_map_test, perfect_hash_lookups) {
+    constexpr auto methods = mystl::make_static_map<mystl::string_view, int>(
+        {{"GET", 1},
+         {"PUT", 2},
+         {"POST", 3},
+         {"DELETE", 4},
+         {"HEAD", 5},
+         {"OPTIONS", 6},
+         {"PATCH", 7},
+         {"CONNECT", 8},
+         {"TRACE", 9}});
+    static_assert(methods.size() == 9);
+    static_assert(methods.at("OPTIONS") == 6);
+    static_assert(methods.contains("TRACE") && !methods.contains("GETS"));
+    static_assert(methods.find("get") == methods.end());
+
+    // 运行期查找与编译期结果相同
+    const std::string buffer = "POST /index.html";
+    const mystl::string_view verb(buffer.data(), 4);
+    EXPECT_EQ(methods.at(verb), 3);
+    EXPECT_EQ(methods.count(mystl::string_view("CONNECT")), 1u);
+    EXPECT_THROW(methods.at("BREW"), std::out_of_range);
+    int sum = 0;
+    for (const auto& kv : methods) {
+        sum += kv.second;
+    }
+    EXPECT_EQ(sum, 45);
+
+    constexpr auto names = mystl::make_static_map<opcode, mystl::string_view>(
+        {{opcode::load, "load"},
+         {opcode::store, "store"},
+         {opcode::add, "add"},
+         {opcode::jump, "jump"}});
+    static_assert(names.at(opcode::jump) == "jump");
+    EXPECT_EQ(names.at(opcode::store), "store");
+
+    // 较大的整数键集合，每个键都要落在自己的槽位上
+    mystl::pair<int, int> items[500];
+    for (int i = 0; i < 500; ++i) {
+        items[i] = mystl::make_pair(i * 7919, i);
+    }
+    const mystl::static_map<int, int, 500> table(items);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(table.at(i * 7919), i);
+    }
+    EXPECT_FALSE(table.contains(1));
+
+    mystl::pair<int, int> dup[2] = {{1, 1}, {1, 2}};
+    EXPECT_THROW((mystl::static_map<int, int, 2>(dup)), std::invalid_argument);
+}
+// 类类型的连续迭代器，用于检查非指针的连续迭代器也能退化为内存原语
+template <typename T>
+struct span_iterator {
+    using iterator_category = mystl::contiguous_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    T* p;
+
+    T& operator*() const { return *p; }
+    T* operator->() const { return p; }
+    T& operator[](ptrdiff_t n) const { return p[n]; }
+    span_iterator& operator++() {
+        ++p;
+        return *this;
+    }
+    span_iterator& operator--() {
+        --p;
+        return *this;
+    }
+    span_iterator& operator+=(ptrdiff_t n) {
+        p += n;
+        return *this;
+    }
+    span_iterator operator+(ptrdiff_t n) const { return {p + n}; }
+    span_iterator operator-(ptrdiff_t n) const { return {p - n}; }
+    ptrdiff_t operator-(const span_iterator& rhs) const { return p - rhs.p; }
+    bool operator==(const span_iterator& rhs) const { return p == rhs.p; }
+    bool operator!=(const span_iterator& rhs) const { return p != rhs.p; }
+    bool operator<(const span_iterator& rhs) const { return p < rhs.p; }
+};
+
+TEST(contiguous_iterator_test, lowers_to_memory_primitives) {
+    using rev = mystl::reverse_iterator<int*>;
+    static_assert(mystl::is_contiguous_iterator_v<int*>);
+    static_assert(mystl::is_contiguous_iterator_v<const char*>);
+    static_assert(mystl::is_contiguous_iterator_v<span_iterator<int>>);
+    static_assert(!mystl::is_contiguous_iterator_v<rev>);
+    static_assert(mystl::is_random_access_iterator<rev>::value);
+    static_assert(
+        !mystl::is_contiguous_iterator_v<mystl::deque<int>::iterator>);
+    static_assert(mystl::is_memmove_copyable_v<span_iterator<const int>, int*>);
+
+    std::vector<int> a(100), b(100, 0);
+    std::iota(a.begin(), a.end(), 0);
+    span_iterator<int> af{a.data()}, al{a.data() + 100};
+    span_iterator<int> bf{b.data()};
+    EXPECT_EQ(mystl::copy(af, al, bf).p, b.data() + 100);
+    EXPECT_TRUE(mystl::equal(af, al, bf));
+    EXPECT_EQ(mystl::find(af, al, 42).p, a.data() + 42);
+    EXPECT_EQ(mystl::count(af, al, 7), 1);
+    EXPECT_EQ(*mystl::max_element(af, al), 99);
+    EXPECT_EQ(mystl::accumulate(af, al, 0), 4950);
+    b[99] = -1;
+    EXPECT_FALSE(mystl::equal(af, al, bf));
+    EXPECT_EQ(mystl::mismatch(af, al, bf).first.p, a.data() + 99);
+
+    // 按字节块交换，长度不是块大小的整数倍
+    std::vector<int> c(37, 5), d(37, 9);
+    mystl::swap_range(c.data(), c.data() + 37, d.data());
+    EXPECT_EQ(c, std::vector<int>(37, 9));
+    EXPECT_EQ(d, std::vector<int>(37, 5));
+    int x[3] = {1, 2, 3}, y[3] = {4, 5, 6};
+    mystl::swap(x, y);
+    EXPECT_EQ(x[2], 6);
+    EXPECT_EQ(y[0], 1);
+    // 赋值不平凡时逐个交换，走自定义的赋值运算符
+    forwarding_assign f1[2] = {{1}, {2}}, f2[2] = {{3}, {4}};
+    mystl::swap_range(f1, f1 + 2, f2);
+    EXPECT_EQ(f1[0].v, 103);
+    EXPECT_EQ(f2[1].v, 102);
+
+    // 反向区间上的 fill / equal / copy
+    std::vector<int> e(10);
+    std::iota(e.begin(), e.end(), 0);
+    std::vector<int> f(10, 0);
+    mystl::copy(rev(e.data() + 8), rev(e.data() + 2), rev(f.data() + 10));
+    EXPECT_EQ(f, (std::vector<int>{0, 0, 0, 0, 2, 3, 4, 5, 6, 7}));
+    EXPECT_TRUE(mystl::equal(rev(e.data() + 8), rev(e.data() + 2),
+                             rev(f.data() + 10)));
+    EXPECT_FALSE(
+        mystl::equal(rev(e.data() + 8), rev(e.data()), rev(f.data() + 10)));
+    // 有重叠时与逐个复制的结果相同：整体右移两个位置
+    mystl::copy(rev(e.data() + 8), rev(e.data()), rev(e.data() + 10));
+    EXPECT_EQ(e, (std::vector<int>{0, 1, 0, 1, 2, 3, 4, 5, 6, 7}));
+    mystl::fill(rev(f.data() + 3), rev(f.data()), 8);
+    EXPECT_EQ(f[0] + f[1] + f[2] + f[3], 24);
+
+    // 非平凡类型经由类类型的连续迭代器构造与析构
+    auto* raw = mystl::allocator<std::string>::allocate(3);
+    span_iterator<std::string> sf{raw}, sl{raw + 3};
+    mystl::uninitialized_fill(sf, sl, std::string(40, 's'));
+    EXPECT_EQ(raw[2], std::string(40, 's'));
+    mystl::destory(sf, sl);
+    mystl::allocator<std::string>::deallocate(raw, 3);
+
+    // vector 与 array 的逐字节比较
+    mystl::vector<unsigned char> u1{1, 2, 200}, u2{1, 2, 3};
+    EXPECT_TRUE(u2 < u1);
+    EXPECT_FALSE(u1 == u2);
+    u2.back() = 200;
+    EXPECT_TRUE(u1 == u2);
+    u2.push_back(0);
+    EXPECT_TRUE(u1 < u2);
+    EXPECT_TRUE((mystl::array<int, 2>{1, 2} != mystl::array<int, 2>{1, 3}));
+}
+TEST(views_test, lazy_pipelines) {
+    mystl::vector<int> v(100);
+    std::iota(v.begin(), v.end(), 0);
+
+    // filter -> transform -> take 串联，结果只在遍历时计算
+    int calls = 0;
+    auto squares = v | mystl::views::filter([](int x) { return x % 2 == 0; }) |
+                   mystl::views::transform([&](int x) {
+                       ++calls;
+                       return x * x;
+                   }) |
+                   mystl::views::take(4);
+    EXPECT_EQ(calls, 0);
+    mystl::vector<int> got(squares.begin(), squares.end());
+    EXPECT_EQ(got, (mystl::vector<int>{0, 4, 16, 36}));
+    EXPECT_EQ(calls, 4);
+
+    // 迭代器类别：transform 保持随机访问，filter 降为双向，take 在非随机访问时降为前向
+    auto tv = mystl::views::transform(v, [](int x) { return x + 1; });
+    static_assert(
+        std::is_same_v<mystl::iterator_traits<decltype(tv.begin())>::
+                           iterator_category,
+                       mystl::random_access_iterator_tag>);
+    static_assert(std::is_same_v<decltype(squares.begin())::iterator_category,
+                                 mystl::forward_iterator_tag>);
+    EXPECT_EQ(tv.size(), 100u);
+    EXPECT_EQ(tv[10], 11);
+    EXPECT_EQ(tv.end() - tv.begin(), 100);
+    EXPECT_EQ(*(tv.end() - 1), 100);
+
+    // 随机访问区间上的 take / drop 直接返回底层的连续迭代器
+    auto mid = v | mystl::views::drop(10) | mystl::views::take(5);
+    static_assert(std::is_same_v<decltype(mid.begin()), int*>);
+    EXPECT_EQ(mystl::accumulate(mid.begin(), mid.end(), 0), 60);
+    EXPECT_EQ(mystl::views::drop(v, 200).size(), 0u);
+
+    // filter 双向遍历，且可以修改底层元素
+    auto odd = mystl::views::filter(v, [](int x) { return x % 2 != 0; });
+    auto last = odd.end();
+    EXPECT_EQ(*--last, 99);
+    EXPECT_EQ(*--last, 97);
+    for (int& x : odd) {
+        x = -x;
+    }
+    EXPECT_EQ(v[3], -3);
+    EXPECT_EQ(v[4], 4);
+
+    // zip 长度取较短者；非随机访问时任一侧结束即结束
+    mystl::vector<char> letters{'a', 'b', 'c'};
+    auto zipped = mystl::views::zip(v, letters);
+    EXPECT_EQ(zipped.size(), 3u);
+    EXPECT_EQ(zipped[2].second, 'c');
+    for (auto p : zipped) {
+        p.first = p.second;
+    }
+    EXPECT_EQ(v[1], 'b');
+    int small[6] = {1, 2, 3, 4, 5, 6};
+    auto l = mystl::views::filter(small, [](int x) { return x < 5; });
+    int n = 0;
+    for (auto p : mystl::views::zip(l, letters)) {
+        n += p.first;
+    }
+    EXPECT_EQ(n, 6);
+    // 双向的一侧与更长的一侧配对时只能前向遍历，不会从错位的尾后迭代器后退
+    mystl::btree_set<int> three{1, 2, 3};
+    mystl::vector<int> five{10, 20, 30, 40, 50};
+    auto pairs = mystl::views::zip(three, five);
+    static_assert(std::is_same_v<decltype(pairs.begin())::iterator_category,
+                                 mystl::forward_iterator_tag>);
+    int last_pair = 0;
+    for (auto p : pairs) {
+        last_pair = p.first * 100 + p.second;
+    }
+    EXPECT_EQ(last_pair, 330);
+
+    // enumerate 与右值容器：容器被移入视图中保存
+    std::string s;
+    for (auto p :
+         mystl::vector<char>{'x', 'y', 'z'} | mystl::views::enumerate) {
+        s += std::to_string(p.first) + p.second;
+    }
+    EXPECT_EQ(s, "0x1y2z");
+    int arr[4] = {5, 6, 7, 8};
+    EXPECT_EQ(mystl::views::enumerate(arr)[3].second, 8);
+
+    // chunk：最后一块可能不满；块是连续区间，可以交给并行算法逐块求和
+    auto chunks = mystl::views::chunk(arr, 3);
+    EXPECT_EQ(chunks.size(), 2u);
+    EXPECT_EQ(chunks[1].size(), 1u);
+    static_assert(std::is_same_v<decltype(chunks[0].begin()), int*>);
+    mystl::vector<long> big(10000);
+    std::iota(big.begin(), big.end(), 1L);
+    auto blocks = big | mystl::views::chunk(1000);
+    mystl::vector<long> sums(blocks.size());
+    mystl::transform(mystl::execution::par, blocks.begin(), blocks.end(),
+                     sums.begin(), [](auto block) {
+                         return mystl::accumulate(block.begin(), block.end(),
+                                                  0L);
+                     });
+    EXPECT_EQ(sums[0], 500500L);
+    EXPECT_EQ(mystl::accumulate(sums.begin(), sums.end(), 0L), 50005000L);
+    auto fwd = l | mystl::views::chunk(3);
+    auto it = fwd.begin();
+    EXPECT_EQ((*it).front(), 1);
+    EXPECT_EQ(*(*++it).begin(), 4);
+    EXPECT_TRUE(++it == fwd.end());
+
+    // 视图可以在常量求值中使用
+    constexpr int total = [] {
+        int a[6] = {1, 2, 3, 4, 5, 6};
+        int sum = 0;
+        for (int x : a | mystl::views::transform([](int x) { return x * 10; }) |
+                         mystl::views::drop(3)) {
+            sum += x;
+        }
+        return sum;
+    }();
+    static_assert(total == 150);
+}
+TEST(soa_vector_test, columns_and_proxy_records) {
+    // 两列的记录是 pair，各列分别连续存放并按 64 字节对齐
+    mystl::soa_vector<int, double> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.emplace_back(i, i * 0.5);
+    }
+    EXPECT_EQ(v.size(), 1000u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<0>()) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<1>()) % 64, 0u);
+    static_assert(std::is_same_v<decltype(v.column<0>().begin()), int*>);
+    auto keys = v.column<0>();
+    EXPECT_EQ(mystl::accumulate(keys.begin(), keys.end(), 0), 499500);
+    EXPECT_EQ(v.column<1>()[10], 5.0);
+
+    // 代理引用写回各列；迭代器可以随机访问
+    v[3].second = -1.0;
+    EXPECT_EQ(v.data<1>()[3], -1.0);
+    *v.begin() = mystl::pair<int, double>(7, 7.5);
+    EXPECT_EQ(v.data<0>()[0], 7);
+    auto it = v.begin() + 500;
+    EXPECT_EQ((*it).first, 500);
+    EXPECT_EQ(it[1].first, 501);
+    EXPECT_EQ(v.end() - it, 500);
+    mystl::soa_vector<int, double>::const_iterator cit = it;
+    EXPECT_TRUE(cit == it);
+    long sum = 0;
+    for (auto [k, x] : v) {
+        sum += k;
+        (void)x;
+    }
+    EXPECT_EQ(sum, 499507);
+    static_assert(
+        std::is_same_v<mystl::iterator_traits<decltype(it)>::iterator_category,
+                       mystl::random_access_iterator_tag>);
+
+    // 复制、比较、从另一个 soa_vector 的记录追加
+    mystl::soa_vector<int, double> w = v;
+    EXPECT_TRUE(w == v);
+    w.push_back(v[1]);
+    EXPECT_TRUE(w != v);
+    EXPECT_EQ(w.back().first, 1);
+    w.resize(2);
+    EXPECT_EQ(w.size(), 2u);
+    w.resize(4);
+    EXPECT_EQ(w[3].first, 0);
+    w.pop_back();
+    EXPECT_EQ(w.size(), 3u);
+    w = mystl::move(v);
+    EXPECT_EQ(w.size(), 1000u);
+    EXPECT_TRUE(v.empty());
+
+    // 三列及非平凡类型：记录是 std::tuple，扩容时搬运字符串列
+    mystl::soa_vector<std::string, int, char> t;
+    t.reserve(2);
+    for (int i = 0; i < 50; ++i) {
+        t.emplace_back(std::string(30, static_cast<char>('a' + i % 26)), i,
+                       'x');
+    }
+    // 参数引用容器自身的元素时，扩容后仍然读到正确的值
+    t.emplace_back(std::get<0>(t[0]), 50, 'y');
+    EXPECT_EQ(std::get<0>(t.back()), std::string(30, 'a'));
+    EXPECT_EQ(std::get<0>(t[27]), std::string(30, 'b'));
+    EXPECT_EQ(std::get<1>(t[50]), 50);
+    auto strings = t.column<0>();
+    EXPECT_EQ(mystl::count(t.column<2>().begin(), t.column<2>().end(), 'x'),
+              50);
+    EXPECT_EQ(strings.size(), 51u);
+    t.clear();
+    EXPECT_TRUE(t.empty());
+
+    // 扩容时复制某一列失败，已经能移动的列也保持原样
+    throwing_copy::live = 0;
+    {
+        mystl::soa_vector<std::string, throwing_copy> u;
+        u.reserve(2);
+        u.emplace_back(std::string(30, 's'), 1);
+        u.emplace_back(std::string(30, 't'), 2);
+        throwing_copy::copies = throwing_copy::kThrowAt - 1;
+        EXPECT_THROW(u.emplace_back(std::string("new"), 3), int);
+        ASSERT_EQ(u.size(), 2u);
+        EXPECT_EQ(u.data<0>()[0], std::string(30, 's'));
+        EXPECT_EQ(u.data<0>()[1], std::string(30, 't'));
+        EXPECT_EQ(u.data<1>()[1].value, 2);
+        EXPECT_EQ(throwing_copy::live, 2);
+    }
+    EXPECT_EQ(throwing_copy::live, 0);
+}
+// 记录存活对象个数，检查延后回收的节点最终都被析构
+struct epoch_tracked {
+    inline static std::atomic<int> live{0};
+    long value;
+
+    explicit epoch_tracked(long v) : value(v) { ++live; }
+    epoch_tracked(const epoch_tracked& rhs) : value(rhs.value) { ++live; }
+    ~epoch_tracked() { --live; }
+};
+
+TEST(concurrent_hash_map_test, lock_free_reads_with_deferred_reclamation) {
+    {
+        mystl::concurrent_hash_map<int, std::string> m(4);
+        EXPECT_EQ(m.shard_count(), 4u);
+        EXPECT_TRUE(m.insert(1, std::string("one")));
+        EXPECT_FALSE(m.insert(1, std::string("uno")));
+        EXPECT_EQ(*m.find(1), "one");
+        EXPECT_FALSE(m.insert_or_assign(1, std::string("uno")));
+        EXPECT_EQ(*m.find(1), "uno");
+        EXPECT_FALSE(m.find(2).has_value());
+        for (int i = 0; i < 1000; ++i) {
+            m.insert(i, std::to_string(i));
+        }
+        EXPECT_EQ(m.size(), 1000u);
+        EXPECT_TRUE(m.visit(500, [](const std::string& v) {
+            EXPECT_EQ(v, "500");
+        }));
+        size_t seen = 0;
+        m.for_each([&](const auto& kv) {
+            EXPECT_EQ(kv.first == 1 ? "uno" : std::to_string(kv.first),
+                      kv.second);
+            ++seen;
+        });
+        EXPECT_EQ(seen, 1000u);
+        EXPECT_TRUE(m.erase(7));
+        EXPECT_FALSE(m.erase(7));
+        EXPECT_FALSE(m.contains(7));
+        EXPECT_EQ(m.count(8), 1u);
+        m.clear();
+        EXPECT_TRUE(m.empty());
+        EXPECT_TRUE(m.insert(3, std::string("three")));
+    }
+
+    // 写者不断替换、删除、重新插入，读者读到的值必须与键对应
+    {
+        mystl::concurrent_hash_map<int, epoch_tracked> m(8);
+        constexpr int kKeys = 512;
+        std::atomic<bool> stop{false};
+        std::atomic<long> bad{0}, hits{0};
+        std::vector<std::thread> threads;
+        for (int w = 0; w < 2; ++w) {
+            threads.emplace_back([&, w] {
+                std::mt19937 gen(static_cast<unsigned>(w));
+                for (int i = 0; i < 20000; ++i) {
+                    const int k = static_cast<int>(gen() % kKeys);
+                    const long v = k * 1000L + static_cast<long>(gen() % 1000);
+                    switch (gen() % 3) {
+                        case 0: m.insert(k, epoch_tracked(v)); break;
+                        case 1: m.insert_or_assign(k, epoch_tracked(v)); break;
+                        default: m.erase(k); break;
+                    }
+                }
+            });
+        }
+        for (int r = 0; r < 3; ++r) {
+            threads.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int k = 0; k < kKeys; ++k) {
+                        m.visit(k, [&](const epoch_tracked& t) {
+                            hits.fetch_add(1, std::memory_order_relaxed);
+                            if (t.value / 1000 != k) {
+                                bad.fetch_add(1, std::memory_order_relaxed);
+                            }
+                        });
+                    }
+                }
+            });
+        }
+        threads[0].join();
+        threads[1].join();
+        stop = true;
+        for (size_t i = 2; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+        EXPECT_EQ(bad.load(), 0);
+        size_t n = 0;
+        m.for_each([&](const auto& kv) {
+            EXPECT_EQ(kv.second.value / 1000, kv.first);
+            ++n;
+        });
+        EXPECT_EQ(n, m.size());
+        EXPECT_GE(epoch_tracked::live.load(), static_cast<int>(n));
+    }
+    EXPECT_EQ(epoch_tracked::live.load(), 0);
+
+    // 嵌套的读者临界区
+    {
+        mystl::epoch_guard outer;
+        mystl::epoch_guard inner;
+    }
+    auto& domain = mystl::epoch_domain::global();
+    const uint64_t e = domain.current();
+    EXPECT_GE(domain.try_advance(), e + 1);
+    EXPECT_TRUE(mystl::epoch_domain::reclaimable(e, domain.current() + 1));
+}
 
 int main(int argc, char* argv[])
 {
@@ -16,6 +16,14 @@ target("gtest")
     set_toolchains("gcc")
     add_ldflags("-lgtest")
 
+target("bench")
+    set_kind("binary")
+    add_files("bench/*.cpp")
+    add_includedirs("include")
+    set_toolchains("gcc")
+    set_optimize("fastest")
+    add_ldflags("-lbenchmark", "-lpthread")
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --